@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "namespace.hpp"
+#include <cstddef>
+#include <cstdint>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Checksum algorithms. Values are used in the protocols (must fit in 4 bits), so they must not
+ * be changed.
+ */
+enum class checksum_enum: std::uint8_t
+{
+      crc32  = 0 // CRC-32 (software, see pfs::crc32_of_ptr)
+    , crc32c = 1 // CRC-32C (Castagnoli), SSE4.2 or ARMv8 CRC instructions if available
+    , xxh64  = 2 // xxHash64 folded to 32 bits
+};
+
+/**
+ * Bit of the algorithm in the mask of the supported algorithms.
+ */
+constexpr std::uint8_t checksum_bit (checksum_enum alg) noexcept
+{
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned>(alg));
+}
+
+/**
+ * Mask of all the algorithms supported by this implementation.
+ */
+constexpr std::uint8_t supported_checksums () noexcept
+{
+    return checksum_bit(checksum_enum::crc32)
+        | checksum_bit(checksum_enum::crc32c)
+        | checksum_bit(checksum_enum::xxh64);
+}
+
+/**
+ * Checks if CRC-32C is calculated by the CPU instructions.
+ */
+NETTY__EXPORT bool crc32c_accelerated () noexcept;
+
+NETTY__EXPORT std::uint32_t crc32c (char const * data, std::size_t len, std::uint32_t crc = 0) noexcept;
+
+NETTY__EXPORT std::uint64_t xxh64 (char const * data, std::size_t len, std::uint64_t seed = 0) noexcept;
+
+/**
+ * Calculates 32-bit checksum of the data by the algorithm @a alg.
+ */
+NETTY__EXPORT std::uint32_t checksum (checksum_enum alg, char const * data, std::size_t len) noexcept;
+
+/**
+ * Chooses the fastest algorithm from the mask of the algorithms supported by the peer.
+ * CRC-32 is the fallback (supported by any peer).
+ */
+NETTY__EXPORT checksum_enum select_checksum (std::uint8_t peer_checksums) noexcept;
+
+NETTY__NAMESPACE_END
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "namespace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Compression algorithms. Values are used in the protocols (must fit in 4 bits), so they must not
+ * be changed.
+ */
+enum class compression_enum: std::uint8_t
+{
+      none = 0
+    , lz4  = 1 // LZ4 block format (NETTY__LZ4_ENABLED)
+    , zstd = 2 // Zstandard frame format (NETTY__ZSTD_ENABLED)
+};
+
+/**
+ * Bit of the algorithm in the mask of the supported algorithms (zero for compression_enum::none).
+ */
+constexpr std::uint8_t compression_bit (compression_enum alg) noexcept
+{
+    return alg == compression_enum::none
+        ? 0
+        : static_cast<std::uint8_t>(1u << (static_cast<unsigned>(alg) - 1));
+}
+
+/**
+ * Mask of the algorithms available in this build.
+ */
+NETTY__EXPORT std::uint8_t supported_compressions () noexcept;
+
+/**
+ * Compression context. Contexts of the algorithms are allocated on first use and reused for
+ * the subsequent calls, so the instance is expected to be long-lived (e.g. one per node).
+ */
+class compressor
+{
+public:
+    /**
+     * Maximum size of the data to compress (and of the decompressed data).
+     */
+    static constexpr std::size_t max_size = 64 * 1024 * 1024;
+
+private:
+    void * _zstd_cctx {nullptr};
+    void * _zstd_dctx {nullptr};
+    std::vector<char> _lz4_state;
+
+public:
+    compressor () = default;
+    NETTY__EXPORT ~compressor ();
+
+    compressor (compressor const &) = delete;
+    compressor & operator = (compressor const &) = delete;
+
+public:
+    /**
+     * Compresses @a data into @a out (replacing its content).
+     *
+     * @return @c false if the algorithm is not available, the data is too large or it is not
+     *         compressible (the compressed data is not smaller than the source one).
+     */
+    NETTY__EXPORT bool compress (compression_enum alg, char const * data, std::size_t len
+        , std::vector<char> & out, int level = 0);
+
+    /**
+     * Decompresses @a data into @a out (replacing its content).
+     *
+     * @param original_size Size of the decompressed data.
+     * @return @c false if the algorithm is not available, @a original_size is too large or the
+     *         data is corrupted.
+     */
+    NETTY__EXPORT bool decompress (compression_enum alg, char const * data, std::size_t len
+        , std::size_t original_size, std::vector<char> & out);
+};
+
+NETTY__NAMESPACE_END
@@ -5,12 +5,15 @@
 //
 // Changelog:
 //      2023.01.09 Initial version.
+//      2026.10.16 Backend can be shared by pollers.
+//      2026.10.17 Added connect() for completion-based backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "connection_refused_reason.hpp"
 #include "error.hpp"
 #include "exports.hpp"
 #include "namespace.hpp"
+#include "socket4_addr.hpp"
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -21,10 +24,11 @@ template <typename Backend>
 class connecting_poller
 {
 public:
+    using backend_type = Backend;
     using socket_id = typename Backend::socket_id;
 
 private:
-    std::unique_ptr<Backend> _rep;
+    std::shared_ptr<Backend> _rep;
 
 public:
     mutable std::function<void(socket_id, error const &)> on_failure;
@@ -33,6 +37,13 @@ public:
 
 public:
     NETTY__EXPORT connecting_poller ();
+
+    /**
+     * Constructs poller with the shared backend (see is_shared_backend). If @a backend is null the
+     * poller owns its backend.
+     */
+    NETTY__EXPORT explicit connecting_poller (std::shared_ptr<Backend> backend);
+
     NETTY__EXPORT ~connecting_poller ();
 
     connecting_poller (connecting_poller const &) = delete;
@@ -43,6 +54,12 @@ public:
     NETTY__EXPORT void add (socket_id sock, error * perr = nullptr);
     NETTY__EXPORT void remove (socket_id sock, error * perr = nullptr);
 
+    /**
+     * Connects the socket @a sock (not connected yet) to @a saddr by the completion-based backend
+     * (see is_completion_backend) instead of add().
+     */
+    NETTY__EXPORT void connect (socket_id sock, socket4_addr const & saddr, error * perr = nullptr);
+
     /**
      * @return Number of connected sockets.
      */
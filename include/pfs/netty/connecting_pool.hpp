@@ -5,16 +5,26 @@
 //
 // Changelog:
 //      2024.12.26 Initial version.
+//      2026.10.16 Added constructor with shared poller backend.
+//      2026.10.17 Added next_deadline().
+//                 Deferred connections are scheduled by the timing wheel.
+//                 Added limits of the deferred connections in flight and per second.
+//                 Added support of the completion-based poller backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "connection_refused_reason.hpp"
 #include "error.hpp"
 #include "namespace.hpp"
+#include "poller_backend_traits.hpp"
+#include "timing_wheel.hpp"
 #include <pfs/i18n.hpp>
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <map>
-#include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -27,30 +37,40 @@ public:
     using socket_type = Socket;
     using socket_id = typename Socket::socket_id;
 
-private:
     using time_point_type = std::chrono::steady_clock::time_point;
 
-    struct deferred_connection_item
-    {
-        time_point_type t;
-        std::function<void()> f;
-    };
-
-    friend constexpr bool operator < (deferred_connection_item const & lhs, deferred_connection_item const & rhs)
-    {
-        return lhs.t < rhs.t;
-    }
-
 private:
     std::map<socket_id, socket_type> _connecting_sockets;
     std::vector<socket_id> _removable;
-    std::set<deferred_connection_item> _deferred_connections;
+    std::shared_ptr<timing_wheel> _timers; // Deferred connections
+
+    // Deferred connections waiting for the limits
+    std::deque<std::function<void()>> _pending;
+    std::size_t _max_in_flight {0}; // Maximum number of connecting sockets (unlimited if zero)
+    double _rate {0};               // Connections per second (unlimited if zero)
+    double _tokens {0};             // Connections available now (token bucket)
+    time_point_type _refill_time;
+    timing_wheel::timer_id _dispatch_timer {0};
+
     mutable std::function<void(error const &)> _on_failure = [] (error const &) {};
     mutable std::function<void(socket_type &&)> _on_connected;
     mutable std::function<void(socket_id, socket4_addr, connection_refused_reason)> _on_connection_refused;
 
 public:
     connecting_pool ()
+        : connecting_pool(nullptr)
+    {}
+
+    /**
+     * Constructs pool with the poller backend shared with other pools (see is_shared_backend).
+     *
+     * @param timers Timing wheel shared with the owner to schedule the deferred connections,
+     *        the pool creates its own wheel if @a timers is null.
+     */
+    explicit connecting_pool (std::shared_ptr<typename ConnectingPoller::backend_type> backend
+        , std::shared_ptr<timing_wheel> timers = nullptr)
+        : ConnectingPoller(std::move(backend))
+        , _timers(timers != nullptr ? std::move(timers) : std::make_shared<timing_wheel>())
     {
         ConnectingPoller::on_failure = [this] (socket_id id, error const & err) {
             remove_later(id);
@@ -88,54 +108,71 @@ public:
         };
     }
 
-public:
-    void remove_later (socket_id id)
+private:
+    std::size_t in_flight () const noexcept
     {
-        _removable.push_back(id);
+        // Sockets to be removed have completed connecting already
+        return _connecting_sockets.size() - (std::min)(_removable.size(), _connecting_sockets.size());
     }
 
-    void apply_remove ()
+    void refill ()
     {
-        if (!_removable.empty()) {
-            for (auto id: _removable) {
-                ConnectingPoller::remove(id);
-                _connecting_sockets.erase(id);
-            }
+        auto now = std::chrono::steady_clock::now();
 
-            _removable.clear();
+        if (_rate > 0) {
+            auto elapsed = std::chrono::duration<double>(now - _refill_time).count();
+            _tokens = (std::min)((std::max)(_rate, 1.0), _tokens + _rate * elapsed);
         }
-    }
 
-    /**
-     * Sets a callback for the failure. Callback signature is void(netty::error const &).
-     */
-    template <typename F>
-    connecting_pool & on_failure (F && f)
-    {
-        _on_failure = std::forward<F>(f);
-        return *this;
+        _refill_time = now;
     }
 
     /**
-     * Sets a callback to accept an incoming connection.
-     * Callback signature is void(socket_type &&).
+     * Starts the pending connections within the limits. Connections postponed by the number in
+     * flight are started by the next steps, by the rate - by the timer.
      */
-    template <typename F>
-    connecting_pool & on_connected (F && f)
+    void dispatch ()
     {
-        _on_connected = std::forward<F>(f);
-        return *this;
+        if (_pending.empty())
+            return;
+
+        refill();
+
+        while (!_pending.empty()) {
+            if (_max_in_flight > 0 && in_flight() >= _max_in_flight)
+                return;
+
+            if (_rate > 0) {
+                if (_tokens < 1.0) {
+                    if (_dispatch_timer == 0) {
+                        auto wait = std::chrono::duration<double>((1.0 - _tokens) / _rate);
+                        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(wait) + std::chrono::milliseconds{1};
+
+                        _dispatch_timer = _timers->start(timeout, [this] () {
+                            _dispatch_timer = 0;
+                            dispatch();
+                        });
+                    }
+
+                    return;
+                }
+
+                _tokens -= 1.0;
+            }
+
+            auto func = std::move(_pending.front());
+            _pending.pop_front();
+            func();
+        }
     }
 
-    template <typename F>
-    connecting_pool & on_connection_refused (F && f)
+    bool limited () const noexcept
     {
-        _on_connection_refused = std::forward<F>(f);
-        return *this;
+        return _max_in_flight > 0 || _rate > 0;
     }
 
     template <typename ...Args>
-    netty::conn_status connect (Args &&... args)
+    netty::conn_status connect_socket (std::false_type, Args &&... args)
     {
         Socket sock;
         error err;
@@ -173,36 +210,165 @@ public:
         return status;
     }
 
+    /**
+     * Socket is created without connecting, the connection is established by the completion-based
+     * backend.
+     */
+    template <typename ...Args>
+    netty::conn_status connect_socket (std::true_type, Args &&... args)
+    {
+        Socket sock;
+        error err;
+
+        if (!sock.prepare_connect(std::forward<Args>(args)..., & err)) {
+            _on_failure(err);
+            return netty::conn_status::failure;
+        }
+
+        ConnectingPoller::connect(sock.id(), sock.saddr(), & err);
+
+        if (err) {
+            _on_failure(err);
+            return netty::conn_status::failure;
+        }
+
+        _connecting_sockets[sock.id()] = std::move(sock);
+        return netty::conn_status::connecting;
+    }
+
+public:
+    void remove_later (socket_id id)
+    {
+        _removable.push_back(id);
+    }
+
+    void apply_remove ()
+    {
+        if (!_removable.empty()) {
+            for (auto id: _removable) {
+                ConnectingPoller::remove(id);
+                _connecting_sockets.erase(id);
+            }
+
+            _removable.clear();
+        }
+    }
+
+    /**
+     * Sets a callback for the failure. Callback signature is void(netty::error const &).
+     */
+    template <typename F>
+    connecting_pool & on_failure (F && f)
+    {
+        _on_failure = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Sets a callback to accept an incoming connection.
+     * Callback signature is void(socket_type &&).
+     */
+    template <typename F>
+    connecting_pool & on_connected (F && f)
+    {
+        _on_connected = std::forward<F>(f);
+        return *this;
+    }
+
+    template <typename F>
+    connecting_pool & on_connection_refused (F && f)
+    {
+        _on_connection_refused = std::forward<F>(f);
+        return *this;
+    }
+
+    template <typename ...Args>
+    netty::conn_status connect (Args &&... args)
+    {
+        return connect_socket(is_completion_backend<typename ConnectingPoller::backend_type>{}
+            , std::forward<Args>(args)...);
+    }
+
+    /**
+     * Connects after @a timeout. Deferred connections are started within the limits (see
+     * set_limits()) in order of their timeouts expiration.
+     */
     template <typename ...Args>
     netty::conn_status connect_timeout (std::chrono::milliseconds timeout, Args &&... args)
     {
-        if (timeout <= std::chrono::milliseconds{0})
+        if (timeout <= std::chrono::milliseconds{0} && !limited())
             return connect(std::forward<Args>(args)...);
 
         auto func = [this, args...] () {
             this->connect(args...);
         };
 
-        _deferred_connections.insert(deferred_connection_item{std::chrono::steady_clock::now() + timeout, std::move(func)});
+        if (!limited()) {
+            _timers->start(timeout, std::move(func));
+            return netty::conn_status::deferred;
+        }
+
+        if (timeout <= std::chrono::milliseconds{0}) {
+            _pending.push_back(std::move(func));
+            dispatch();
+        } else {
+            _timers->start(timeout, [this, func] () {
+                _pending.push_back(func);
+                dispatch();
+            });
+        }
 
         return netty::conn_status::deferred;
     }
 
+    /**
+     * Limits the deferred connections (see connect_timeout()): at most @a max_in_flight sockets
+     * are connecting simultaneously and at most @a per_second connections are started per second
+     * (bursts are limited by the same number). Zero value disables the corresponding limit.
+     * Connections requested by connect() are not limited, but they are counted in flight.
+     */
+    void set_limits (std::size_t max_in_flight, double per_second)
+    {
+        _max_in_flight = max_in_flight;
+        _rate = (std::max)(per_second, 0.0);
+        _tokens = (std::max)(_rate, 1.0);
+        _refill_time = std::chrono::steady_clock::now();
+
+        if (_dispatch_timer != 0) {
+            _timers->cancel(_dispatch_timer);
+            _dispatch_timer = 0;
+        }
+
+        // Limits are removed
+        if (!limited()) {
+            while (!_pending.empty()) {
+                auto func = std::move(_pending.front());
+                _pending.pop_front();
+                func();
+            }
+        } else {
+            dispatch();
+        }
+    }
+
+    /**
+     * Number of the deferred connections waiting for the limits.
+     */
+    std::size_t pending () const noexcept
+    {
+        return _pending.size();
+    }
+
     /**
      * @resturn Number of pending connections, or negative value on error.
      */
     void step (std::chrono::milliseconds millis = std::chrono::milliseconds{0}, error * perr = nullptr)
     {
         // Reconnect
-        if (!_deferred_connections.empty()) {
-            auto now = std::chrono::steady_clock::now();
-            auto pos = _deferred_connections.begin();
+        _timers->advance();
 
-            while (!_deferred_connections.empty() && pos->t <= now) {
-                pos->f();
-                pos = _deferred_connections.erase(pos);
-            }
-        }
+        // Connections postponed by the number in flight
+        dispatch();
 
         ConnectingPoller::poll(millis, perr);
     }
@@ -211,6 +377,15 @@ public:
     {
         return _connecting_sockets.empty();
     }
+
+    /**
+     * @return Time the timers (including the deferred connections) must be processed at, or
+     *         @c time_point::max() if there are no timers (see timing_wheel::next_deadline()).
+     */
+    time_point_type next_deadline () const noexcept
+    {
+        return _timers->next_deadline();
+    }
 };
 
 NETTY__NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <pfs/netty/conn_status.hpp>
 #include <pfs/netty/error.hpp>
 #include <pfs/netty/exports.hpp>
+#include <pfs/netty/frame_view.hpp>
 #include <pfs/netty/send_result.hpp>
 #include <pfs/netty/socket4_addr.hpp>
 #include <cstdint>
@@ -125,6 +126,11 @@ public:
      */
     NETTY__EXPORT send_result send (char const * data, int len, error * perr = nullptr);
 
+    /**
+     * Send data represented by the sequence of @a chunks as a single ENet packet.
+     */
+    NETTY__EXPORT send_result send (frame_chunk const * chunks, int count, error * perr = nullptr);
+
     /**
      * Connects to the ENet server.
      *
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <cstdint>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Contiguous region of the data to send (iovec-like).
+ */
+struct frame_chunk
+{
+    char const * data;
+    std::size_t size;
+};
+
+/**
+ * List of regions referencing data owned by a writer queue. View is valid until the next
+ * modification of the queue (enqueue/shift).
+ */
+class frame_view
+{
+    std::vector<frame_chunk> _chunks;
+    std::size_t _size {0}; // Total size of the data in bytes
+
+public:
+    frame_view () = default;
+
+public:
+    void clear () noexcept
+    {
+        // Capacity is kept to reuse the view without new allocations
+        _chunks.clear();
+        _size = 0;
+    }
+
+    void append (char const * data, std::size_t size)
+    {
+        if (size == 0)
+            return;
+
+        _chunks.push_back(frame_chunk{data, size});
+        _size += size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * Total size of the data in bytes.
+     */
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * Number of chunks.
+     */
+    std::size_t count () const noexcept
+    {
+        return _chunks.size();
+    }
+
+    frame_chunk const * data () const noexcept
+    {
+        return _chunks.data();
+    }
+
+    std::vector<frame_chunk>::const_iterator begin () const noexcept
+    {
+        return _chunks.cbegin();
+    }
+
+    std::vector<frame_chunk>::const_iterator end () const noexcept
+    {
+        return _chunks.cend();
+    }
+};
+
+NETTY__NAMESPACE_END
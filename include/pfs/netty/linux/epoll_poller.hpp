@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2023.01.01 Initial version.
+//      2026.10.16 Added edge-triggered epoll_et_poller.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <pfs/netty/error.hpp>
@@ -41,6 +42,16 @@ public:
     int poll (std::chrono::milliseconds millis, error * perr = nullptr);
 };
 
+/**
+ * Edge-triggered (EPOLLET) epoll backend. Readiness is reported once per state change, so the socket
+ * must be drained until no more data is available. Peer shutdown is reported by EPOLLRDHUP.
+ */
+class epoll_et_poller: public epoll_poller
+{
+public:
+    epoll_et_poller (std::uint32_t observable_events);
+};
+
 } // namespace linux_os
 
 NETTY__NAMESPACE_END
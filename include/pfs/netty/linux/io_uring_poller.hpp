@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+//      2026.10.17 Documented the scope of the poller (readiness only).
+//                 Reworked into completion-based I/O backend.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/frame_view.hpp>
+#include <pfs/netty/namespace.hpp>
+#include <pfs/netty/poller_backend_traits.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace linux_os {
+
+/**
+ * io_uring based completion I/O backend (requires Linux 5.11+).
+ *
+ * The data is transferred by the operations submitted to the ring, not by the system calls of the
+ * sockets: queued operations are submitted by the same `io_uring_enter` call that waits for
+ * completions. Each poller owns the backend performing one type of operation on its sockets:
+ *
+ *   - recv: the socket receives into the buffer owned by the backend, the receive operation is
+ *     resubmitted by the next poll() after the completion is dispatched. Buffers are registered
+ *     in the ring (IORING_OP_READ_FIXED), the heap buffers (IORING_OP_RECV) are used when the
+ *     registered ones are exhausted or the registration is not permitted (RLIMIT_MEMLOCK);
+ *   - send: data is copied into the buffer owned by the backend (see send()) and written by
+ *     IORING_OP_SEND (short writes are resubmitted by the backend). Completion of the whole buffer
+ *     is reported if it is requested by wait_for_write();
+ *   - accept: listener accepts by IORING_OP_ACCEPT resubmitted after each completion;
+ *   - connect: socket created by the owner is connected by IORING_OP_CONNECT (see connect()).
+ *
+ * Buffers of the removed sockets are released after the completion (or cancellation) of their
+ * last operation, so the kernel never writes into the released memory.
+ */
+class io_uring_poller
+{
+    class ring;
+
+public:
+    using socket_id = int;
+    using listener_id = socket_id;
+
+    enum class operation_enum
+    {
+          recv
+        , send
+        , accept
+        , connect
+    };
+
+    struct completion
+    {
+        socket_id sock;
+        int result;            // Number of bytes received, accepted socket, zero if sent (connected),
+                               // or negative error code
+        char const * data;     // Received data (valid during the dispatch only)
+        socket4_addr saddr;    // Address of the accepted peer
+    };
+
+private:
+    std::unique_ptr<ring> _d;
+
+public:
+    // Completion handler (set by poller)
+    std::function<void(completion const &)> completed;
+
+public:
+    explicit io_uring_poller (operation_enum op);
+    ~io_uring_poller ();
+
+    io_uring_poller (io_uring_poller const &) = delete;
+    io_uring_poller & operator = (io_uring_poller const &) = delete;
+
+    /**
+     * Registers socket and starts receiving (recv operation).
+     */
+    void add_socket (socket_id sock, error * perr = nullptr);
+
+    /**
+     * Registers listener and starts accepting (accept operation).
+     */
+    void add_listener (listener_id sock, error * perr = nullptr);
+
+    /**
+     * Requests completion to be reported when the data passed by send() is written (immediately
+     * if there is no data in flight).
+     */
+    void wait_for_write (socket_id sock, error * perr = nullptr);
+
+    /**
+     * Copies the data of @a chunks into the buffer of the socket and submits it for writing.
+     *
+     * @return Number of bytes accepted, zero if the previous data is still being written.
+     */
+    std::size_t send (socket_id sock, frame_chunk const * chunks, int count, error * perr = nullptr);
+
+    /**
+     * Registers socket and starts connecting it to @a saddr (connect operation).
+     */
+    void connect (socket_id sock, socket4_addr const & saddr, error * perr = nullptr);
+
+    void remove_socket (socket_id sock, error * perr = nullptr);
+    void remove_listener (listener_id sock, error * perr = nullptr);
+    bool empty () const noexcept;
+
+    /**
+     * Submits queued operations, waits for completions and dispatches them.
+     *
+     * @return Number of dispatched completions, or negative value on error.
+     */
+    int poll (std::chrono::milliseconds millis, error * perr = nullptr);
+};
+
+} // namespace linux_os
+
+template <>
+struct is_completion_backend<linux_os::io_uring_poller>: std::true_type {};
+
+NETTY__NAMESPACE_END
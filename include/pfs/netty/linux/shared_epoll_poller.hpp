@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/namespace.hpp>
+#include <pfs/netty/poller_backend_traits.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace linux_os {
+
+/**
+ * Single epoll instance shared by listener, connecting, reader and writer pollers.
+ *
+ * Each socket is registered once with the interest mask composed of the roles it has at the moment
+ * (the mask is modified by EPOLL_CTL_MOD when a role is added or removed). Write interest is one-shot:
+ * it is dropped when the write readiness is reported and restored by the next wait_for_write().
+ *
+ * One poll() call (epoll_wait) dispatches events for all roles.
+ */
+class shared_epoll_poller
+{
+public:
+    using socket_id = int;
+    using listener_id = socket_id;
+
+    enum role_enum: std::uint8_t
+    {
+          listener_role   = 1 << 0
+        , connecting_role = 1 << 1
+        , reader_role     = 1 << 2
+        , writer_role     = 1 << 3
+    };
+
+private:
+    int _eid {-1};
+    std::vector<epoll_event> _events;
+    std::unordered_map<socket_id, std::uint8_t> _roles; // Roles of the registered sockets
+    std::size_t _role_counters[4] {0, 0, 0, 0};
+
+public:
+    // Event handlers for each role (set by pollers)
+    std::function<void(epoll_event const &)> listener_event;
+    std::function<void(epoll_event const &)> connecting_event;
+    std::function<void(epoll_event const &)> reader_event;
+    std::function<void(epoll_event const &)> writer_event;
+
+private:
+    static std::uint32_t interest_mask (std::uint8_t roles) noexcept;
+    std::size_t & role_counter (role_enum role) noexcept;
+    void update (socket_id sock, std::uint8_t old_roles, std::uint8_t new_roles, error * perr);
+
+public:
+    shared_epoll_poller ();
+    ~shared_epoll_poller ();
+
+    shared_epoll_poller (shared_epoll_poller const &) = delete;
+    shared_epoll_poller & operator = (shared_epoll_poller const &) = delete;
+
+    void add (socket_id sock, role_enum role, error * perr = nullptr);
+    void remove (socket_id sock, role_enum role, error * perr = nullptr);
+    bool empty (role_enum role) const noexcept;
+
+    /**
+     * Waits for events and dispatches them to the role handlers.
+     *
+     * @return Number of dispatched events, or negative value on error.
+     */
+    int poll (std::chrono::milliseconds millis, error * perr = nullptr);
+};
+
+} // namespace linux_os
+
+template <>
+struct is_shared_backend<linux_os::shared_epoll_poller>: std::true_type {};
+
+NETTY__NAMESPACE_END
@@ -5,12 +5,15 @@
 //
 // Changelog:
 //      2023.01.09 Initial version.
+//      2026.10.16 Backend can be shared by pollers.
+//      2026.10.17 Added accepted callback for completion-based backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "chrono.hpp"
 #include "error.hpp"
 #include "exports.hpp"
 #include "namespace.hpp"
+#include "socket4_addr.hpp"
 #include <functional>
 #include <memory>
 
@@ -20,11 +23,12 @@ template <typename Backend>
 class listener_poller
 {
 public:
+    using backend_type = Backend;
     using socket_id = typename Backend::socket_id;
     using listener_id = typename Backend::listener_id;
 
 private:
-    std::unique_ptr<Backend> _rep;
+    std::shared_ptr<Backend> _rep;
 
 public:
     mutable std::function<void(listener_id, error const &)> on_failure;
@@ -34,8 +38,21 @@ public:
      */
     mutable std::function<void(listener_id)> accept;
 
+    /**
+     * Called by the completion-based backend (see is_completion_backend) instead of accept with the
+     * socket accepted by the backend and the peer address.
+     */
+    mutable std::function<void(listener_id, socket_id, socket4_addr const &)> accepted;
+
 public:
     NETTY__EXPORT listener_poller ();
+
+    /**
+     * Constructs poller with the shared backend (see is_shared_backend). If @a backend is null the
+     * poller owns its backend.
+     */
+    NETTY__EXPORT explicit listener_poller (std::shared_ptr<Backend> backend);
+
     NETTY__EXPORT ~listener_poller ();
 
     listener_poller (listener_poller const &) = delete;
@@ -5,12 +5,18 @@
 //
 // Changelog:
 //      2024.12.26 Initial version.
+//      2026.10.16 Added constructor with shared poller backend.
+//      2026.10.17 Added support of the completion-based poller backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "error.hpp"
+#include "poller_backend_traits.hpp"
+#include "socket4_addr.hpp"
 #include <pfs/i18n.hpp>
 #include <chrono>
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
 
 namespace netty {
@@ -33,6 +39,14 @@ private:
 
 public:
     listener_pool ()
+        : listener_pool(nullptr)
+    {}
+
+    /**
+     * Constructs pool with the poller backend shared with other pools (see is_shared_backend).
+     */
+    explicit listener_pool (std::shared_ptr<typename ListenerPoller::backend_type> backend)
+        : ListenerPoller(std::move(backend))
     {
         ListenerPoller::on_failure = [this] (listener_id id, error const & err) {
             remove_later(id);
@@ -55,6 +69,28 @@ public:
             if (err)
                 _on_failure(err);
         };
+
+        init_accepted(is_completion_backend<typename ListenerPoller::backend_type>{});
+    }
+
+private:
+    void init_accepted (std::false_type)
+    {}
+
+    /**
+     * Socket accepted by the completion-based backend is adopted by the listener.
+     */
+    void init_accepted (std::true_type)
+    {
+        ListenerPoller::accepted = [this] (listener_id id, socket_id sock, socket4_addr const & saddr) {
+            auto pos = _listeners.find(id);
+
+            if (pos != _listeners.end()) {
+                _on_accepted(pos->second.adopt(sock, saddr));
+            } else {
+                _on_failure(error {errc::device_not_found, tr::f_("listener not found: {}", id)});
+            }
+        };
     }
 
 public:
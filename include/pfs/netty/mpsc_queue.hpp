@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Unbounded lock-free multiple producers single consumer queue (D. Vyukov's algorithm).
+ *
+ * Any thread can push elements (wait-free), only one thread at a time can pop them.
+ * The consumer may observe the queue empty for a moment while a producer is linking a new element,
+ * such element is available on the next pop.
+ */
+template <typename T>
+class mpsc_queue
+{
+    struct item
+    {
+        std::atomic<item *> next {nullptr};
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T * value () noexcept
+        {
+            return reinterpret_cast<T *>(& storage);
+        }
+    };
+
+private:
+    std::atomic<item *> _head; // Last pushed item (producers side)
+    item * _tail;              // Stub item preceding the first element, its value is not constructed
+
+public:
+    mpsc_queue ()
+    {
+        _tail = new item;
+        _head.store(_tail, std::memory_order_relaxed);
+    }
+
+    ~mpsc_queue ()
+    {
+        auto next = _tail->next.load(std::memory_order_relaxed);
+        delete _tail;
+
+        while (next != nullptr) {
+            auto x = next;
+            next = x->next.load(std::memory_order_relaxed);
+            x->value()->~T();
+            delete x;
+        }
+    }
+
+    mpsc_queue (mpsc_queue const &) = delete;
+    mpsc_queue & operator = (mpsc_queue const &) = delete;
+
+public:
+    template <typename ...Args>
+    void emplace (Args &&... args)
+    {
+        auto x = new item;
+        new (x->value()) T(std::forward<Args>(args)...);
+
+        auto prev = _head.exchange(x, std::memory_order_acq_rel);
+        prev->next.store(x, std::memory_order_release);
+    }
+
+    void push (T && value)
+    {
+        emplace(std::move(value));
+    }
+
+    void push (T const & value)
+    {
+        emplace(value);
+    }
+
+    /**
+     * Moves the first element into @a result. Must be called by the consumer thread only.
+     *
+     * @return @c false if the queue is empty.
+     */
+    bool try_pop (T & result)
+    {
+        auto next = _tail->next.load(std::memory_order_acquire);
+
+        if (next == nullptr)
+            return false;
+
+        result = std::move(*next->value());
+        next->value()->~T();
+
+        // Item with the extracted value becomes a new stub
+        delete _tail;
+        _tail = next;
+        return true;
+    }
+
+    /**
+     * Checks if the queue is empty (approximately if called not by the consumer thread).
+     */
+    bool empty () const noexcept
+    {
+        return _tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+NETTY__NAMESPACE_END
@@ -5,13 +5,18 @@
 //
 // Changelog:
 //      2025.01.25 Initial version.
+//      2026.10.17 Handshake expiration is scheduled by the node timing wheel.
+//                 Checksum, compression and streams support are negotiated by handshake.
+//                 Node identifier is sent in the binary form to the peers that support it.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "handshake_result.hpp"
 #include "protocol.hpp"
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/timing_wheel.hpp>
 #include <chrono>
 #include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -28,11 +33,10 @@ protected:
     using socket_id = typename Node::socket_id;
     using node_idintifier_traits = typename Node::node_idintifier_traits;
     using serializer_traits = typename Node::serializer_traits;
-    using time_point_type = std::chrono::steady_clock::time_point;
 
 protected:
     Node & _node;
-    std::map<socket_id, time_point_type> _cache;
+    std::map<socket_id, timing_wheel::timer_id> _cache; // Handshake initiators and their timers
     std::chrono::seconds _timeout {10};
 
     mutable std::function<void(socket_id)> _on_expired;
@@ -45,35 +49,32 @@ public:
     {}
 
 protected:
-    void send (socket_id sid, packet_way_enum way)
+    /**
+     * Sends the handshake packet. The identifier is sent in the binary form if @a binary_id is
+     * @c true (the response to the request that supports it), otherwise it is stringified, so the
+     * peers of the previous versions can parse it.
+     */
+    void send (socket_id sid, packet_way_enum way, bool binary_id = false)
     {
         auto out = serializer_traits::make_serializer();
         handshake_packet pkt {way, (_node.is_behind_nat() ? behind_nat_enum::yes : behind_nat_enum::no)};
-        pkt.id = node_idintifier_traits::stringify(_node.id());
+        pkt.id = binary_id
+            ? node_idintifier_traits::encode(_node.id())
+            : node_idintifier_traits::stringify(_node.id());
         pkt.serialize(out);
 
         // Cache socket ID as handshake initiator
-        if (way == packet_way_enum::request)
-            _cache[sid] = std::chrono::steady_clock::now() + _timeout;
-
-        _node.send_private(sid, 0, out.data(), out.size());
-    }
+        if (way == packet_way_enum::request) {
+            cancel(sid);
 
-    void check_expired ()
-    {
-        if (!_cache.empty()) {
-            auto now = std::chrono::steady_clock::now();
-
-            for (auto pos = _cache.begin(); pos != _cache.end();) {
-                if (pos->second <= now) { // Time limit exceeded
-                    auto sid = pos->first;
-                    pos = _cache.erase(pos);
-                    _on_expired(sid);
-                } else {
-                    ++pos;
-                }
-            }
+            _cache[sid] = _node.timers().start(_timeout, [this, sid] () {
+                // Time limit exceeded
+                _cache.erase(sid);
+                _on_expired(sid);
+            });
         }
+
+        _node.send_private(sid, 0, out.data(), out.size());
     }
 
 public:
@@ -105,15 +106,24 @@ public:
 
     void cancel (socket_id sid)
     {
-        auto erased = _cache.erase(sid) > 0;
-        (void)erased;
+        auto pos = _cache.find(sid);
+
+        if (pos != _cache.end()) {
+            _node.timers().cancel(pos->second);
+            _cache.erase(pos);
+        }
     }
 
     void process (socket_id sid, handshake_packet const & pkt)
     {
-        auto optid = node_idintifier_traits::parse(pkt.id.data(), pkt.id.size());
+        // Requests and packets of the peers of the previous versions carry the stringified identifier
+        auto optid = pkt.has_binary_id()
+            ? node_idintifier_traits::decode(pkt.id.data(), pkt.id.size())
+            : node_idintifier_traits::parse(pkt.id.data(), pkt.id.size());
 
         if (optid) { // Valid node ID received
+            _node.negotiate(sid, pkt);
+
             // If item not found, it means it is already expired
             auto pos = _cache.find(sid);
 
@@ -124,7 +134,7 @@ public:
             } else {
                 // Received request from handshake initiator
                 if (!pkt.is_response()) {
-                    send(sid, packet_way_enum::response);
+                    send(sid, packet_way_enum::response, pkt.supports_binary_id());
                     static_cast<Derived<Node> *>(this)->handshake_ready(sid, *optid
                         , pkt.is_response(), pkt.is_behind_nat());
                 }
@@ -136,10 +146,11 @@ public:
         }
     }
 
+    /**
+     * Expired handshakes are processed by the node timers, nothing to do here.
+     */
     void step ()
-    {
-        check_expired();
-    }
+    {}
 };
 
 }} // namespace patterns::meshnet
@@ -5,11 +5,20 @@
 //
 // Changelog:
 //      2025.02.05 Initial version.
+//      2026.10.17 Consumed input is skipped by the cursor instead of erasing.
+//                 Fixed loss of the packet header when the packet body is incomplete.
+//                 Message payload is passed by pointer into the input buffer (no copying).
+//                 Compressed payload is decompressed by the reusable context.
+//                 Stream chunks are processed separately from messages.
+//                 Added route packets, routed data packets are forwarded by the node.
+//                 Data packets with bad checksum are dropped (stream is reported broken).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "protocol.hpp"
 #include <pfs/assert.hpp>
+#include <pfs/i18n.hpp>
 #include <pfs/utility.hpp>
+#include <pfs/netty/compression.hpp>
 #include <pfs/netty/error.hpp>
 #include <pfs/netty/namespace.hpp>
 
@@ -26,11 +35,27 @@ class basic_input_processor
 protected:
     Node & _node;
 
+private:
+    compressor _compressor;
+    std::vector<char> _zbuf; // Decompressed payload
+
 public:
     basic_input_processor (Node & node)
         : _node(node)
     {}
 
+private:
+    void deliver (Derived * that, socket_id sid, data_packet const & pkt, char const * data
+        , std::size_t len)
+    {
+        if (pkt.is_stream_chunk())
+            that->process_chunk(sid, pkt, data, len);
+        else if (pkt.is_routed())
+            that->process_routed(sid, pkt, data, len);
+        else
+            that->process(sid, data, len);
+    }
+
 public:
     void process_input (socket_id sid, std::vector<char> && chunk)
     {
@@ -49,8 +74,11 @@ public:
 
             auto in = Node::serializer_traits::make_deserializer(inpb.data(), inpb.size());
             bool has_more_packets = true;
+            std::size_t consumed = 0; // Size of the complete packets
 
             while (has_more_packets && in.available() > 0) {
+                auto packet_offset = inpb.size() - in.available();
+
                 in.start_transaction();
                 header h {in};
 
@@ -83,18 +111,44 @@ public:
                         break;
                     }
 
-                    case packet_enum::data: {
+                    case packet_enum::route: {
                         in.start_transaction();
-                        data_packet pkt {h, in};
+                        route_packet pkt {h, in};
 
                         if (in.commit_transaction())
-                            that->process(sid, std::move(pkt.bytes));
+                            that->process(sid, pkt);
                         else
                             has_more_packets = false;
 
                         break;
                     }
 
+                    case packet_enum::data: {
+                        in.start_transaction();
+                        data_packet pkt {h, in, data_packet::view_tag{}};
+
+                        // Payload references the input buffer, it is not consumed until processed
+                        if (!in.commit_transaction()) {
+                            has_more_packets = false;
+                        } else if (pkt.bad_checksum) {
+                            that->process_corrupted(sid, pkt);
+                        } else if (pkt.is_routed() && that->forward(*pacc, sid, pkt
+                                , inpb.data() + packet_offset
+                                , inpb.size() - in.available() - packet_offset)) {
+                            ; // Forwarded to the next hop or dropped by the node
+                        } else if (pkt.compression() == compression_enum::none || pkt.payload == nullptr) {
+                            deliver(that, sid, pkt, pkt.payload, pkt.payload_size());
+                        } else if (_compressor.decompress(pkt.compression(), pkt.payload
+                                , pkt.payload_size(), pkt.original_size(), _zbuf)) {
+                            deliver(that, sid, pkt, _zbuf.data(), _zbuf.size());
+                        } else {
+                            _node.log_error(tr::f_("decompression failure, message dropped: socket #{}"
+                                ", algorithm: {}", sid, pfs::to_underlying(pkt.compression())));
+                        }
+
+                        break;
+                    }
+
                     default:
                         throw error {
                               pfs::errc::unexpected_data
@@ -104,12 +158,13 @@ public:
                         has_more_packets = false;
                         break;
                 }
+
+                // Incomplete packet is kept in the buffer entirely (including header)
+                if (has_more_packets)
+                    consumed = inpb.size() - in.available();
             }
 
-            if (in.available() == 0)
-                inpb.clear();
-            else
-                inpb.erase(inpb.begin(), inpb.begin() + (inpb.size() - in.available()));
+            inpb.consume(consumed);
         }
     }
 };
@@ -5,9 +5,17 @@
 //
 // Changelog:
 //      2025.01.17 Initial version.
+//      2026.10.17 Added on_message_view callback.
+//                 Added on_stream_chunk callback.
+//                 Added on_node_congested and on_node_drained callbacks.
+//                 Added on_stats callback.
+//                 Added on_route_changed callback.
+//                 Added on_stream_failed callback.
+//                 Added on_stream_broken callback.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <pfs/netty/namespace.hpp>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -28,6 +36,40 @@ struct functional_callbacks
     // On data/message received
     std::function<void(typename Node::node_id, std::vector<char> &&)> on_message_received
         = [] (typename Node::node_id, std::vector<char> && bytes) {};
+
+    // On data/message received, alternative to `on_message_received` without copying the message:
+    // data points into the input buffer and is valid during the call only. If set, it is called
+    // instead of `on_message_received`.
+    std::function<void(typename Node::node_id, char const * data, std::size_t len)> on_message_view;
+
+    // Notify when the output queue of the channel with the remote node reaches the high water mark
+    // (see node::set_water_marks())
+    std::function<void(typename Node::node_id)> on_node_congested;
+
+    // Notify when the output queue of the congested channel falls to the low water mark
+    std::function<void(typename Node::node_id)> on_node_drained;
+
+    // On stream chunk received (see node::send_stream()): data points into the input buffer and is
+    // valid during the call only. Chunks of the stream are received in order. The stream without
+    // the last chunk is broken (see on_stream_broken), interrupted by disconnection or failed on
+    // the sender side.
+    std::function<void(typename Node::node_id, std::uint32_t stream_id, std::uint64_t offset
+        , char const * data, std::size_t len, bool last)> on_stream_chunk;
+
+    // Notify when the stream sent to the node fails (its chunk is rejected by the output queue),
+    // the producer is destroyed (see node::send_stream())
+    std::function<void(typename Node::node_id, std::uint32_t stream_id)> on_stream_failed;
+
+    // Notify when the stream received from the node is broken: its chunk failed the checksum and
+    // is dropped with the remaining chunks of the stream
+    std::function<void(typename Node::node_id, std::uint32_t stream_id)> on_stream_broken;
+
+    // Periodic statistics report (see node::set_stats_interval())
+    std::function<void(typename Node::stats_type const &)> on_stats;
+
+    // Notify when the route to the node appears or its length changes (hops is the number of hops,
+    // zero if the node becomes unreachable), see node::set_routing()
+    std::function<void(typename Node::node_id, unsigned int hops)> on_route_changed;
 };
 
 }} // namespace patterns::meshnet
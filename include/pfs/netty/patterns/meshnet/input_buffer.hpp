@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/assert.hpp>
+#include <pfs/netty/namespace.hpp>
+#include <cstdint>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace patterns {
+namespace meshnet {
+
+/**
+ * Buffer to accumulate the input data with the read cursor.
+ *
+ * Consumed data is not removed from the buffer immediately: the unread data is moved to the
+ * beginning of the buffer only when the consumed part exceeds the half of the buffer, so the
+ * total cost of the moving is linear in the amount of the input data.
+ */
+class input_buffer
+{
+    std::vector<char> _b;
+    std::size_t _pos {0}; // Position of the first unread byte
+
+public:
+    input_buffer () = default;
+
+public:
+    /**
+     * Unread data.
+     */
+    char const * data () const noexcept
+    {
+        return _b.data() + _pos;
+    }
+
+    /**
+     * Number of unread bytes.
+     */
+    std::size_t size () const noexcept
+    {
+        return _b.size() - _pos;
+    }
+
+    bool empty () const noexcept
+    {
+        return _pos == _b.size();
+    }
+
+    void append (char const * data, std::size_t len)
+    {
+        if (len == 0)
+            return;
+
+        compact();
+        _b.insert(_b.end(), data, data + len);
+    }
+
+    /**
+     * Appends the @a chunk. The storage of the @a chunk is taken if the buffer is empty (the
+     * @a chunk receives the storage of the buffer in exchange).
+     */
+    void append (std::vector<char> && chunk)
+    {
+        if (empty()) {
+            _b.swap(chunk);
+            _pos = 0;
+            chunk.clear();
+        } else {
+            append(chunk.data(), chunk.size());
+        }
+    }
+
+    /**
+     * Marks @a n bytes as read.
+     */
+    void consume (std::size_t n)
+    {
+        PFS__TERMINATE(n <= size(), "input_buffer: consumed more than available");
+
+        _pos += n;
+
+        if (_pos == _b.size()) {
+            _b.clear(); // Capacity is kept
+            _pos = 0;
+        }
+    }
+
+    void clear () noexcept
+    {
+        _b.clear();
+        _pos = 0;
+    }
+
+private:
+    void compact ()
+    {
+        if (_pos > 0 && _pos >= _b.size() - _pos) {
+            _b.erase(_b.begin(), _b.begin() + _pos);
+            _pos = 0;
+        }
+    }
+};
+
+}} // namespace patterns::meshnet
+
+NETTY__NAMESPACE_END
@@ -5,11 +5,41 @@
 //
 // Changelog:
 //      2025.01.16 Initial version.
+//      2026.10.16 Pools share the poller backend if it is supported.
+//                 Accepted sockets can be dispatched to another node (sharded mode).
+//      2026.10.17 Added thread-safe enqueue() with poll wakeup.
+//                 step() is event-driven: the node sleeps inside the reader pool poll only.
+//                 Added timing wheel shared by the processors and the connecting pool.
+//                 Added runtime configuration of the priority quanta.
+//                 Received messages can be delivered as views (on_message_view callback).
+//                 Checksum algorithm is negotiated by handshake.
+//                 Added coalescing of small messages.
+//                 Added compression of messages negotiated by handshake.
+//                 Added streaming of large messages.
+//                 Added water marks and overflow policies of the output queues.
+//                 Added traffic and queue statistics (stats() and on_stats callback).
+//                 Added RTT of the channels measured by heartbeats, heartbeat configuration.
+//                 Added multi-hop routing (distance vector) and forwarding of the routed packets.
+//                 Added broadcast() of the shared buffers to the neighbors.
+//                 Channels are indexed by both socket and node identifiers.
+//                 Reconnections are delayed by the stateful policy (backoff with jitter) and
+//                 limited by the connecting pool.
+//                 Streams fail (on_stream_failed callback) if their chunks are rejected or may be
+//                 dropped by the overflow policy.
+//                 send() reports the message rejected by the overflow policy.
+//                 Added send queue delay histogram to the statistics.
+//                 Stream with a chunk failed the checksum is reported broken (on_stream_broken
+//                 callback), its remaining chunks are dropped.
+//                 Routed packets are forwarded to the neighbors that support routing only.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "handshake_result.hpp"
-#include <pfs/countdown_timer.hpp>
+#include "node_stats.hpp"
+#include "protocol.hpp"
+#include "routing_table.hpp"
+#include "rtt_estimator.hpp"
 #include <pfs/i18n.hpp>
+#include <pfs/netty/compression.hpp>
 #include <pfs/netty/conn_status.hpp>
 #include <pfs/netty/connection_refused_reason.hpp>
 #include <pfs/netty/error.hpp>
@@ -17,11 +47,22 @@
 #include <pfs/netty/socket4_addr.hpp>
 #include <pfs/netty/connecting_pool.hpp>
 #include <pfs/netty/listener_pool.hpp>
+#include <pfs/netty/mpsc_queue.hpp>
+#include <pfs/netty/poller_backend_traits.hpp>
 #include <pfs/netty/reader_pool.hpp>
+#include <pfs/netty/shared_buffer.hpp>
 #include <pfs/netty/socket_pool.hpp>
+#include <pfs/netty/timing_wheel.hpp>
 #include <pfs/netty/writer_pool.hpp>
-#include <thread>
+#include <pfs/netty/posix/wakeup_socket.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -51,24 +92,53 @@ class node: public Loggable
     friend class InputProcessor<node>;
 
     using listener_type = Listener;
-    using socket_type = Socket;
-    using socket_pool_type = netty::socket_pool<socket_type>;
-    using connecting_pool_type = netty::connecting_pool<socket_type, ConnectingPoller>;
-    using listener_pool_type = netty::listener_pool<listener_type, socket_type, ListenerPoller>;
-    using reader_pool_type = netty::reader_pool<socket_type, ReaderPoller>;
-    using writer_pool_type = netty::writer_pool<socket_type, WriterPoller, WriterQueue>;
+    using socket_pool_type = netty::socket_pool<Socket>;
+    using connecting_pool_type = netty::connecting_pool<Socket, ConnectingPoller>;
+    using listener_pool_type = netty::listener_pool<listener_type, Socket, ListenerPoller>;
+    using reader_pool_type = netty::reader_pool<Socket, ReaderPoller>;
+    using writer_pool_type = netty::writer_pool<Socket, WriterPoller, WriterQueue>;
     using listener_id = typename listener_type::listener_id;
     using reconnection_policy = ReconnectionPolicy;
+    using poller_backend_type = typename ReaderPoller::backend_type;
+
+    // All pools use the single poller backend instance (one wait per step for all events)
+    using shared_poller_backend = std::integral_constant<bool
+        , is_shared_backend<poller_backend_type>::value
+            && std::is_same<typename ListenerPoller::backend_type, poller_backend_type>::value
+            && std::is_same<typename ConnectingPoller::backend_type, poller_backend_type>::value
+            && std::is_same<typename WriterPoller::backend_type, poller_backend_type>::value>;
 
 public:
     using node_idintifier_traits = NodeIdintifierTraits;
     using node_id = typename NodeIdintifierTraits::node_id;
+    using socket_type = Socket;
     using socket_id = typename socket_type::socket_id;
     using serializer_traits = SerializerTraits;
+    using stats_type = node_stats<node_id>;
     using callback_suite = CallbackSuite<node>;
 
+    /**
+     * Stream producer: appends the next chunk (not larger than @a max_size bytes) to @a chunk and
+     * returns @c false if it is the last one. Empty @a chunk with @c true result means there is no
+     * data at the moment (producer is called again on the next step).
+     */
+    using stream_producer = std::function<bool (std::vector<char> & chunk, std::size_t max_size)>;
+
+private:
+    // Message submitted by enqueue()
+    struct submission
+    {
+        node_id id;
+        int priority;
+        bool force_checksum;
+        std::vector<char> data;
+    };
+
 private:
     node_id              _id;
+    std::shared_ptr<poller_backend_type> _poller_backend; // Null if backend is not shared
+    posix::wakeup_socket _wakeup; // Interrupts the reader pool poll
+    std::shared_ptr<timing_wheel> _timers; // Handshake, heartbeat and reconnection timers
     listener_pool_type   _listener_pool;
     connecting_pool_type _connecting_pool;
     reader_pool_type     _reader_pool;
@@ -83,34 +153,73 @@ private:
     MessageSender<node> _message_sender;
     InputProcessor<node> _input_processor;
     callback_suite _callbacks;
+    reconnection_policy _reconnection_policy;
 
+    // Channels are indexed by both socket and node identifiers, so the lookups on the channel
+    // state changes do not depend on the number of channels
     std::unordered_map<socket_id, node_id> _readers;
     std::unordered_map<node_id, socket_id> _writers;
+    std::unordered_map<node_id, socket_id> _reader_index; // Node -> reader socket
+    std::unordered_map<socket_id, node_id> _writer_index; // Writer socket -> node
+
+    // Routing (disabled by default): routes to the nodes behind the neighbors
+    routing_table<node_id> _routes;
+    bool _routing_enabled {false};
+    bool _routes_dirty {false}; // Routes must be advertised to the neighbors
+    std::unordered_set<socket_id> _routing_sockets; // Sockets of the peers that support routing
+    std::vector<socket_id> _broadcast_sids; // Reused by broadcast()
+
+    // Received streams broken by the chunk with bad checksum (the rest of chunks are dropped)
+    std::unordered_map<socket_id, std::unordered_set<std::uint32_t>> _broken_streams;
+
+    // Messages submitted from other threads
+    mpsc_queue<submission> _submissions;
+
+    // Optional handler of the accepted sockets (the node serves them itself if not set)
+    std::function<void(socket_type &&)> _dispatch_accepted;
+
+    // Statistics: totals and event counters (gauges and channels are filled by stats()).
+    // Updated by the thread that runs step() only, so no synchronization is needed.
+    stats_type _stats;
+    std::unordered_map<socket_id, traffic_counters> _socket_stats;
+    std::unordered_map<socket_id, std::chrono::steady_clock::time_point> _handshake_starts;
+    std::chrono::milliseconds _stats_interval {0};
+    timing_wheel::timer_id _stats_timer {0};
 
 public:
     node (node_id id, bool behind_nat, callback_suite && callbacks)
         : Loggable()
         , _id(id)
+        , _poller_backend(make_poller_backend(shared_poller_backend{}))
+        , _timers(std::make_shared<timing_wheel>())
+        , _listener_pool(poller_backend<ListenerPoller>(shared_poller_backend{}))
+        , _connecting_pool(poller_backend<ConnectingPoller>(shared_poller_backend{}), _timers)
+        , _reader_pool(poller_backend<ReaderPoller>(shared_poller_backend{}))
+        , _writer_pool(poller_backend<WriterPoller>(shared_poller_backend{}))
         , _behind_nat(behind_nat)
         , _handshake_processor(*this)
         , _heartbeat_processor(*this)
         , _message_sender(*this)
         , _input_processor(*this)
         , _callbacks(std::move(callbacks))
+        , _routes(id)
     {
         _listener_pool.on_failure([this] (netty::error const & err) {
             this->log_error(tr::f_("listener pool failure: {}", err.what()));
         }).on_accepted([this] (socket_type && sock) {
             this->log_debug(tr::f_("socket accepted: #{}: {}", sock.id(), to_string(sock.saddr())));
-            _input_processor.add(sock.id());
-            _reader_pool.add(sock.id());
-            _socket_pool.add_accepted(std::move(sock));
+
+            if (_dispatch_accepted)
+                _dispatch_accepted(std::move(sock));
+            else
+                adopt_accepted(std::move(sock));
         });
 
         _connecting_pool.on_failure([this] (netty::error const & err) {
             this->log_error(tr::f_("connecting pool failure: {}", err.what()));
         }).on_connected([this] (socket_type && sock) {
             this->log_debug(tr::f_("socket connected: #{}: {}", sock.id(), to_string(sock.saddr())));
+            _handshake_starts[sock.id()] = std::chrono::steady_clock::now();
             _handshake_processor.start(sock.id());
             _input_processor.add(sock.id());
             _reader_pool.add(sock.id());
@@ -120,8 +229,10 @@ public:
             this->log_error(tr::f_("connection refused for socket: #{}: {}: reason: {}"
                 ", reconnecting", sid, to_string(saddr), to_string(reason)));
 
-            if (reconnection_policy::timeout() > std::chrono::seconds{0})
-                _connecting_pool.connect_timeout(reconnection_policy::timeout(), saddr);
+            if (_reconnection_policy.enabled()) {
+                _stats.reconnections++;
+                _connecting_pool.connect_timeout(_reconnection_policy.timeout(saddr), saddr);
+            }
         });
 
         _reader_pool.on_failure([this] (socket_id sid, netty::error const & err) {
@@ -132,29 +243,63 @@ public:
             schedule_reconnection(sid);
             close_socket(sid);
         }).on_data_ready([this] (socket_id sid, std::vector<char> && data) {
+            _stats.bytes_read += data.size();
+            _socket_stats[sid].bytes_read += data.size();
             _input_processor.process_input(sid, std::move(data));
+        }).on_wakeup([this] (socket_id) {
+            _wakeup.clear();
         }).on_locate_socket([this] (socket_id sid) {
             return _socket_pool.locate(sid);
         });
 
+        _reader_pool.add_wakeup(_wakeup.id());
+
         _writer_pool.on_failure([this] (socket_id sid, netty::error const & err) {
             this->log_error(tr::f_("write to socket failure: #{}: {}", sid, err.what()));
             schedule_reconnection(sid);
             close_socket(sid);
-        }).on_bytes_written([] (socket_id sid, std::uint64_t n) {
-            // FIXME Use this callback to collect statistics
-            // LOGD("***", "bytes written: id={}: {}", sid, n);
+        }).on_bytes_written([this] (socket_id sid, std::uint64_t n) {
+            auto & counters = _socket_stats[sid];
+            counters.bytes_written += n;
+            counters.write_calls++;
+            _stats.bytes_written += n;
+            _stats.write_calls++;
+        }).on_queue_delay([this] (socket_id /*sid*/, std::chrono::microseconds d) {
+            _stats.queue_delay.add(d);
+        }).on_message_dropped([this] (socket_id sid, int /*priority*/, std::size_t /*size*/) {
+            _socket_stats[sid].messages_dropped++;
+            _stats.messages_dropped++;
+        }).on_congested([this] (socket_id sid) {
+            auto pos = find_writer(sid);
+
+            if (pos != _writers.end() && _callbacks.on_node_congested)
+                _callbacks.on_node_congested(pos->first);
+        }).on_drained([this] (socket_id sid) {
+            auto pos = find_writer(sid);
+
+            if (pos != _writers.end() && _callbacks.on_node_drained)
+                _callbacks.on_node_drained(pos->first);
         }).on_locate_socket([this] (socket_id sid) {
             return _socket_pool.locate(sid);
         });
 
         _handshake_processor.on_failure([this] (socket_id sid, std::string const & errstr) {
             this->log_error(errstr);
+            _stats.handshake_failures++;
             close_socket(sid);
         }).on_expired([this] (socket_id sid) {
             this->log_warn(tr::f_("handshake expired for socket: #{}", sid));
+            _stats.handshake_failures++;
             close_socket(sid);
         }).on_completed([this] (node_id id, socket_id sid, handshake_result_enum status) {
+            auto start_pos = _handshake_starts.find(sid);
+
+            if (start_pos != _handshake_starts.end()) {
+                _stats.handshake_duration.add(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_pos->second));
+                _handshake_starts.erase(start_pos);
+            }
+
             switch (status) {
                 case handshake_result_enum::unusable:
                     this->log_debug(tr::f_("handshake state changed: socket #{} excluded for node: {}"
@@ -165,25 +310,27 @@ public:
                 case handshake_result_enum::reader:
                     this->log_debug(tr::f_("handshake state changed: socket #{} is reader for node: {}"
                         , sid, node_idintifier_traits::stringify(id)));
-                    _readers[sid] = id;
+                    reset_reconnection(sid);
+                    set_reader(sid, id);
                     _heartbeat_processor.add(sid);
 
                     // If the writer already set, full virtual connection established with the
                     // neighbor node.
                     if (find_writer(id) != _writers.end())
-                        _callbacks.on_node_connected(id);
+                        channel_established(id);
 
                     break;
 
                 case handshake_result_enum::writer:
                     this->log_debug(tr::f_("handshake state changed: socket #{} is writer for node: {}"
                         , sid, node_idintifier_traits::stringify(id)));
-                    _writers[id] = sid;
+                    reset_reconnection(sid);
+                    set_writer(id, sid);
                     _heartbeat_processor.add(sid);
 
                     // If the reader already set, channel established with the neighbor node.
                     if (find_reader(id) != _readers.end())
-                        _callbacks.on_node_connected(id);
+                        channel_established(id);
 
                     break;
 
@@ -193,8 +340,14 @@ public:
             }
         });
 
+        _routes.on_route_changed([this] (node_id id, unsigned int hops) {
+            if (_callbacks.on_route_changed)
+                _callbacks.on_route_changed(id, hops);
+        });
+
         _heartbeat_processor.on_expired ([this] (socket_id sid) {
             this->log_warn(tr::f_("socket heartbeat timeout exceeded: #{}", sid));
+            _stats.heartbeat_timeouts++;
             schedule_reconnection(sid);
             close_socket(sid);
         });
@@ -239,60 +392,485 @@ public:
         _listener_pool.listen(backlog);
     }
 
-    void send (node_id id, int priority, bool force_checksum, char const * data, std::size_t len)
+    /**
+     * Enables coalescing of the small messages of @a priority: messages (serialized) smaller than
+     * @a threshold bytes are packed together for each channel and sent when their total size reaches
+     * @a threshold, after @a latency since the first of them, or by flush(). Zero @a latency means
+     * coalescing until the next step. Zero @a threshold disables coalescing (default).
+     */
+    void set_coalescing (int priority, std::size_t threshold
+        , std::chrono::microseconds latency = std::chrono::microseconds{0})
+    {
+        _message_sender.set_coalescing(priority, threshold, latency);
+    }
+
+    /**
+     * Enables compression of the messages of @a priority not smaller than @a threshold bytes by
+     * algorithm @a alg. The algorithm is used for the channels which peers support it (compression
+     * is negotiated by handshake), other messages are sent uncompressed. Messages routed through
+     * the neighbors are not compressed, because the destination may not support the algorithm.
+     * compression_enum::none disables compression (default).
+     */
+    void set_compression (int priority, compression_enum alg, std::size_t threshold = 0)
+    {
+        _message_sender.set_compression(priority, alg, threshold);
+    }
+
+    /**
+     * Sets the water marks of the output queues of all channels: `on_node_congested` is called when
+     * the number of bytes queued for the node reaches @a high_mark, and `on_node_drained` when it
+     * falls to @a low_mark. Zero @a high_mark disables the notifications (default).
+     */
+    void set_water_marks (std::uint64_t high_mark, std::uint64_t low_mark)
+    {
+        _writer_pool.set_water_marks(high_mark, low_mark);
+    }
+
+    /**
+     * Sets the water marks of the output queue of the channel with the node @a id only.
+     *
+     * @return @c false if the node is not found.
+     */
+    bool set_water_marks (node_id id, std::uint64_t high_mark, std::uint64_t low_mark)
     {
         auto pos = _writers.find(id);
 
-        if (pos != _writers.end()) {
-            _message_sender.send(pos->second, priority, force_checksum, data, len);
+        if (pos == _writers.end())
+            return false;
+
+        return _writer_pool.set_water_marks(pos->second, high_mark, low_mark);
+    }
+
+    /**
+     * Checks if the output queue of the channel with the node @a id is above the high water mark.
+     */
+    bool is_congested (node_id id) const
+    {
+        auto pos = _writers.find(id);
+        return pos != _writers.end() && _writer_pool.is_congested(pos->second);
+    }
+
+    /**
+     * Limits the number of bytes of the @a priority queued for each node. The message that
+     * overflows the @a limit is rejected or the oldest messages are dropped (e.g. for telemetry)
+     * according to the @a policy. Zero @a limit removes the limit (default).
+     *
+     * Streams are not sent by the priority with the limit: the active streams of the @a priority
+     * fail (see send_stream()).
+     */
+    void set_overflow_policy (int priority, std::size_t limit, overflow_policy_enum policy)
+    {
+        _writer_pool.set_overflow_policy(priority, limit, policy);
+
+        if (_writer_pool.overflow_policy(priority) != overflow_policy_enum::accept)
+            _message_sender.fail_streams(priority, "overflow policy is set for the stream priority");
+    }
+
+    /**
+     * Enables routing: the node exchanges the routing tables with the neighbors (that support
+     * routing), forwards the packets addressed to other nodes and sends the messages to the nodes
+     * that are not neighbors through the neighbor on the shortest route. Routes are limited by
+     * @a max_hops (the initial TTL of the routed packets).
+     */
+    void set_routing (bool enable, unsigned int max_hops = 16)
+    {
+        PFS__TERMINATE(max_hops > 0 && max_hops < 256, "meshnet::node: max hops is out of range");
+
+        _routing_enabled = enable;
+        _routes.set_max_hops(max_hops);
+
+        if (enable) {
+            for (auto const & w: _writers) {
+                if (_routing_sockets.count(w.second) > 0 && find_reader(w.first) != _readers.end())
+                    _routes.add_neighbor(w.first);
+            }
         } else {
-            this->log_error(tr::f_("node for send message not found: {}", node_idintifier_traits::stringify(id)));
+            for (auto const & id: _routes.neighbors())
+                _routes.remove_neighbor(id);
         }
+
+        _routes_dirty = enable;
+    }
+
+    /**
+     * Number of hops to the node @a id: one for the neighbors, zero if the node is unreachable.
+     */
+    unsigned int hops (node_id id) const
+    {
+        if (_writers.find(id) != _writers.end())
+            return 1;
+
+        auto r = _routes.find(id);
+        return r != nullptr ? r->hops : 0;
+    }
+
+    /**
+     * Sets the interval of sending the heartbeats to the neighbor nodes.
+     */
+    void set_heartbeat_interval (std::chrono::milliseconds interval)
+    {
+        _heartbeat_processor.set_interval(interval);
+    }
+
+    /**
+     * Sets the fixed heartbeat expiration @a timeout and the lower bound @a min_timeout of the
+     * expiration timeout adapted to the RTT of the channel. The fixed timeout is used until the
+     * RTT is measured and it is the upper bound of the adaptive one.
+     */
+    void set_heartbeat_timeout (std::chrono::milliseconds timeout, std::chrono::milliseconds min_timeout)
+    {
+        _heartbeat_processor.set_timeout(timeout, min_timeout);
     }
 
-    void send (node_id id, int priority, bool force_checksum, std::vector<char> && data)
+    /**
+     * Sets the @a initial and the @a max delays of the reconnection to the target (see
+     * reconnection_policy).
+     */
+    void set_reconnection_backoff (std::chrono::milliseconds initial, std::chrono::milliseconds max)
+    {
+        _reconnection_policy.set_backoff(initial, max);
+    }
+
+    /**
+     * Limits the reconnections: at most @a max_in_flight sockets are connecting simultaneously
+     * and at most @a per_second reconnections are started per second (see
+     * connecting_pool::set_limits()). Zero value disables the corresponding limit.
+     */
+    void set_connection_limits (std::size_t max_in_flight, double per_second)
+    {
+        _connecting_pool.set_limits(max_in_flight, per_second);
+    }
+
+    /**
+     * Round-trip time of the channel with the node @a id measured by heartbeats (not measured if
+     * the node is not found or the peer does not support heartbeat timestamps).
+     */
+    rtt_estimator rtt (node_id id) const
     {
         auto pos = _writers.find(id);
 
         if (pos != _writers.end()) {
-            _message_sender.send(pos->second, priority, force_checksum, std::move(data));
-        } else {
-            this->log_error(tr::f_("node for send message not found: {}", node_idintifier_traits::stringify(id)));
+            auto prtt = _heartbeat_processor.rtt(pos->second);
+
+            if (prtt != nullptr)
+                return *prtt;
         }
+
+        return rtt_estimator{};
+    }
+
+    /**
+     * Sets the maximum size of the stream chunk and the size of the output queue of the channel
+     * the stream chunks are produced up to (see send_stream()).
+     */
+    void set_stream_limits (std::size_t chunk_size, std::size_t window)
+    {
+        _message_sender.set_stream_limits(chunk_size, window);
     }
 
-    void send (node_id id, int priority, char const * data, std::size_t len)
+    /**
+     * Starts sending the stream of unlimited size to the node @a id. Chunks are pulled from
+     * @a producer by step() while the output queue of the channel is smaller than the stream window
+     * (see set_stream_limits()), so the memory used is bounded. The receiver gets the chunks by
+     * `on_stream_chunk` callback. The producer is destroyed after the last chunk or on disconnection.
+     *
+     * Chunks must not be lost, so the @a priority must not be limited by the overflow policy (see
+     * set_overflow_policy()). If the chunk is rejected by the output queue anyway, the stream
+     * fails: the producer is destroyed and `on_stream_failed` callback is called (the receiver does
+     * not get the last chunk).
+     *
+     * @return Stream ID or zero if the node is not found, does not support streams or the
+     *         @a priority is limited.
+     */
+    std::uint32_t send_stream (node_id id, int priority, bool force_checksum, stream_producer producer)
     {
-        this->send(id, priority, false, data, len);
+        auto pos = _writers.find(id);
+
+        if (pos == _writers.end()) {
+            this->log_error(tr::f_("node for send stream not found: {}", node_idintifier_traits::stringify(id)));
+            return 0;
+        }
+
+        if (_writer_pool.overflow_policy(priority) != overflow_policy_enum::accept) {
+            this->log_error(tr::f_("stream priority is limited by the overflow policy: {}", priority));
+            return 0;
+        }
+
+        auto stream_id = _message_sender.send_stream(pos->second, priority, force_checksum, std::move(producer));
+
+        if (stream_id == 0)
+            this->log_error(tr::f_("node does not support streams: {}", node_idintifier_traits::stringify(id)));
+
+        return stream_id;
     }
 
-    void send (node_id id, int priority, std::vector<char> && data)
+    std::uint32_t send_stream (node_id id, int priority, stream_producer producer)
     {
-        this->send(id, priority, false, std::move(data));
+        return this->send_stream(id, priority, false, std::move(producer));
     }
 
+    /**
+     * Returns the statistics snapshot: totals since the node creation, current queue sizes and
+     * counters of the established channels (since the channel sockets are connected). Must be
+     * called from the thread that runs step().
+     */
+    stats_type stats () const
+    {
+        stats_type result = _stats;
+        result.timestamp = std::chrono::steady_clock::now();
+        result.queue_bytes = _writer_pool.remain_bytes();
+        result.channel_count = _writers.size();
+        result.route_count = _routes.size();
+
+        for (auto const & w: _writers) {
+            auto & ch = result.channels[w.first];
+            auto pos = _socket_stats.find(w.second);
+
+            if (pos != _socket_stats.end())
+                accumulate(ch, pos->second);
+
+            ch.queue_bytes = _writer_pool.remain_bytes(w.second);
+            ch.congested = _writer_pool.is_congested(w.second);
+
+            auto prtt = _heartbeat_processor.rtt(w.second);
+
+            if (prtt != nullptr && prtt->measured()) {
+                ch.srtt = prtt->srtt();
+                ch.rttvar = prtt->rttvar();
+            }
+        }
+
+        // Reader sockets that are not writers too
+        for (auto const & r: _readers) {
+            auto wpos = _writers.find(r.second);
+
+            if (wpos != _writers.end() && wpos->second == r.first)
+                continue;
+
+            auto pos = _socket_stats.find(r.first);
+
+            if (pos != _socket_stats.end())
+                accumulate(result.channels[r.second], pos->second);
+        }
+
+        return result;
+    }
+
+    /**
+     * Enables periodic reporting of the statistics by `on_stats` callback with @a interval. Zero
+     * @a interval disables reporting (default).
+     */
+    void set_stats_interval (std::chrono::milliseconds interval)
+    {
+        if (_stats_timer != 0) {
+            _timers->cancel(_stats_timer);
+            _stats_timer = 0;
+        }
+
+        _stats_interval = interval;
+
+        if (_stats_interval > std::chrono::milliseconds{0}) {
+            _stats_timer = _timers->start(_stats_interval, [this] () {
+                report_stats();
+            });
+        }
+    }
+
+    /**
+     * Sends the coalesced messages to all nodes.
+     */
+    void flush ()
+    {
+        _message_sender.flush();
+    }
+
+    /**
+     * Sends the coalesced messages to the node @a id.
+     */
+    void flush (node_id id)
+    {
+        auto pos = _writers.find(id);
+
+        if (pos != _writers.end())
+            _message_sender.flush(pos->second);
+    }
+
+    /**
+     * Sets the bandwidth shares of the priorities for all channels: number of bytes each priority
+     * may send per scheduling round (see priority_writer_queue::set_quantum()). @a quanta are
+     * listed from the highest priority, the quanta of the rest priorities are left unchanged.
+     */
+    void set_priority_quanta (std::vector<std::size_t> quanta)
+    {
+        PFS__TERMINATE(quanta.size() <= static_cast<std::size_t>(priority_count())
+            , "too many priority quanta");
+
+        _writer_pool.on_queue_setup([quanta] (WriterQueue & q) {
+            for (std::size_t i = 0; i < quanta.size(); i++)
+                q.set_quantum(static_cast<int>(i), quanta[i]);
+        });
+    }
+
+    /**
+     * Sets the bandwidth shares of the priorities for the channel with node @a id only. Setting
+     * is lost on reconnection.
+     *
+     * @return @c false if there is no channel with node @a id.
+     */
+    bool set_priority_quanta (node_id id, std::vector<std::size_t> const & quanta)
+    {
+        PFS__TERMINATE(quanta.size() <= static_cast<std::size_t>(priority_count())
+            , "too many priority quanta");
+
+        auto pos = _writers.find(id);
+
+        if (pos == _writers.end())
+            return false;
+
+        return _writer_pool.setup_queue(pos->second, [& quanta] (WriterQueue & q) {
+            for (std::size_t i = 0; i < quanta.size(); i++)
+                q.set_quantum(static_cast<int>(i), quanta[i]);
+        });
+    }
+
+    /**
+     * Sends the message to the node @a id: directly if it is the neighbor, or through the
+     * neighbor on the shortest route if routing is enabled (see set_routing()).
+     *
+     * @return @c false if the node is not reachable or the message is rejected by the overflow
+     *         policy of the @a priority (see set_overflow_policy()). Coalesced messages are
+     *         reported as accepted, their rejection is counted by the statistics only.
+     */
+    bool send (node_id id, int priority, bool force_checksum, char const * data, std::size_t len)
+    {
+        auto pos = _writers.find(id);
+
+        if (pos == _writers.end())
+            return send_routed(id, priority, force_checksum, data, len);
+
+        count_message_sent(pos->second);
+        return _message_sender.send(pos->second, priority, force_checksum, data, len);
+    }
+
+    bool send (node_id id, int priority, bool force_checksum, std::vector<char> && data)
+    {
+        auto pos = _writers.find(id);
+
+        if (pos == _writers.end())
+            return send_routed(id, priority, force_checksum, data.data(), data.size());
+
+        count_message_sent(pos->second);
+        return _message_sender.send(pos->second, priority, force_checksum, std::move(data));
+    }
+
+    bool send (node_id id, int priority, char const * data, std::size_t len)
+    {
+        return this->send(id, priority, false, data, len);
+    }
+
+    bool send (node_id id, int priority, std::vector<char> && data)
+    {
+        return this->send(id, priority, false, std::move(data));
+    }
+
+    /**
+     * Sends the message to all the neighbor nodes (routed nodes are not included). The packet is
+     * serialized once per negotiated checksum and compression algorithms, and it is shared by
+     * the output queues of the sockets, so the memory used does not grow with the number of
+     * neighbors.
+     */
+    void broadcast (int priority, bool force_checksum, shared_buffer const & data)
+    {
+        _broadcast_sids.clear();
+
+        for (auto const & w: _writers) {
+            count_message_sent(w.second);
+            _broadcast_sids.push_back(w.second);
+        }
+
+        _message_sender.broadcast(_broadcast_sids, priority, force_checksum, data);
+    }
+
+    void broadcast (int priority, shared_buffer const & data)
+    {
+        this->broadcast(priority, false, data);
+    }
+
+    /**
+     * Thread-safe version of send(): the message is passed to the thread that runs step() through
+     * the lock-free queue, and the poll is interrupted to send it immediately.
+     */
+    void enqueue (node_id id, int priority, bool force_checksum, std::vector<char> && data)
+    {
+        _submissions.push(submission{id, priority, force_checksum, std::move(data)});
+        _wakeup.notify();
+    }
+
+    void enqueue (node_id id, int priority, bool force_checksum, char const * data, std::size_t len)
+    {
+        this->enqueue(id, priority, force_checksum, std::vector<char>(data, data + len));
+    }
+
+    void enqueue (node_id id, int priority, char const * data, std::size_t len)
+    {
+        this->enqueue(id, priority, false, data, len);
+    }
+
+    void enqueue (node_id id, int priority, std::vector<char> && data)
+    {
+        this->enqueue(id, priority, false, std::move(data));
+    }
+
+    /**
+     * Interrupts the current (or the next) step() poll. Can be called from any thread.
+     */
+    void wakeup ()
+    {
+        _wakeup.notify();
+    }
+
+    /**
+     * Performs single iteration of the event loop.
+     *
+     * The node sleeps inside the reader pool poll only. The poll timeout is @a millis limited by the
+     * nearest deadline of the timing wheel (handshake, heartbeat and reconnection timers), or zero
+     * if there is data ready to send. The poll is interrupted by enqueue()/wakeup() and by the input data (by any
+     * socket event if the pools share the poller backend), so the step returns as soon as there
+     * is a work to do.
+     */
     void step (std::chrono::milliseconds millis)
     {
-        pfs::countdown_timer<std::milli> countdown_timer {millis};
+        process_submissions();
 
         _listener_pool.step();
         _connecting_pool.step();
+        _message_sender.step();
         _writer_pool.step();
 
-        millis = countdown_timer.remain();
+        _reader_pool.step(poll_timeout(millis));
+
+        // Send messages submitted while polling and the data to the sockets became writable
+        process_submissions();
+        _message_sender.step();
+
+        if (_writer_pool.has_active())
+            _writer_pool.step();
+
+        // Expire handshake, heartbeat and reconnection timers
+        _timers->advance();
 
-        _reader_pool.step(millis);
         _handshake_processor.step();
         _heartbeat_processor.step();
 
+        if (_routes_dirty)
+            advertise_routes();
+
         // Remove trash
         _connecting_pool.apply_remove();
         _listener_pool.apply_remove();
         _reader_pool.apply_remove();
         _writer_pool.apply_remove();
         _socket_pool.apply_remove(); // Must be last in the removing sequence
-
-        std::this_thread::sleep_for(countdown_timer.remain());
     }
 
 public: // static
@@ -302,6 +880,29 @@ public: // static
     }
 
 private:
+    static std::shared_ptr<poller_backend_type> make_poller_backend (std::true_type)
+    {
+        return std::make_shared<poller_backend_type>();
+    }
+
+    static std::shared_ptr<poller_backend_type> make_poller_backend (std::false_type)
+    {
+        return nullptr;
+    }
+
+    // Backend types are the same for all pollers if it is shared
+    template <typename Poller>
+    std::shared_ptr<typename Poller::backend_type> poller_backend (std::true_type) const
+    {
+        return _poller_backend;
+    }
+
+    template <typename Poller>
+    std::shared_ptr<typename Poller::backend_type> poller_backend (std::false_type) const
+    {
+        return nullptr;
+    }
+
     typename std::unordered_map<socket_id, node_id>::iterator find_reader (socket_id sid)
     {
         return _readers.find(sid);
@@ -309,10 +910,8 @@ private:
 
     typename std::unordered_map<socket_id, node_id>::iterator find_reader (node_id id)
     {
-        for (auto pos = _readers.begin(); pos != _readers.end(); ++pos)
-            if (pos->second == id)
-                return pos;
-        return _readers.end();
+        auto pos = _reader_index.find(id);
+        return pos != _reader_index.end() ? _readers.find(pos->second) : _readers.end();
     }
 
     typename std::unordered_map<node_id, socket_id>::iterator find_writer (node_id id)
@@ -322,11 +921,47 @@ private:
 
     typename std::unordered_map<node_id, socket_id>::iterator find_writer (socket_id sid)
     {
-        for (auto pos = _writers.begin(); pos != _writers.end(); ++pos)
-            if (pos->second == sid)
-                return pos;
+        auto pos = _writer_index.find(sid);
+        return pos != _writer_index.end() ? _writers.find(pos->second) : _writers.end();
+    }
 
-        return _writers.end();
+    void set_reader (socket_id sid, node_id id)
+    {
+        auto pos = _readers.find(sid);
+
+        if (pos != _readers.end())
+            erase_reader(pos);
+
+        _readers.emplace(sid, id);
+        _reader_index[id] = sid;
+    }
+
+    void set_writer (node_id id, socket_id sid)
+    {
+        auto pos = _writers.find(id);
+
+        if (pos != _writers.end())
+            erase_writer(pos);
+
+        _writers.emplace(id, sid);
+        _writer_index[sid] = id;
+    }
+
+    void erase_reader (typename std::unordered_map<socket_id, node_id>::iterator pos)
+    {
+        auto ipos = _reader_index.find(pos->second);
+
+        // Index may refer to the newer reader of the node
+        if (ipos != _reader_index.end() && ipos->second == pos->first)
+            _reader_index.erase(ipos);
+
+        _readers.erase(pos);
+    }
+
+    void erase_writer (typename std::unordered_map<node_id, socket_id>::iterator pos)
+    {
+        _writer_index.erase(pos->second);
+        _writers.erase(pos);
     }
 
     // Acceptable values for level: 0 or 1
@@ -334,18 +969,20 @@ private:
     {
         _handshake_processor.cancel(sid);
         _heartbeat_processor.remove(sid);
+        _message_sender.remove(sid);
         _input_processor.remove(sid);
         _reader_pool.remove_later(sid);
         _writer_pool.remove_later(sid);
         _socket_pool.remove_later(sid);
+        _socket_stats.erase(sid);
+        _handshake_starts.erase(sid);
+        _routing_sockets.erase(sid);
+        _broken_streams.erase(sid);
 
         if (level == 0)
             close_channel(sid, level);
     }
 
-    // TODO More optimized data structures and algorithms are needed to track the lifecycle of node
-    // connections.
-    //
     // Closes channel associated with socket identifier.
     // One socket may be reader and writer simultaneously, or reader and writer may be represented
     // by two different sockets.
@@ -363,9 +1000,9 @@ private:
         if (rpos != _readers.end() && wpos != _writers.end()) {
             auto id = wpos->first;
             PFS__ASSERT(id == rpos->second, "Fix meshnet::node algorithm");
-            _readers.erase(rpos);
-            _writers.erase(wpos);
-            _callbacks.on_node_disconnected(id);
+            erase_reader(rpos);
+            erase_writer(wpos);
+            channel_closed(id);
             return;
         }
 
@@ -378,11 +1015,11 @@ private:
             if (rpos != _readers.end()) {
                 auto id = wpos->first;
                 close_socket(rpos->first, ++level);
-                _readers.erase(rpos);
-                _writers.erase(wpos);
-                _callbacks.on_node_disconnected(id);
+                erase_reader(rpos);
+                erase_writer(wpos);
+                channel_closed(id);
             } else {
-                _writers.erase(wpos);
+                erase_writer(wpos);
             }
 
             return;
@@ -396,11 +1033,11 @@ private:
             if (wpos != _writers.end()) {
                 auto id = rpos->second;
                 close_socket(wpos->second, ++level);
-                _readers.erase(rpos);
-                _writers.erase(wpos);
-                _callbacks.on_node_disconnected(id);
+                erase_reader(rpos);
+                erase_writer(wpos);
+                channel_closed(id);
             } else {
-                _readers.erase(rpos);
+                erase_reader(rpos);
             }
 
             return;
@@ -412,24 +1049,357 @@ private:
 
     void schedule_reconnection (socket_id sid)
     {
-        if (reconnection_policy::timeout() > std::chrono::seconds{0}) {
+        if (_reconnection_policy.enabled()) {
             bool is_accepted = false;
             auto psock = _socket_pool.locate(sid, & is_accepted);
             auto reconnecting = !is_accepted;
 
             PFS__TERMINATE(psock != nullptr, "Fix meshnet::node algorithm");
 
-            if (reconnecting)
-                _connecting_pool.connect_timeout(reconnection_policy::timeout(), psock->saddr());
+            if (reconnecting) {
+                _stats.reconnections++;
+                _connecting_pool.connect_timeout(_reconnection_policy.timeout(psock->saddr())
+                    , psock->saddr());
+            }
+        }
+    }
+
+    // Connection to the target is usable, so the next reconnection starts from the initial delay
+    void reset_reconnection (socket_id sid)
+    {
+        bool is_accepted = false;
+        auto psock = _socket_pool.locate(sid, & is_accepted);
+
+        if (psock != nullptr && !is_accepted)
+            _reconnection_policy.reset(psock->saddr());
+    }
+
+    std::chrono::milliseconds poll_timeout (std::chrono::milliseconds millis)
+    {
+        if (_writer_pool.has_active() || !_submissions.empty())
+            return std::chrono::milliseconds{0};
+
+        auto deadline = _timers->next_deadline();
+
+        if (deadline == std::chrono::steady_clock::time_point::max())
+            return millis;
+
+        auto now = std::chrono::steady_clock::now();
+
+        if (deadline <= now)
+            return std::chrono::milliseconds{0};
+
+        // Round up to not wake up before the deadline
+        auto remain = deadline - now;
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(remain);
+
+        if (timeout < remain)
+            ++timeout;
+
+        return (std::min)(millis, timeout);
+    }
+
+    /**
+     * @return @c true if any message is submitted.
+     */
+    bool process_submissions ()
+    {
+        bool res = false;
+        submission msg;
+
+        while (_submissions.try_pop(msg)) {
+            res = true;
+            send(msg.id, msg.priority, msg.force_checksum, std::move(msg.data));
         }
+
+        return res;
     }
 
-    void process_message_received (socket_id sid, std::vector<char> && bytes)
+    /**
+     * Delivers the received message. Message is copied only if the `on_message_view` callback
+     * is not set.
+     */
+    void process_message_received (socket_id sid, char const * data, std::size_t len)
     {
         auto pos = _readers.find(sid);
 
-        if (pos != _readers.end())
-            _callbacks.on_message_received(pos->second, std::move(bytes));
+        if (pos == _readers.end())
+            return;
+
+        count_message_received(sid);
+
+        if (_callbacks.on_message_view)
+            _callbacks.on_message_view(pos->second, data, len);
+        else
+            _callbacks.on_message_received(pos->second, std::vector<char>(data, data + len));
+    }
+
+    /**
+     * Delivers the received stream chunk.
+     */
+    void process_stream_chunk (socket_id sid, std::uint32_t stream_id, std::uint64_t offset
+        , char const * data, std::size_t len, bool last)
+    {
+        if (!_callbacks.on_stream_chunk)
+            return;
+
+        auto pos = _readers.find(sid);
+
+        if (pos == _readers.end())
+            return;
+
+        auto bpos = _broken_streams.find(sid);
+
+        if (bpos != _broken_streams.end() && bpos->second.count(stream_id) > 0) {
+            if (last) {
+                bpos->second.erase(stream_id);
+
+                if (bpos->second.empty())
+                    _broken_streams.erase(bpos);
+            }
+
+            return;
+        }
+
+        count_message_received(sid);
+        _callbacks.on_stream_chunk(pos->second, stream_id, offset, data, len, last);
+    }
+
+    /**
+     * Drops the data packet failed the checksum. The stream is reported broken if the packet is
+     * its chunk: the remaining chunks of the stream are dropped too.
+     */
+    void process_corrupted_packet (socket_id sid, data_packet const & pkt)
+    {
+        auto pos = _readers.find(sid);
+
+        if (pos == _readers.end())
+            return;
+
+        if (!pkt.is_stream_chunk()) {
+            this->log_error(tr::f_("bad checksum, message from {} dropped"
+                , node_idintifier_traits::stringify(pos->second)));
+            return;
+        }
+
+        this->log_error(tr::f_("bad checksum, stream #{} from {} broken", pkt.stream_id()
+            , node_idintifier_traits::stringify(pos->second)));
+
+        if (!pkt.is_last_chunk())
+            _broken_streams[sid].insert(pkt.stream_id());
+
+        if (_callbacks.on_stream_broken)
+            _callbacks.on_stream_broken(pos->second, pkt.stream_id());
+    }
+
+    void channel_established (node_id id)
+    {
+        _stats.connections++;
+
+        if (_routing_enabled) {
+            auto pos = _writers.find(id);
+
+            if (pos != _writers.end() && _routing_sockets.count(pos->second) > 0) {
+                _routes.add_neighbor(id);
+
+                // Full table is sent to the new neighbor anyway
+                _routes_dirty = true;
+            }
+        }
+
+        _callbacks.on_node_connected(id);
+    }
+
+    void channel_closed (node_id id)
+    {
+        _stats.disconnections++;
+
+        if (_routes.remove_neighbor(id))
+            _routes_dirty = true;
+
+        _callbacks.on_node_disconnected(id);
+    }
+
+    bool send_routed (node_id id, int priority, bool force_checksum, char const * data, std::size_t len)
+    {
+        auto r = _routing_enabled ? _routes.find(id) : nullptr;
+        auto pos = r != nullptr ? _writers.find(r->gateway) : _writers.end();
+
+        if (pos == _writers.end()) {
+            this->log_error(tr::f_("node for send message not found: {}", node_idintifier_traits::stringify(id)));
+            return false;
+        }
+
+        count_message_sent(pos->second);
+        return _message_sender.send_routed(pos->second, priority, force_checksum
+            , static_cast<std::uint8_t>(_routes.max_hops())
+            , node_idintifier_traits::encode(_id), node_idintifier_traits::encode(id), data, len);
+    }
+
+    /**
+     * Sends the routing table to the neighbors that support routing.
+     */
+    void advertise_routes ()
+    {
+        _routes_dirty = false;
+
+        if (!_routing_enabled)
+            return;
+
+        for (auto const & n: _routes.neighbors()) {
+            auto pos = _writers.find(n);
+
+            if (pos == _writers.end() || _routing_sockets.count(pos->second) == 0)
+                continue;
+
+            route_packet pkt;
+
+            for (auto const & d: _routes.advertisement(n)) {
+                pkt.routes.push_back(route_packet::entry {node_idintifier_traits::encode(d.first)
+                    , static_cast<std::uint8_t>((std::min)(d.second, 255u))});
+            }
+
+            auto out = serializer_traits::make_serializer();
+            pkt.serialize(out);
+            send_private(pos->second, 0, out.data(), out.size());
+        }
+    }
+
+    /**
+     * Replaces the routes advertised by the neighbor.
+     */
+    void process_route (socket_id sid, route_packet const & pkt)
+    {
+        if (!_routing_enabled)
+            return;
+
+        auto pos = _readers.find(sid);
+
+        if (pos == _readers.end())
+            return;
+
+        std::vector<std::pair<node_id, unsigned int>> destinations;
+        destinations.reserve(pkt.routes.size());
+
+        for (auto const & r: pkt.routes) {
+            auto optid = node_idintifier_traits::decode(r.id.data(), r.id.size());
+
+            if (optid)
+                destinations.emplace_back(*optid, r.hops);
+        }
+
+        if (_routes.update(pos->second, destinations))
+            _routes_dirty = true;
+    }
+
+    /**
+     * Delivers the routed message addressed to this node.
+     */
+    void process_routed_message (socket_id sid, data_packet const & pkt, char const * data, std::size_t len)
+    {
+        auto optid = node_idintifier_traits::decode(pkt.source, pkt.source_size);
+
+        if (!optid)
+            return;
+
+        count_message_received(sid);
+
+        if (_callbacks.on_message_view)
+            _callbacks.on_message_view(*optid, data, len);
+        else
+            _callbacks.on_message_received(*optid, std::vector<char>(data, data + len));
+    }
+
+    /**
+     * Forwards the routed @a packet (raw bytes as received) to the next hop with decremented TTL.
+     *
+     * @return @c false if the packet is addressed to this node.
+     */
+    bool forward_packet (socket_id sid, int priority, data_packet const & pkt, char const * packet
+        , std::size_t size)
+    {
+        // Bad checksum or malformed packet
+        if (pkt.payload == nullptr)
+            return true;
+
+        auto optid = node_idintifier_traits::decode(pkt.destination, pkt.destination_size);
+
+        if (!optid)
+            return true;
+
+        if (*optid == _id)
+            return false;
+
+        auto pos = _writers.find(*optid);
+
+        // The neighbor that does not support routing can not parse the routed packet
+        if (pos != _writers.end() && _routing_sockets.count(pos->second) == 0)
+            pos = _writers.end();
+
+        if (pos == _writers.end() && _routing_enabled) {
+            auto r = _routes.find(*optid);
+
+            if (r != nullptr) {
+                pos = _writers.find(r->gateway);
+
+                if (pos != _writers.end() && _routing_sockets.count(pos->second) == 0)
+                    pos = _writers.end();
+            }
+        }
+
+        if (!_routing_enabled || pos == _writers.end() || pkt.ttl() <= 1 || pos->second == sid) {
+            this->log_debug(tr::f_("routed packet dropped: destination: {}, TTL: {}"
+                , node_idintifier_traits::stringify(*optid), pkt.ttl()));
+            _stats.messages_dropped++;
+            return true;
+        }
+
+        // Packet is forwarded as is, TTL is the last byte of the header
+        std::vector<char> out(packet, packet + size);
+        out[static_cast<std::size_t>(pkt.body() - packet) - 1] = static_cast<char>(pkt.ttl() - 1);
+
+        _stats.messages_forwarded++;
+        send_private(pos->second, priority, std::move(out));
+        return true;
+    }
+
+    void count_message_sent (socket_id sid)
+    {
+        _socket_stats[sid].messages_sent++;
+        _stats.messages_sent++;
+    }
+
+    void count_message_received (socket_id sid)
+    {
+        _socket_stats[sid].messages_received++;
+        _stats.messages_received++;
+    }
+
+    void count_packet_enqueued (socket_id sid)
+    {
+        _socket_stats[sid].packets_enqueued++;
+        _stats.packets_enqueued++;
+    }
+
+    static void accumulate (traffic_counters & acc, traffic_counters const & c) noexcept
+    {
+        acc.bytes_written += c.bytes_written;
+        acc.bytes_read += c.bytes_read;
+        acc.write_calls += c.write_calls;
+        acc.packets_enqueued += c.packets_enqueued;
+        acc.messages_sent += c.messages_sent;
+        acc.messages_received += c.messages_received;
+        acc.messages_dropped += c.messages_dropped;
+    }
+
+    void report_stats ()
+    {
+        _stats_timer = _timers->start(_stats_interval, [this] () {
+            report_stats();
+        });
+
+        if (_callbacks.on_stats)
+            _callbacks.on_stats(stats());
     }
 
     HandshakeProcessor<node> & handshake_processor ()
@@ -443,14 +1413,95 @@ private:
     }
 
 public: // Below methods are for internal use only
-    void send_private (socket_id sid, int priority, char const * data, std::size_t len)
+    /**
+     * Sets the handler of the accepted sockets, it takes the ownership of the socket (e.g. passes
+     * it to the another node).
+     */
+    template <typename F>
+    node & dispatch_accepted (F && f)
+    {
+        _dispatch_accepted = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Serves the socket accepted by the listener of this or another node.
+     */
+    void adopt_accepted (socket_type && sock)
+    {
+        _handshake_starts[sock.id()] = std::chrono::steady_clock::now();
+        _input_processor.add(sock.id());
+        _reader_pool.add(sock.id());
+        _socket_pool.add_accepted(std::move(sock));
+    }
+
+    /**
+     * @return @c false if the data is rejected by the overflow policy of the @a priority.
+     */
+    bool send_private (socket_id sid, int priority, char const * data, std::size_t len)
+    {
+        count_packet_enqueued(sid);
+        return _writer_pool.enqueue(sid, priority, data, len);
+    }
+
+    bool send_private (socket_id sid, int priority, std::vector<char> && data)
+    {
+        count_packet_enqueued(sid);
+        return _writer_pool.enqueue(sid, priority, std::move(data));
+    }
+
+    bool send_private (socket_id sid, int priority, shared_buffer const & data)
+    {
+        count_packet_enqueued(sid);
+        return _writer_pool.enqueue(sid, priority, data);
+    }
+
+    /**
+     * Reports the stream @a stream_id to the node on socket @a sid failed (its producer is
+     * destroyed by the message sender).
+     */
+    void fail_stream (socket_id sid, std::uint32_t stream_id, char const * reason)
+    {
+        auto pos = find_writer(sid);
+
+        if (pos == _writers.end())
+            return;
+
+        this->log_error(tr::f_("stream #{} to {} failed: {}", stream_id
+            , node_idintifier_traits::stringify(pos->first), reason));
+
+        if (_callbacks.on_stream_failed)
+            _callbacks.on_stream_failed(pos->first, stream_id);
+    }
+
+    /**
+     * Sets the checksum and compression algorithms, streams, heartbeat timestamps and routing
+     * support of the peer on socket @a sid by the received handshake packet.
+     */
+    template <typename HandshakePacket>
+    void negotiate (socket_id sid, HandshakePacket const & pkt)
+    {
+        _message_sender.negotiate(sid, pkt);
+        _heartbeat_processor.negotiate(sid, pkt);
+
+        if (pkt.supports_routing())
+            _routing_sockets.insert(sid);
+    }
+
+    /**
+     * Number of bytes in the output queue of the socket @a sid.
+     */
+    std::uint64_t remain_bytes (socket_id sid) const noexcept
     {
-        _writer_pool.enqueue(sid, priority, data, len);
+        return _writer_pool.remain_bytes(sid);
     }
 
-    void send_private (socket_id sid, int priority, std::vector<char> && data)
+    /**
+     * Timers of the node (shared with the connecting pool), advanced by step().
+     */
+    timing_wheel & timers () noexcept
     {
-        _writer_pool.enqueue(sid, priority, std::move(data));
+        return *_timers;
     }
 };
 
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+//                 Added send queue delay histogram.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/namespace.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace patterns {
+namespace meshnet {
+
+/**
+ * Histogram of durations with logarithmic buckets: bucket @c i counts the durations in range
+ * [2^(i-1), 2^i) microseconds (bucket 0 - less than 1 microsecond, the last one - the rest).
+ */
+class latency_histogram
+{
+public:
+    static constexpr std::size_t bucket_count = 32;
+
+private:
+    std::array<std::uint64_t, bucket_count> _buckets {};
+    std::uint64_t _count {0};
+    std::uint64_t _sum {0}; // Microseconds
+    std::uint64_t _min {(std::numeric_limits<std::uint64_t>::max)()};
+    std::uint64_t _max {0};
+
+public:
+    void add (std::chrono::microseconds d) noexcept
+    {
+        auto us = static_cast<std::uint64_t>((std::max)(d.count(), std::chrono::microseconds::rep{0}));
+        std::size_t index = 0;
+
+        for (auto v = us; v > 0 && index < bucket_count - 1; v >>= 1)
+            index++;
+
+        _buckets[index]++;
+        _count++;
+        _sum += us;
+        _min = (std::min)(_min, us);
+        _max = (std::max)(_max, us);
+    }
+
+    std::uint64_t count () const noexcept
+    {
+        return _count;
+    }
+
+    std::uint64_t bucket (std::size_t index) const noexcept
+    {
+        return _buckets[index];
+    }
+
+    std::chrono::microseconds min () const noexcept
+    {
+        return std::chrono::microseconds{_count > 0 ? static_cast<std::int64_t>(_min) : 0};
+    }
+
+    std::chrono::microseconds max () const noexcept
+    {
+        return std::chrono::microseconds{static_cast<std::int64_t>(_max)};
+    }
+
+    std::chrono::microseconds mean () const noexcept
+    {
+        return std::chrono::microseconds{_count > 0 ? static_cast<std::int64_t>(_sum / _count) : 0};
+    }
+
+    /**
+     * Upper bound of the bucket containing the @a q quantile (0.0 ... 1.0), e.g. 0.99 for p99.
+     */
+    std::chrono::microseconds quantile (double q) const noexcept
+    {
+        if (_count == 0)
+            return std::chrono::microseconds{0};
+
+        auto rank = static_cast<std::uint64_t>(q * static_cast<double>(_count));
+        std::uint64_t acc = 0;
+
+        for (std::size_t i = 0; i < bucket_count; i++) {
+            acc += _buckets[i];
+
+            if (acc > rank) {
+                auto bound = static_cast<std::int64_t>(std::uint64_t{1} << i);
+                return (std::min)(std::chrono::microseconds{bound}, max());
+            }
+        }
+
+        return max();
+    }
+};
+
+/**
+ * Traffic counters of the socket or channel.
+ */
+struct traffic_counters
+{
+    std::uint64_t bytes_written {0};
+    std::uint64_t bytes_read {0};
+    std::uint64_t write_calls {0};       // Successful writes to the socket (system calls)
+    std::uint64_t packets_enqueued {0};  // Packets (or coalesced batches) enqueued for writing
+    std::uint64_t messages_sent {0};     // Messages passed to the sender by node::send()
+    std::uint64_t messages_received {0}; // Messages and stream chunks delivered
+    std::uint64_t messages_dropped {0};  // Messages dropped by the overflow policy, undeliverable routed packets
+};
+
+/**
+ * Statistics of the channel with the neighbor node.
+ */
+struct channel_stats: traffic_counters
+{
+    std::uint64_t queue_bytes {0}; // Bytes in the output queue
+    bool congested {false};        // Output queue is above the high water mark
+    std::chrono::microseconds srtt {0};   // Smoothed round-trip time (zero if not measured)
+    std::chrono::microseconds rttvar {0}; // Round-trip time variation
+};
+
+/**
+ * Statistics snapshot of the node (see node::stats()).
+ */
+template <typename NodeId>
+struct node_stats: traffic_counters
+{
+    std::chrono::steady_clock::time_point timestamp;
+
+    // Gauges
+    std::uint64_t queue_bytes {0}; // Bytes in the output queues of all sockets
+    std::size_t channel_count {0}; // Established channels (with writer)
+    std::size_t route_count {0};   // Reachable nodes (including neighbors) if routing is enabled
+
+    // Events
+    std::uint64_t connections {0};         // Established channels
+    std::uint64_t disconnections {0};
+    std::uint64_t reconnections {0};       // Scheduled reconnection attempts
+    std::uint64_t handshake_failures {0};  // Failed or expired handshakes
+    std::uint64_t heartbeat_timeouts {0};
+    std::uint64_t messages_forwarded {0}; // Routed packets forwarded to the next hop
+
+    latency_histogram handshake_duration; // From connection/accepting to the handshake completion
+    latency_histogram queue_delay;        // From enqueue of the message until it is written (sampled)
+
+    std::unordered_map<NodeId, channel_stats> channels;
+};
+
+}} // namespace patterns::meshnet
+
+NETTY__NAMESPACE_END
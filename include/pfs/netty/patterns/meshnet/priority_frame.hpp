@@ -67,6 +67,23 @@ public:
         return _h.size;
     }
 
+    /**
+     * Serialize frame header into buffer (at least header_size() bytes).
+     *
+     * @param out Destination of serialized header.
+     * @param frame_size Frame size including header.
+     */
+    void serialize_header (char * out, std::size_t frame_size)
+    {
+        _h.size = static_cast<std::uint16_t>(frame_size - header_size());
+
+        out[0] = static_cast<char>(_h.b0);
+
+        // `size` in network order
+        out[1] = static_cast<char>(_h.size >> 8);
+        out[2] = static_cast<char>(_h.size & 0x00FF);
+    }
+
     /**
      * Serialize frame header into vector.
      *
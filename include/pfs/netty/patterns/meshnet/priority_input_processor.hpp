@@ -5,9 +5,15 @@
 //
 // Changelog:
 //      2025.01.22 Initial version.
+//      2026.10.17 Input is reassembled by the cursor-based buffers.
+//                 Message payload is passed without copying.
+//                 Stream chunks are passed to the node.
+//                 Route packets and routed data packets are passed to the node.
+//                 Data packets with bad checksum are passed to the node.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "basic_input_processor.hpp"
+#include "input_buffer.hpp"
 #include "priority_frame.hpp"
 #include "protocol.hpp"
 #include <pfs/assert.hpp>
@@ -31,9 +37,9 @@ class priority_input_processor: public basic_input_processor<priority_input_proc
     struct account
     {
         socket_id sid;
-        std::array<std::vector<char>, N> priority_buffers; // Buffers to accumulate raw data
+        std::array<input_buffer, N> priority_buffers; // Buffers to accumulate raw data
         int current_priority {-1};
-        std::vector<char> tmp; // Intermediate buffer
+        input_buffer tmp; // Intermediate buffer
     };
 
 private:
@@ -60,12 +66,12 @@ private:
         return & acc;
     }
 
-    void append_chunk(account & acc, std::vector<char> && chunk)
+    void append_chunk (account & acc, std::vector<char> && chunk)
     {
-        acc.tmp.insert(acc.tmp.end(), chunk.begin(), chunk.end());
+        acc.tmp.append(std::move(chunk));
     }
 
-    std::vector<char> & inpb_ref (account & acc)
+    input_buffer & inpb_ref (account & acc)
     {
         PFS__TERMINATE(acc.current_priority >= 0, "unexpected current_priority value, fix");
         return acc.priority_buffers[acc.current_priority];
@@ -91,8 +97,8 @@ private:
         auto first = acc.tmp.data() + priority_frame::header_size();
         auto frame_size = priority_frame::header_size() + opt_frame->payload_size();
 
-        inpb.insert(inpb.end(), first, first + opt_frame->payload_size());
-        acc.tmp.erase(acc.tmp.begin(), acc.tmp.begin() + frame_size);
+        inpb.append(first, opt_frame->payload_size());
+        acc.tmp.consume(frame_size);
 
         return true;
     }
@@ -125,9 +131,39 @@ public:
         this->_node.heartbeat_processor().process(sid, pkt);
     }
 
-    void process (socket_id sid, std::vector<char> && bytes)
+    void process (socket_id sid, char const * data, std::size_t len)
     {
-        this->_node.process_message_received(sid, std::move(bytes));
+        this->_node.process_message_received(sid, data, len);
+    }
+
+    void process_chunk (socket_id sid, data_packet const & pkt, char const * data, std::size_t len)
+    {
+        this->_node.process_stream_chunk(sid, pkt.stream_id(), pkt.stream_offset(), data, len
+            , pkt.is_last_chunk());
+    }
+
+    void process_corrupted (socket_id sid, data_packet const & pkt)
+    {
+        this->_node.process_corrupted_packet(sid, pkt);
+    }
+
+    void process (socket_id sid, route_packet const & pkt)
+    {
+        this->_node.process_route(sid, pkt);
+    }
+
+    void process_routed (socket_id sid, data_packet const & pkt, char const * data, std::size_t len)
+    {
+        this->_node.process_routed_message(sid, pkt, data, len);
+    }
+
+    /**
+     * @return @c false if the routed packet is addressed to this node.
+     */
+    bool forward (account const & acc, socket_id sid, data_packet const & pkt, char const * packet
+        , std::size_t size)
+    {
+        return this->_node.forward_packet(sid, acc.current_priority, pkt, packet, size);
     }
 };
 
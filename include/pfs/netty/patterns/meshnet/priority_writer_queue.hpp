@@ -6,16 +6,23 @@
 // Changelog:
 //      2025.01.20 Initial version.
 //      2025.02.04 It is a part of patterns::meshnet now.
+//      2026.10.16 Frames are represented by views to queued data now.
+//      2026.10.17 Messages are stored in the chunks of contiguous memory.
+//                 Frames are scheduled by deficit round-robin with runtime byte quanta.
+//                 Added size() and drop_front() per priority.
+//                 Added enqueue of the shared buffers without copying.
+//                 shift() returns the number of payload bytes released.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "priority_frame.hpp"
+#include <pfs/netty/frame_view.hpp>
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/shared_buffer.hpp>
 #include <pfs/assert.hpp>
 #include <algorithm>
 #include <array>
 #include <cstdint>
-#include <list>
-#include <queue>
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -24,8 +31,24 @@ NETTY__NAMESPACE_BEGIN
 namespace patterns {
 namespace meshnet {
 
+/**
+ * Default weights of the priorities: each priority gets twice the share of the next (lower) one.
+ * Weight is the number of full frames (see priority_writer_queue::default_quantum()) sent by
+ * the priority per scheduling round.
+ */
 template <int N>
-struct frame_calculator;
+struct frame_calculator
+{
+    static_assert(N >= 2 && N <= 16, "frame_calculator: number of priorities must be in range [2, 16]");
+
+    std::size_t x[N];
+
+    frame_calculator ()
+    {
+        for (int i = 0; i < N; i++)
+            x[i] = std::size_t{1} << (N - 1 - i);
+    }
+};
 
 // Use `writer_queue` instead of `priority_writer_queue`
 template <> struct frame_calculator<0>;
@@ -61,26 +84,73 @@ struct frame_calculator<6>
     std::size_t x[6] = {32, 16, 8, 4, 2, 1};
 };
 
-template <int N, typename FrameCalculator = frame_calculator<N>>
+/**
+ * Writer queue with priorities.
+ *
+ * Messages of each priority are stored back-to-back in the fixed capacity chunks (@a ChunkSize
+ * bytes), so enqueuing a small message is a single copy without allocation. Messages larger
+ * than half of the chunk get a dedicated chunk (vectors are moved into it, shared buffers are
+ * referenced by it). Chunks are released as a whole when all their data is sent, the last ones
+ * are kept for reuse.
+ *
+ * Frames are scheduled by deficit round-robin: each round a priority (from the highest to the
+ * lowest) may send frames up to its quantum of bytes (headers included), the unused remainder is
+ * carried to the next round while the priority has data to send. So the priorities share the
+ * bandwidth in proportion to their quanta regardless of the message sizes. Quanta are initialized
+ * from the @a FrameCalculator weights and can be changed at runtime by set_quantum().
+ */
+template <int N, typename FrameCalculator = frame_calculator<N>, std::size_t ChunkSize = 16384>
 class priority_writer_queue
 {
-    struct elem
+    static_assert(N >= 2 && N <= 16, "priority_writer_queue: number of priorities must be in range [2, 16]");
+    static_assert(ChunkSize > 0, "priority_writer_queue: chunk size must be greater than zero");
+
+    struct chunk
     {
-        std::vector<char> b;
-        std::size_t cursor;
+        std::vector<char> b; // Capacity is never exceeded, so the data pointer is stable
+        shared_buffer s;     // Used instead of `b` if not empty (dedicated chunk)
+        std::size_t acked;   // Number of bytes already sent
+
+        char const * data () const noexcept
+        {
+            return s.empty() ? b.data() : s.data();
+        }
+
+        std::size_t size () const noexcept
+        {
+            return s.empty() ? b.size() : s.size();
+        }
     };
 
     struct queue
     {
-        std::queue<elem, std::list<elem>> q;
-        int frame_limit;
-        int frame_counter;
+        std::deque<chunk> chunks;
+        std::deque<std::size_t> sizes; // Sizes of the messages not included into frames yet
+        std::size_t next {0};      // Index of the chunk to take next frame from
+        std::size_t cursor {0};    // Position of the first byte not included into a frame yet
+        std::size_t remain {0};    // Bytes of the current message not included into frames yet
+        std::size_t available {0}; // Number of bytes not included into frames yet
+        std::size_t quantum {0};   // Number of bytes the priority may send per round
+        std::size_t deficit {0};   // Number of bytes the priority may send in the current round
+    };
+
+    // Frame prepared for sending. Header is stored here, payload references the chunk data.
+    struct pending_frame
+    {
+        char h[priority_frame::header_size()];
+        char const * payload;
+        std::size_t payload_size;
+        std::size_t cursor; // Number of frame bytes (including header) already sent
+        int priority;
     };
 
 private:
     std::array<queue, N> _qp;      // queue pool
+    std::deque<pending_frame> _pending; // frames prepared for sending (may be partially sent)
+    std::vector<std::vector<char>> _spare; // released chunks for reuse
     int _priority_cursor {0};      // queue pool cursor
-    std::uint64_t _total_size {0}; // total data size
+    bool _granted {false};         // Quantum is granted to the priority under the cursor this round
+    std::uint64_t _total_size {0}; // total size of data not included into frames yet
 
 public:
     priority_writer_queue ()
@@ -89,16 +159,157 @@ public:
 
         for (int i = 0; i < N; i++) {
             PFS__TERMINATE(fc.x[i] > 0, "priority_writer_queue: frame limit must be greater than zero");
-            _qp[i].frame_limit = fc.x[i];
-            _qp[i].frame_counter = fc.x[i];
+            _qp[i].quantum = fc.x[i] * default_quantum();
         }
     }
 
 private:
-    void reset_phase ()
+    void reset_round ()
     {
+        _priority_cursor = 0;
+        _granted = false;
+
         for (int i = 0; i < N; i++)
-            _qp[i].frame_counter = _qp[i].frame_limit;
+            _qp[i].deficit = 0;
+    }
+
+    /**
+     * Finds the queue to take the next frame from (deficit round-robin). Must be called when there
+     * is data not included into frames.
+     *
+     * @param max_payload_size Maximum frame payload size.
+     */
+    int next_priority (std::size_t max_payload_size)
+    {
+        for (;;) {
+            auto & x = _qp[_priority_cursor];
+
+            if (x.available > 0) {
+                if (!_granted) {
+                    x.deficit += x.quantum;
+                    _granted = true;
+                }
+
+                auto payload_size = (std::min)(x.remain > 0 ? x.remain : x.sizes.front(), max_payload_size);
+
+                if (x.deficit >= payload_size + priority_frame::header_size())
+                    return _priority_cursor;
+            } else {
+                // Idle priority does not accumulate the deficit
+                x.deficit = 0;
+            }
+
+            _priority_cursor = (_priority_cursor + 1) % N;
+            _granted = false;
+        }
+    }
+
+    /**
+     * Returns chunk with at least @a len bytes of free capacity at the tail of the queue.
+     */
+    chunk & tail_chunk (queue & x, std::size_t len)
+    {
+        if (!x.chunks.empty()) {
+            auto & last = x.chunks.back();
+
+            if (last.b.capacity() - last.b.size() >= len)
+                return last;
+        }
+
+        std::vector<char> b;
+
+        if (!_spare.empty()) {
+            b = std::move(_spare.back());
+            _spare.pop_back();
+        } else {
+            b.reserve(ChunkSize);
+        }
+
+        x.chunks.push_back(chunk{std::move(b), shared_buffer{}, 0});
+        return x.chunks.back();
+    }
+
+    void release_chunk (std::vector<char> && b)
+    {
+        // Dedicated chunks are not reused
+        if (b.capacity() == ChunkSize && _spare.size() < static_cast<std::size_t>(N)) {
+            b.clear();
+            _spare.push_back(std::move(b));
+        }
+    }
+
+    void push_message (int priority, std::size_t len)
+    {
+        _total_size += len;
+        _qp[priority].available += len;
+        _qp[priority].sizes.push_back(len);
+    }
+
+    void prepare_frame (std::size_t frame_size)
+    {
+        auto priority = next_priority(frame_size - priority_frame::header_size());
+        auto & x = _qp[priority];
+
+        // Take the next message
+        if (x.remain == 0) {
+            x.remain = x.sizes.front();
+            x.sizes.pop_front();
+        }
+
+        // Messages do not cross the chunk boundaries, so skip to the next chunk
+        if (x.cursor == x.chunks[x.next].size()) {
+            x.next++;
+            x.cursor = 0;
+        }
+
+        auto & c = x.chunks[x.next];
+        auto payload_size = (std::min)(x.remain, frame_size - priority_frame::header_size());
+
+        pending_frame f;
+        priority_frame{priority}.serialize_header(f.h, payload_size + priority_frame::header_size());
+        f.payload = c.data() + x.cursor;
+        f.payload_size = payload_size;
+        f.cursor = 0;
+        f.priority = priority;
+        _pending.push_back(f);
+
+        x.cursor += payload_size;
+        x.remain -= payload_size;
+        x.available -= payload_size;
+        x.deficit -= payload_size + priority_frame::header_size();
+        _total_size -= payload_size;
+    }
+
+    /**
+     * Accounts @a n bytes of the front chunk of the queue @a x sent and releases the chunks
+     * which data is sent (or dropped) entirely.
+     */
+    void acknowledge (queue & x, std::size_t n)
+    {
+        x.chunks.front().acked += n;
+
+        while (!x.chunks.empty()) {
+            auto & front = x.chunks.front();
+
+            if (front.acked < front.size())
+                return;
+
+            // The only chunk is sent entirely, reuse it from the beginning
+            if (x.chunks.size() == 1 && front.b.capacity() == ChunkSize) {
+                front.b.clear();
+                front.acked = 0;
+                x.cursor = 0;
+                return;
+            }
+
+            release_chunk(std::move(front.b));
+            x.chunks.pop_front();
+
+            if (x.next > 0)
+                x.next--;
+            else
+                x.cursor = 0; // Released chunk was framed entirely
+        }
     }
 
 public:
@@ -107,8 +318,16 @@ public:
         if (len == 0)
             return;
 
-        _total_size += len;
-        _qp[priority].q.push(elem{std::vector<char>{data, data + len}, 0});
+        auto & x = _qp[priority];
+
+        if (len > ChunkSize / 2) {
+            x.chunks.push_back(chunk{std::vector<char>(data, data + len), shared_buffer{}, 0});
+        } else {
+            auto & c = tail_chunk(x, len);
+            c.b.insert(c.b.end(), data, data + len);
+        }
+
+        push_message(priority, len);
     }
 
     void enqueue (int priority, std::vector<char> && data)
@@ -116,87 +335,164 @@ public:
         if (data.empty())
             return;
 
-        _total_size += data.size();
-        _qp[priority].q.push(elem{std::move(data), 0});
+        // Small messages are copied into the shared chunk
+        if (data.size() <= ChunkSize / 2) {
+            enqueue(priority, data.data(), data.size());
+            return;
+        }
+
+        auto len = data.size();
+        _qp[priority].chunks.push_back(chunk{std::move(data), shared_buffer{}, 0});
+        push_message(priority, len);
+    }
+
+    /**
+     * Enqueues the reference to the @a data (bytes are not copied if the data does not fit into
+     * the shared chunk).
+     */
+    void enqueue (int priority, shared_buffer const & data)
+    {
+        if (data.empty())
+            return;
+
+        if (data.size() <= ChunkSize / 2) {
+            enqueue(priority, data.data(), data.size());
+            return;
+        }
+
+        _qp[priority].chunks.push_back(chunk{std::vector<char>{}, data, 0});
+        push_message(priority, data.size());
     }
 
     bool empty () const
     {
-        return _total_size == 0;
+        return _total_size == 0 && _pending.empty();
     }
 
-    std::vector<char> frame (std::size_t frame_size) const
+    /**
+     * Number of bytes of the @a priority not included into frames yet.
+     */
+    std::size_t size (int priority) const
     {
-        if (empty())
-            return std::vector<char>{};
+        return _qp[priority].available;
+    }
+
+    /**
+     * Drops the oldest message of the @a priority if it is not included into frames yet (even
+     * partially).
+     *
+     * @return Size of the dropped message or zero if there is no message to drop.
+     */
+    std::size_t drop_front (int priority)
+    {
+        auto & x = _qp[priority];
 
-        // _priority_cursor already points to non-empty queue
-        auto & q = _qp[_priority_cursor].q;
-        auto & front = q.front();
-        frame_size = (std::min)(front.b.size() - front.cursor + priority_frame::header_size(), frame_size);
+        if (x.remain > 0 || x.sizes.empty())
+            return 0;
 
-        std::vector<char> chunk;
-        auto first = front.b.data() + front.cursor;
-        priority_frame{_priority_cursor}.serialize(chunk, first, frame_size);
+        auto len = x.sizes.front();
+        x.sizes.pop_front();
 
-        return chunk;
+        // The message is skipped as if it is framed and sent
+        if (x.cursor == x.chunks[x.next].size()) {
+            x.next++;
+            x.cursor = 0;
+        }
+
+        x.cursor += len;
+        x.available -= len;
+        _total_size -= len;
+
+        if (x.next == 0)
+            acknowledge(x, len);
+        else
+            x.chunks[x.next].acked += len; // Released when it becomes the front chunk
+
+        if (empty())
+            reset_round();
+
+        return len;
     }
 
-    void shift (std::size_t frame_size)
+    /**
+     * Fills @a fv with views to at most @a frame_count frames (header and payload) with size not
+     * greater than @a frame_size. Frames already prepared but not completely sent come first.
+     */
+    void frames (std::size_t frame_size, std::size_t frame_count, frame_view & fv)
     {
-        // Actual length to shift
-        auto n = frame_size - priority_frame::header_size();
+        fv.clear();
 
-        _total_size -= n;
-        auto & x = _qp[_priority_cursor];
-        auto & front = x.q.front();
-        front.cursor += n;
+        while (_pending.size() < frame_count && _total_size > 0)
+            prepare_frame(frame_size);
 
-        if (front.cursor >= front.b.size())
-            x.q.pop();
+        for (auto const & f: _pending) {
+            std::size_t header_size = priority_frame::header_size();
 
-        x.frame_counter--;
+            if (f.cursor < header_size) {
+                fv.append(f.h + f.cursor, header_size - f.cursor);
+                fv.append(f.payload, f.payload_size);
+            } else {
+                auto offset = f.cursor - header_size;
+                fv.append(f.payload + offset, f.payload_size - offset);
+            }
+        }
+    }
 
-        // Phase is not complete for the current queue
-        if (x.frame_counter > 0 && !x.q.empty())
-            return;
+    /**
+     * Removes @a n bytes (sent) of the prepared frames.
+     *
+     * @return Number of the payload bytes released (of the frames sent completely), frame headers
+     *         are not included.
+     */
+    std::size_t shift (std::size_t n)
+    {
+        std::size_t released = 0;
 
-        // No more data, reset phase
-        if (_total_size == 0) {
-            _priority_cursor = 0;
-            reset_phase();
-            return;
-        }
+        while (n > 0) {
+            PFS__TERMINATE(!_pending.empty(), "priority_writer_queue: fix shift() method");
 
-        // Phase is complete for the current queue
-        x.frame_counter = 0;
-        _priority_cursor++;
+            auto & f = _pending.front();
+            auto frame_size = f.payload_size + priority_frame::header_size();
+            auto size = (std::min)(frame_size - f.cursor, n);
 
-        // Find nearest suitable queue
-        while (_priority_cursor != N) {
-            x = _qp[_priority_cursor];
+            f.cursor += size;
+            n -= size;
 
-            if (x.frame_counter != 0)
-                return;
+            // Frame is not sent completely
+            if (f.cursor < frame_size)
+                break;
 
-            _priority_cursor++;
+            // Frames of the same priority are sent in order, so the frame belongs to the
+            // front chunk of the queue
+            acknowledge(_qp[f.priority], f.payload_size);
+            released += f.payload_size;
+
+            _pending.pop_front();
         }
 
-        // _priority_cursor == N => Phase is complete totally
-        // Reset phase and find nearest suitable queue
-        _priority_cursor = 0;
-        reset_phase();
+        // No more data, start the new round
+        if (empty())
+            reset_round();
 
-        // A suitable queue must be found since its total size is not zero.
-        for (_priority_cursor = 0; _priority_cursor < N; _priority_cursor++) {
-            x = _qp[_priority_cursor];
+        return released;
+    }
 
-            if (!x.q.empty())
-                return;
-        }
+    /**
+     * Sets the number of bytes (frame headers included) the @a priority may send per scheduling
+     * round. Bandwidth is shared between the busy priorities in proportion to their quanta.
+     */
+    void set_quantum (int priority, std::size_t quantum)
+    {
+        PFS__TERMINATE(priority >= 0 && priority < N, "priority_writer_queue: priority is out of range");
+        PFS__TERMINATE(quantum > 0, "priority_writer_queue: quantum must be greater than zero");
 
-        // Must be unreachable
-        PFS__TERMINATE(false, "priority_writer_queue: fix shift() method");
+        _qp[priority].quantum = quantum;
+    }
+
+    std::size_t quantum (int priority) const
+    {
+        PFS__TERMINATE(priority >= 0 && priority < N, "priority_writer_queue: priority is out of range");
+        return _qp[priority].quantum;
     }
 
 public: // static
@@ -204,6 +500,14 @@ public: // static
     {
         return N;
     }
+
+    /**
+     * Quantum corresponding to the unit weight of the FrameCalculator (default frame size).
+     */
+    static constexpr std::size_t default_quantum () noexcept
+    {
+        return 1500;
+    }
 };
 
 }} // namespace patterns::meshnet
@@ -5,14 +5,24 @@
 //
 // Changelog:
 //      2025.01.17 Initial version.
+//      2026.10.17 Data packet can be deserialized without copying the payload.
+//                 Checksum algorithm is negotiated by handshake (version bits).
+//                 Compression algorithm is negotiated by handshake (byte 1 upper bits).
+//                 Added stream chunks (data packets with stream ID and offset).
+//                 Heartbeat packet can carry timestamps to measure round-trip time.
+//                 Added route packet and routed data packets (source, destination and TTL).
+//                 Node identifiers are sent in the binary form.
+//                 Handshake advertises the support of the binary node identifiers.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <pfs/netty/checksum.hpp>
+#include <pfs/netty/compression.hpp>
 #include <pfs/netty/namespace.hpp>
-#include <pfs/crc32.hpp>
 #include <pfs/numeric_cast.hpp>
 #include <pfs/optional.hpp>
 #include <cstdint>
 #include <cstring>
+#include <string>
 #include <vector>
 
 NETTY__NAMESPACE_BEGIN
@@ -25,6 +35,7 @@ enum class packet_enum
 {
       handshake =  1 /// Handshake phase packet
     , heartbeat =  2 /// Heartbeat loop packet
+    , route     =  3 /// Routing table update (distance vector)
     , data      = 15 /// User data packet
 };
 
@@ -56,16 +67,32 @@ enum class behind_nat_enum
 // |    (V)     |     (P)    |
 // ---------------------------
 // (V) - Packet version (0 - first, 1 - second, etc).
+//       Handshake packet: mask of the supported checksum algorithms in addition to CRC-32
+//       (see checksum_bit()), zero for the peers without checksum negotiation.
+//       Data packet: checksum algorithm (see checksum_enum), zero (CRC-32) for the peers
+//       without checksum negotiation.
 // (P) - Packet type (see packet_enum).
 //
 // Byte 1:
 // ------------------------------
 // | 7  6  5  4 | 3 | 2 | 1 | 0 |
 // ------------------------------
-// | (reserved) | F2| F1| F0| C |
+// |    (Z)     | F2| F1| F0| C |
 // ------------------------------
 // (C) - Checksum bit (0 - no checksum, 1 - has checksum).
-// (F0), (F1), (F2) - free/reserved bits (can be used by some packets)
+// (F0), (F1), (F2) - free/reserved bits (can be used by some packets):
+//       Handshake packet: F0 - response, F1 - behind NAT, F2 - extended protocol is supported
+//       (stream chunks, heartbeat timestamps and routing).
+//       Heartbeat packet: F0 - timestamps follow the health data.
+//       Data packet: F0 - stream chunk (stream ID and offset follow the length of the packet),
+//       F1 - last chunk of the stream, F2 - routed packet (TTL is the last byte of the header,
+//       the body starts with the source and destination node identifiers).
+// (Z) - Handshake packet: mask of the supported compression algorithms (see compression_bit()),
+//       zero for the peers without compression. Bit 3 (not used by the algorithms) - binary node
+//       identifiers are supported: the request always carries the stringified identifier, the
+//       response carries the binary one if both the request and the response have this bit.
+//       Data packet: compression algorithm of the payload (see compression_enum). If nonzero
+//       the length of the uncompressed payload follows the length of the packet.
 
 namespace {
     constexpr std::size_t MIN_HEADER_SIZE = 2;
@@ -79,6 +106,10 @@ protected:
         std::uint8_t b1;
         std::uint32_t crc32;  // Optional if checksum bit is 0
         std::uint32_t length; // Optional if packet is a service type packet (all excluding packet_enum::data)
+        std::uint32_t stream_id;       // Optional if data packet is not a stream chunk
+        std::uint64_t offset;          // Optional if data packet is not a stream chunk
+        std::uint32_t original_length; // Optional if payload is not compressed
+        std::uint8_t ttl;              // Optional if data packet is not routed
     } _h;
 
 protected:
@@ -105,8 +136,18 @@ public:
         if (has_checksum())
             in >> _h.crc32;
 
-        if (type() == packet_enum::data)
+        if (type() == packet_enum::data) {
             in >> _h.length;
+
+            if (is_f0())
+                in >> _h.stream_id >> _h.offset;
+
+            if (zbits() != 0)
+                in >> _h.original_length;
+
+            if (is_f2())
+                in >> _h.ttl;
+        }
     }
 
 public:
@@ -156,6 +197,16 @@ public:
     }
 
 protected:
+    inline std::uint8_t zbits () const noexcept
+    {
+        return static_cast<std::uint8_t>((_h.b1 >> 4) & 0x0F);
+    }
+
+    inline void set_zbits (std::uint8_t value) noexcept
+    {
+        _h.b1 = static_cast<std::uint8_t>((_h.b1 & 0x0F) | ((value & 0x0F) << 4));
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out)
     {
@@ -165,8 +216,18 @@ protected:
         if (_h.b1 & 0x01)
             out << _h.crc32;
 
-        if (static_cast<packet_enum>(_h.b0 & 0x0F) == packet_enum::data)
+        if (static_cast<packet_enum>(_h.b0 & 0x0F) == packet_enum::data) {
             out << _h.length;
+
+            if (is_f0())
+                out << _h.stream_id << _h.offset;
+
+            if (zbits() != 0)
+                out << _h.original_length;
+
+            if (is_f2())
+                out << _h.ttl;
+        }
     }
 };
 
@@ -176,17 +237,22 @@ protected:
 class handshake_packet: public header
 {
 public:
-    std::string id;
+    std::string id; // Node identifier: binary or stringified (see has_binary_id())
 
 public:
     handshake_packet (packet_way_enum way, behind_nat_enum behind_nat = behind_nat_enum::no) noexcept
-        : header(packet_enum::handshake, false, 0)
+        : header(packet_enum::handshake, false, supported_checksums())
     {
         if (way == packet_way_enum::response)
             enable_f0();
 
         if (behind_nat == behind_nat_enum::yes)
             enable_f1();
+
+        set_zbits(supported_compressions() | binary_id_bit());
+
+        // Streams, heartbeat timestamps and routing are supported
+        enable_f2();
     }
 
     /**
@@ -212,6 +278,60 @@ public:
         return is_f1();
     }
 
+    /**
+     * Mask of the checksum algorithms supported by the sender (CRC-32 is always supported).
+     */
+    std::uint8_t checksums () const noexcept
+    {
+        return static_cast<std::uint8_t>(version()) | checksum_bit(checksum_enum::crc32);
+    }
+
+    bool supports_streams () const noexcept
+    {
+        return is_f2();
+    }
+
+    bool supports_heartbeat_timestamps () const noexcept
+    {
+        return is_f2();
+    }
+
+    bool supports_routing () const noexcept
+    {
+        return is_f2();
+    }
+
+    /**
+     * Mask of the compression algorithms supported by the sender.
+     */
+    std::uint8_t compressions () const noexcept
+    {
+        return zbits() & static_cast<std::uint8_t>(~binary_id_bit());
+    }
+
+    /**
+     * Checks if the sender supports the binary node identifiers (peers of the previous versions
+     * send and expect the stringified ones).
+     */
+    bool supports_binary_id () const noexcept
+    {
+        return (zbits() & binary_id_bit()) != 0;
+    }
+
+    /**
+     * Checks if the identifier of this packet is in the binary form.
+     */
+    bool has_binary_id () const noexcept
+    {
+        return is_response() && supports_binary_id();
+    }
+
+public: // static
+    static constexpr std::uint8_t binary_id_bit () noexcept
+    {
+        return 0x08;
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out)
     {
@@ -227,9 +347,19 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class heartbeat_packet: public header
 {
+public:
+    // Value of echo_delay if there is no timestamp to echo
+    static constexpr std::uint32_t no_echo = 0xFFFFFFFF;
+
 public:
     std::uint8_t health_data;
 
+    // Timestamps (if has_timestamps()), microseconds modulo 2^32
+    std::uint32_t timestamp {0};      // Sender time
+    std::uint32_t echo_timestamp {0}; // Last timestamp received from the peer
+    std::uint32_t echo_delay {no_echo}; // Time elapsed since the echo timestamp received
+    std::uint32_t interval {0};       // Heartbeat interval of the sender in milliseconds
+
 public:
     heartbeat_packet () noexcept
         : header(packet_enum::heartbeat, false, 0)
@@ -246,14 +376,91 @@ public:
         : header(h)
     {
         in >> health_data;
+
+        if (has_timestamps())
+            in >> timestamp >> echo_timestamp >> echo_delay >> interval;
     }
 
 public:
+    bool has_timestamps () const noexcept
+    {
+        return is_f0();
+    }
+
+    /**
+     * Adds timestamps to the packet. Must be used only if the peer supports them
+     * (see handshake_packet::supports_heartbeat_timestamps()).
+     */
+    void set_timestamps (std::uint32_t ts, std::uint32_t echo_ts, std::uint32_t delay
+        , std::uint32_t interval_ms) noexcept
+    {
+        enable_f0();
+        timestamp = ts;
+        echo_timestamp = echo_ts;
+        echo_delay = delay;
+        interval = interval_ms;
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out)
     {
         header::serialize(out);
         out << health_data;
+
+        if (has_timestamps())
+            out << timestamp << echo_timestamp << echo_delay << interval;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// route packet
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class route_packet: public header
+{
+public:
+    struct entry
+    {
+        std::string id; // Node identifier (see node_idintifier_traits::encode())
+        std::uint8_t hops;
+    };
+
+public:
+    // Full list of the destinations reachable through the sender (replaces the previous one)
+    std::vector<entry> routes;
+
+public:
+    route_packet () noexcept
+        : header(packet_enum::route, false, 0)
+    {}
+
+    /**
+     * Constructs route packet from deserializer with predefined header.
+     * Header can be read before from the deserializer.
+     */
+    template <typename Deserializer>
+    route_packet (header const & h, Deserializer & in)
+        : header(h)
+    {
+        std::uint16_t count = 0;
+        in >> count;
+
+        routes.resize(count);
+
+        for (auto & r: routes) {
+            std::uint8_t sz = 0;
+            in >> r.hops >> sz >> std::make_pair(& r.id, & sz);
+        }
+    }
+
+public:
+    template <typename Serializer>
+    void serialize (Serializer & out)
+    {
+        header::serialize(out);
+        out << pfs::numeric_cast<std::uint16_t>(routes.size());
+
+        for (auto const & r: routes)
+            out << r.hops << pfs::numeric_cast<std::uint8_t>(r.id.size()) << r.id;
     }
 };
 
@@ -263,12 +470,30 @@ public:
 class data_packet: public header
 {
 public:
-    std::vector<char> bytes;   // used by deserializer only
+    // Tag to deserialize the packet without copying the payload
+    struct view_tag {};
+
+public:
+    std::vector<char> bytes;   // used by deserializer only (body of the packet)
+    char const * payload {nullptr}; // used by view deserializer only (points to deserializer data)
     bool bad_checksum {false}; // used by deserializer only
 
+    // Identifiers of the source and destination nodes of the routed packet (used by view
+    // deserializer only, point to deserializer data)
+    char const * source {nullptr};
+    char const * destination {nullptr};
+    std::uint8_t source_size {0};
+    std::uint8_t destination_size {0};
+
+private:
+    std::size_t _route_size {0}; // Size of the identifiers at the beginning of the body
+
 public:
-    data_packet (bool has_checksum) noexcept
-        : header(packet_enum::data, has_checksum, 0)
+    /**
+     * @param alg Checksum algorithm, must be supported by the receiver (see handshake_packet::checksums()).
+     */
+    data_packet (bool has_checksum, checksum_enum alg = checksum_enum::crc32) noexcept
+        : header(packet_enum::data, has_checksum, has_checksum ? static_cast<int>(alg) : 0)
     {}
 
     template <typename Deserializer>
@@ -283,22 +508,174 @@ public:
             return;
         }
 
-        if (has_checksum()) {
-            auto crc32 = pfs::crc32_of_ptr(bytes.data(), bytes.size());
+        if (has_checksum() && !verify_checksum(bytes.data(), bytes.size())) {
+            bytes.clear();
+            bad_checksum = true;
+        }
+    }
+
+    /**
+     * Constructs packet from deserializer without copying the payload: @a payload points to the
+     * data of the deserializer, so it is valid while the deserialized buffer is alive and unchanged.
+     */
+    template <typename Deserializer>
+    data_packet (header const & h, Deserializer & in, view_tag)
+        : header(h)
+    {
+        in.start_transaction();
+        auto p = in.peek();
+        in.skip(_h.length);
+
+        if (!in.commit_transaction())
+            return;
+
+        if (has_checksum() && !verify_checksum(p, _h.length)) {
+            bad_checksum = true;
+            return;
+        }
+
+        // Malformed routed packets are left without payload
+        if (is_routed()) {
+            std::size_t n = _h.length;
+
+            if (n < 2)
+                return;
+
+            source_size = static_cast<std::uint8_t>(p[0]);
+
+            if (n < std::size_t{2} + source_size)
+                return;
+
+            destination_size = static_cast<std::uint8_t>(p[1 + source_size]);
+            _route_size = std::size_t{2} + source_size + destination_size;
 
-            if (crc32 != _h.crc32) {
-                bytes.clear();
-                bad_checksum = true;
-            }
+            if (n < _route_size)
+                return;
+
+            source = p + 1;
+            destination = p + 2 + source_size;
         }
+
+        payload = p + _route_size;
     }
 
 public:
+    /**
+     * Compression algorithm of the payload.
+     */
+    compression_enum compression () const noexcept
+    {
+        return static_cast<compression_enum>(zbits());
+    }
+
+    /**
+     * Size of the uncompressed payload (valid if compression() is not compression_enum::none).
+     */
+    std::size_t original_size () const noexcept
+    {
+        return static_cast<std::size_t>(_h.original_length);
+    }
+
+    bool is_stream_chunk () const noexcept
+    {
+        return is_f0();
+    }
+
+    bool is_last_chunk () const noexcept
+    {
+        return is_f1();
+    }
+
+    std::uint32_t stream_id () const noexcept
+    {
+        return _h.stream_id;
+    }
+
+    /**
+     * Offset of the chunk in the (uncompressed) stream.
+     */
+    std::uint64_t stream_offset () const noexcept
+    {
+        return _h.offset;
+    }
+
+    bool is_routed () const noexcept
+    {
+        return is_f2();
+    }
+
+    std::uint8_t ttl () const noexcept
+    {
+        return _h.ttl;
+    }
+
+    /**
+     * Pointer to the body of the view deserialized packet (to the route identifiers for the routed
+     * packet), TTL is the byte before it.
+     */
+    char const * body () const noexcept
+    {
+        return payload != nullptr ? payload - _route_size : nullptr;
+    }
+
+    /**
+     * Marks the packet as routed with @a ttl. The body to serialize must start with the route
+     * identifiers (see make_route()).
+     */
+    void set_routed (std::uint8_t ttl) noexcept
+    {
+        enable_f2();
+        _h.ttl = ttl;
+    }
+
+    /**
+     * Appends the route identifiers (the beginning of the body of the routed packet) to @a out.
+     */
+    static void make_route (std::string const & source, std::string const & destination
+        , std::vector<char> & out)
+    {
+        out.push_back(static_cast<char>(pfs::numeric_cast<std::uint8_t>(source.size())));
+        out.insert(out.end(), source.begin(), source.end());
+        out.push_back(static_cast<char>(pfs::numeric_cast<std::uint8_t>(destination.size())));
+        out.insert(out.end(), destination.begin(), destination.end());
+    }
+
+    /**
+     * Marks the packet as the chunk of the stream @a id at @a offset.
+     */
+    void set_stream_chunk (std::uint32_t id, std::uint64_t offset, bool last) noexcept
+    {
+        enable_f0();
+
+        if (last)
+            enable_f1();
+
+        _h.stream_id = id;
+        _h.offset = offset;
+    }
+
+    /**
+     * Marks the payload to serialize as compressed by @a alg from @a original_size bytes.
+     */
+    void set_compression (compression_enum alg, std::size_t original_size)
+    {
+        set_zbits(static_cast<std::uint8_t>(alg));
+        _h.original_length = pfs::numeric_cast<decltype(_h.original_length)>(original_size);
+    }
+
+    /**
+     * Size of the payload referenced by the view deserialized packet.
+     */
+    std::size_t payload_size () const noexcept
+    {
+        return payload != nullptr ? static_cast<std::size_t>(_h.length) - _route_size : 0;
+    }
+
     template <typename Serializer>
     void serialize (Serializer & out, char const * data, std::size_t len)
     {
         if (has_checksum())
-            _h.crc32 = pfs::crc32_of_ptr(data, len);
+            _h.crc32 = checksum(static_cast<checksum_enum>(version()), data, len);
 
         _h.length = pfs::numeric_cast<decltype(_h.length)>(len);
 
@@ -311,6 +688,16 @@ public:
     {
         serialize<Serializer>(out, data.data(), data.size());
     }
+
+private:
+    bool verify_checksum (char const * data, std::size_t len) const noexcept
+    {
+        // Unknown algorithm
+        if (!(checksum_bit(static_cast<checksum_enum>(version())) & supported_checksums()))
+            return false;
+
+        return checksum(static_cast<checksum_enum>(version()), data, len) == _h.crc32;
+    }
 };
 
 }} // namespace patterns::meshnet
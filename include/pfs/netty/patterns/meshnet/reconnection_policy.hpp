@@ -5,26 +5,96 @@
 //
 // Changelog:
 //      2025.01.27 Initial version.
+//      2026.10.17 Exponential backoff with decorrelated jitter per target address.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <pfs/assert.hpp>
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
 
 NETTY__NAMESPACE_BEGIN
 
 namespace patterns {
 namespace meshnet {
 
-struct reconnection_policy
+/**
+ * Reconnection policy: exponential backoff with decorrelated jitter per target address.
+ *
+ * The delay of the first reconnection to the target is a random value in range
+ * [initial, 3 * initial], the delay of each next one is a random value in range
+ * [initial, 3 * previous], limited by the maximum delay. So the delays grow exponentially
+ * while the target is unreachable, and the nodes that lost their connections at the same instant
+ * do not reconnect simultaneously. The delay returns to the initial one when the connection to
+ * the target is established (see reset()).
+ */
+class reconnection_policy
 {
-    static std::chrono::seconds timeout ()
+private:
+    std::chrono::milliseconds _initial {1000};
+    std::chrono::milliseconds _max {30000};
+    std::unordered_map<std::uint64_t, std::chrono::milliseconds> _delays; // Previous delay per target
+    std::mt19937 _rng;
+
+public:
+    reconnection_policy ()
+        : _rng(std::random_device{}())
+    {}
+
+private:
+    static std::uint64_t key (socket4_addr const & saddr) noexcept
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(saddr.addr)) << 16) | saddr.port;
+    }
+
+public:
+    static constexpr bool enabled () noexcept
     {
-        return std::chrono::seconds{5};
+        return true;
+    }
+
+    /**
+     * Sets the @a initial and the @a max delays of the reconnection.
+     */
+    void set_backoff (std::chrono::milliseconds initial, std::chrono::milliseconds max)
+    {
+        PFS__TERMINATE(initial > std::chrono::milliseconds{0} && max >= initial
+            , "reconnection_policy: bad backoff delays");
+
+        _initial = initial;
+        _max = max;
+        _delays.clear();
+    }
+
+    /**
+     * Delay of the next reconnection to the target @a saddr.
+     */
+    std::chrono::milliseconds timeout (socket4_addr const & saddr)
+    {
+        auto & delay = _delays[key(saddr)];
+        auto prev = delay > std::chrono::milliseconds{0} ? delay : _initial;
+        auto upper = (std::min)(prev * 3, _max);
+
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> dist {_initial.count()
+            , (std::max)(upper, _initial).count()};
+
+        delay = std::chrono::milliseconds{dist(_rng)};
+        return delay;
+    }
+
+    /**
+     * Resets the delay of the target @a saddr to the initial one (connection is established).
+     */
+    void reset (socket4_addr const & saddr)
+    {
+        _delays.erase(key(saddr));
     }
 };
 
 }} // namespace patterns::meshnet
 
 NETTY__NAMESPACE_END
-
-
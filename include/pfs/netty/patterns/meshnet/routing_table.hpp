@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/namespace.hpp>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace patterns {
+namespace meshnet {
+
+/**
+ * Distance-vector routing table.
+ *
+ * Each neighbor advertises the full list of the destinations it reaches with the number of hops.
+ * The route to the destination goes through the neighbor with the minimal number of hops (direct
+ * neighbors are reached by one hop). Advertisements exclude the routes through the neighbor they
+ * are sent to (split horizon), and the routes longer than the maximum number of hops are treated
+ * as unreachable, so counting to infinity is bounded.
+ */
+template <typename NodeId>
+class routing_table
+{
+public:
+    using node_id = NodeId;
+
+    struct route
+    {
+        node_id gateway; // Neighbor node to send through
+        unsigned int hops;
+    };
+
+private:
+    node_id _self;
+    unsigned int _max_hops {16};
+
+    // Neighbor -> destinations advertised by it with the number of hops from the neighbor
+    std::unordered_map<node_id, std::unordered_map<node_id, unsigned int>> _advertised;
+
+    // Destinations advertised by the nodes that are not neighbors yet (the channel is not
+    // established completely)
+    std::unordered_map<node_id, std::unordered_map<node_id, unsigned int>> _pending;
+
+    // Best routes (including direct neighbors)
+    std::unordered_map<node_id, route> _routes;
+
+    std::function<void (node_id, unsigned int)> _on_route_changed;
+
+public:
+    routing_table (node_id self)
+        : _self(self)
+    {}
+
+private:
+    // Recalculates the routes, notifies the changes.
+    //
+    // @return @c true if any route changed.
+    bool recalculate ()
+    {
+        std::unordered_map<node_id, route> routes;
+
+        for (auto const & n: _advertised) {
+            routes[n.first] = route{n.first, 1};
+
+            for (auto const & d: n.second) {
+                auto hops = d.second + 1;
+
+                if (d.first == _self || hops > _max_hops || _advertised.count(d.first) > 0)
+                    continue;
+
+                auto pos = routes.find(d.first);
+
+                if (pos == routes.end())
+                    routes.emplace(d.first, route{n.first, hops});
+                else if (hops < pos->second.hops)
+                    pos->second = route{n.first, hops};
+            }
+        }
+
+        bool changed = false;
+
+        for (auto const & r: _routes) {
+            if (routes.find(r.first) == routes.end()) {
+                changed = true;
+
+                if (_on_route_changed)
+                    _on_route_changed(r.first, 0);
+            }
+        }
+
+        for (auto const & r: routes) {
+            auto pos = _routes.find(r.first);
+
+            if (pos == _routes.end() || pos->second.gateway != r.second.gateway
+                    || pos->second.hops != r.second.hops) {
+                changed = true;
+
+                if (_on_route_changed && (pos == _routes.end() || pos->second.hops != r.second.hops))
+                    _on_route_changed(r.first, r.second.hops);
+            }
+        }
+
+        _routes = std::move(routes);
+        return changed;
+    }
+
+public:
+    /**
+     * Sets the maximum number of hops, longer routes are unreachable.
+     */
+    void set_max_hops (unsigned int value) noexcept
+    {
+        _max_hops = value;
+    }
+
+    unsigned int max_hops () const noexcept
+    {
+        return _max_hops;
+    }
+
+    /**
+     * Adds the direct neighbor.
+     *
+     * @return @c true if the routes changed.
+     */
+    bool add_neighbor (node_id id)
+    {
+        if (_advertised.count(id) > 0)
+            return false;
+
+        auto & destinations = _advertised[id];
+        auto pos = _pending.find(id);
+
+        if (pos != _pending.end()) {
+            destinations = std::move(pos->second);
+            _pending.erase(pos);
+        }
+
+        return recalculate();
+    }
+
+    /**
+     * Removes the neighbor and the routes through it.
+     *
+     * @return @c true if the routes changed.
+     */
+    bool remove_neighbor (node_id id)
+    {
+        _pending.erase(id);
+
+        if (_advertised.erase(id) == 0)
+            return false;
+
+        return recalculate();
+    }
+
+    /**
+     * Replaces the destinations advertised by the @a neighbor (kept until it is added if it is
+     * not a neighbor yet).
+     *
+     * @return @c true if the routes changed.
+     */
+    bool update (node_id neighbor, std::vector<std::pair<node_id, unsigned int>> const & destinations)
+    {
+        auto pos = _advertised.find(neighbor);
+
+        // Not a neighbor yet, destinations are applied by add_neighbor()
+        if (pos == _advertised.end()) {
+            auto & pending = _pending[neighbor];
+            pending.clear();
+
+            for (auto const & d: destinations)
+                pending[d.first] = d.second;
+
+            return false;
+        }
+
+        pos->second.clear();
+
+        for (auto const & d: destinations)
+            pos->second[d.first] = d.second;
+
+        return recalculate();
+    }
+
+    /**
+     * Route to the node @a id or @c nullptr if it is unreachable.
+     */
+    route const * find (node_id id) const
+    {
+        auto pos = _routes.find(id);
+        return pos != _routes.end() ? & pos->second : nullptr;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _routes.size();
+    }
+
+    /**
+     * Destinations with the number of hops to advertise to the @a neighbor (split horizon: the
+     * routes through the neighbor and the neighbor itself are excluded).
+     */
+    std::vector<std::pair<node_id, unsigned int>> advertisement (node_id neighbor) const
+    {
+        std::vector<std::pair<node_id, unsigned int>> result;
+        result.reserve(_routes.size());
+
+        for (auto const & r: _routes) {
+            if (r.first != neighbor && r.second.gateway != neighbor)
+                result.emplace_back(r.first, r.second.hops);
+        }
+
+        return result;
+    }
+
+    /**
+     * Direct neighbors.
+     */
+    std::vector<node_id> neighbors () const
+    {
+        std::vector<node_id> result;
+        result.reserve(_advertised.size());
+
+        for (auto const & n: _advertised)
+            result.push_back(n.first);
+
+        return result;
+    }
+
+    /**
+     * Sets the callback called when the route to the node appears, disappears (zero hops) or the
+     * number of hops changes.
+     */
+    template <typename F>
+    routing_table & on_route_changed (F && f)
+    {
+        _on_route_changed = std::forward<F>(f);
+        return *this;
+    }
+};
+
+}} // namespace patterns::meshnet
+
+NETTY__NAMESPACE_END
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/namespace.hpp>
+#include <chrono>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace patterns {
+namespace meshnet {
+
+/**
+ * Smoothed round-trip time and its variation, and retransmission timeout calculated from them
+ * as described in RFC 6298 (section 2).
+ */
+class rtt_estimator
+{
+public:
+    // Clock granularity (G)
+    static constexpr std::chrono::microseconds granularity () noexcept
+    {
+        return std::chrono::microseconds{1000};
+    }
+
+private:
+    std::chrono::microseconds _srtt {0};
+    std::chrono::microseconds _rttvar {0};
+    std::chrono::microseconds _rto {1000000}; // Initial value is 1 second
+    bool _measured {false};
+
+public:
+    /**
+     * Updates estimation by the new measurement @a r.
+     */
+    void add (std::chrono::microseconds r) noexcept
+    {
+        if (!_measured) {
+            _srtt = r;
+            _rttvar = r / 2;
+            _measured = true;
+        } else {
+            auto delta = _srtt > r ? _srtt - r : r - _srtt;
+            _rttvar = (_rttvar * 3 + delta) / 4; // beta = 1/4
+            _srtt = (_srtt * 7 + r) / 8;         // alpha = 1/8
+        }
+
+        auto k_rttvar = _rttvar * 4; // K = 4
+        _rto = _srtt + (k_rttvar > granularity() ? k_rttvar : granularity());
+    }
+
+    /**
+     * Checks if RTT is measured at least once.
+     */
+    bool measured () const noexcept
+    {
+        return _measured;
+    }
+
+    std::chrono::microseconds srtt () const noexcept
+    {
+        return _srtt;
+    }
+
+    std::chrono::microseconds rttvar () const noexcept
+    {
+        return _rttvar;
+    }
+
+    /**
+     * Retransmission timeout: SRTT + max(G, 4 * RTTVAR), 1 second until RTT measured.
+     * Bounds are applied by the user.
+     */
+    std::chrono::microseconds rto () const noexcept
+    {
+        return _rto;
+    }
+};
+
+}} // namespace patterns::meshnet
+
+NETTY__NAMESPACE_END
@@ -0,0 +1,517 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+//      2026.10.17 Messages are submitted through node's enqueue() that wakes up the shard.
+//                 Added set_priority_quanta(), set_coalescing() and set_compression().
+//                 Forwards on_message_view callback.
+//                 Forwards on_stream_chunk and on_stream_failed callbacks, added set_stream_limits().
+//                 Forwards congestion callbacks, added set_water_marks() and set_overflow_policy().
+//                 Forwards on_stats callback, added set_stats_interval().
+//                 Added set_heartbeat_interval() and set_heartbeat_timeout().
+//                 Added set_reconnection_backoff() and set_connection_limits().
+//                 Connection limits are split between the shards without exceeding the total.
+//                 Forwards on_stream_broken callback.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/assert.hpp>
+#include <pfs/netty/compression.hpp>
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/inet4_addr.hpp>
+#include <pfs/netty/mpsc_queue.hpp>
+#include <pfs/netty/namespace.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <pfs/netty/writer_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace patterns {
+namespace meshnet {
+
+/**
+ * Meshnet node that runs several event loops (shards) in separate threads.
+ *
+ * Each shard is a complete @c Node instance (with its own pollers, reader/writer and socket pools)
+ * that serves a subset of the sockets. Listeners belong to the first shard, accepted sockets
+ * are distributed across the shards in round-robin fashion. Outgoing connections are distributed
+ * the same way.
+ *
+ * Messages to send are passed to the shard that owns the channel with the destination node
+ * through the lock-free queue (see node::enqueue()). The owner shard is found by the routing index,
+ * that is replaced entirely on each channel state change (copy-on-write), so the senders do not lock
+ * anything.
+ *
+ * Requirements:
+ *   - the Node must use `functional_callbacks` (or compatible callback suite);
+ *   - the reader and the writer of a channel must be represented by the same socket
+ *     (e.g. `exclusive_handshake`), so the channel is served by a single shard entirely.
+ *
+ * Callbacks are called from the shard threads.
+ */
+template <typename Node>
+class sharded_node
+{
+public:
+    using node_type = Node;
+    using node_id = typename Node::node_id;
+    using callback_suite = typename Node::callback_suite;
+
+private:
+    using socket_type = typename Node::socket_type;
+
+    struct shard
+    {
+        std::unique_ptr<node_type> node;
+        mpsc_queue<socket_type> accepted;
+        mpsc_queue<std::function<void(node_type &)>> commands;
+        std::thread thread;
+    };
+
+    // Node identifier -> shards that own the channels with the node (the first one is used to send)
+    using routing_index = std::unordered_map<node_id, std::vector<std::size_t>>;
+
+private:
+    node_id _id;
+    callback_suite _callbacks;
+    std::vector<std::unique_ptr<shard>> _shards;
+
+    std::shared_ptr<routing_index const> _index;
+    std::mutex _index_mtx; // Serializes the index modifications
+
+    std::size_t _next_accepted {0}; // Accessed by the first shard only
+    std::atomic<std::size_t> _next_connecting {0};
+    std::atomic<bool> _running {false};
+
+public:
+    /**
+     * Constructs sharded node.
+     *
+     * @param shard_count Number of the shards (event loops), the number of hardware threads is
+     *        used if @a shard_count is zero.
+     */
+    sharded_node (node_id id, bool behind_nat, callback_suite && callbacks, std::size_t shard_count = 0)
+        : _id(id)
+        , _callbacks(std::move(callbacks))
+        , _index(std::make_shared<routing_index>())
+    {
+        if (shard_count == 0)
+            shard_count = (std::max)(1u, std::thread::hardware_concurrency());
+
+        _shards.reserve(shard_count);
+
+        for (std::size_t i = 0; i < shard_count; i++) {
+            callback_suite shard_callbacks;
+
+            shard_callbacks.on_node_connected = [this, i] (node_id id) {
+                if (index_add(id, i))
+                    _callbacks.on_node_connected(id);
+            };
+
+            shard_callbacks.on_node_disconnected = [this, i] (node_id id) {
+                if (index_remove(id, i))
+                    _callbacks.on_node_disconnected(id);
+            };
+
+            shard_callbacks.on_message_received = [this] (node_id id, std::vector<char> && bytes) {
+                _callbacks.on_message_received(id, std::move(bytes));
+            };
+
+            if (_callbacks.on_message_view) {
+                shard_callbacks.on_message_view = [this] (node_id id, char const * data, std::size_t len) {
+                    _callbacks.on_message_view(id, data, len);
+                };
+            }
+
+            if (_callbacks.on_node_congested) {
+                shard_callbacks.on_node_congested = [this] (node_id id) {
+                    _callbacks.on_node_congested(id);
+                };
+            }
+
+            if (_callbacks.on_node_drained) {
+                shard_callbacks.on_node_drained = [this] (node_id id) {
+                    _callbacks.on_node_drained(id);
+                };
+            }
+
+            if (_callbacks.on_stream_chunk) {
+                shard_callbacks.on_stream_chunk = [this] (node_id id, std::uint32_t stream_id
+                        , std::uint64_t offset, char const * data, std::size_t len, bool last) {
+                    _callbacks.on_stream_chunk(id, stream_id, offset, data, len, last);
+                };
+            }
+
+            if (_callbacks.on_stream_failed) {
+                shard_callbacks.on_stream_failed = [this] (node_id id, std::uint32_t stream_id) {
+                    _callbacks.on_stream_failed(id, stream_id);
+                };
+            }
+
+            if (_callbacks.on_stream_broken) {
+                shard_callbacks.on_stream_broken = [this] (node_id id, std::uint32_t stream_id) {
+                    _callbacks.on_stream_broken(id, stream_id);
+                };
+            }
+
+            if (_callbacks.on_stats) {
+                shard_callbacks.on_stats = [this] (typename node_type::stats_type const & stats) {
+                    _callbacks.on_stats(stats);
+                };
+            }
+
+            std::unique_ptr<shard> sh {new shard};
+            sh->node.reset(new node_type(id, behind_nat, std::move(shard_callbacks)));
+            _shards.push_back(std::move(sh));
+        }
+
+        if (shard_count > 1) {
+            _shards[0]->node->dispatch_accepted([this] (socket_type && sock) {
+                auto index = _next_accepted++ % _shards.size();
+
+                if (index == 0) {
+                    _shards[0]->node->adopt_accepted(std::move(sock));
+                } else {
+                    _shards[index]->accepted.push(std::move(sock));
+                    _shards[index]->node->wakeup();
+                }
+            });
+        }
+    }
+
+    ~sharded_node ()
+    {
+        stop();
+    }
+
+    sharded_node (sharded_node const &) = delete;
+    sharded_node & operator = (sharded_node const &) = delete;
+
+public:
+    node_id id () const noexcept
+    {
+        return _id;
+    }
+
+    std::size_t shard_count () const noexcept
+    {
+        return _shards.size();
+    }
+
+    /**
+     * Adds listener. Must be called before run().
+     */
+    void add_listener (netty::socket4_addr const & listener_addr, error * perr = nullptr)
+    {
+        _shards[0]->node->add_listener(listener_addr, perr);
+    }
+
+    /**
+     * Starts listening. Must be called before run().
+     */
+    void listen (int backlog = 50)
+    {
+        _shards[0]->node->listen(backlog);
+    }
+
+    /**
+     * Sets the bandwidth shares of the priorities for all channels (see node::set_priority_quanta()).
+     * Must be called before run().
+     */
+    void set_priority_quanta (std::vector<std::size_t> const & quanta)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_priority_quanta(quanta);
+    }
+
+    /**
+     * Enables coalescing of the small messages of @a priority (see node::set_coalescing()).
+     * Must be called before run().
+     */
+    void set_coalescing (int priority, std::size_t threshold
+        , std::chrono::microseconds latency = std::chrono::microseconds{0})
+    {
+        for (auto & sh: _shards)
+            sh->node->set_coalescing(priority, threshold, latency);
+    }
+
+    /**
+     * Enables compression of the messages of @a priority (see node::set_compression()).
+     * Must be called before run().
+     */
+    void set_compression (int priority, compression_enum alg, std::size_t threshold = 0)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_compression(priority, alg, threshold);
+    }
+
+    /**
+     * Sets the water marks of the output queues (see node::set_water_marks()).
+     * Must be called before run().
+     */
+    void set_water_marks (std::uint64_t high_mark, std::uint64_t low_mark)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_water_marks(high_mark, low_mark);
+    }
+
+    /**
+     * Limits the output queues of the @a priority (see node::set_overflow_policy()).
+     * Must be called before run().
+     */
+    void set_overflow_policy (int priority, std::size_t limit, overflow_policy_enum policy)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_overflow_policy(priority, limit, policy);
+    }
+
+    /**
+     * Sets the stream limits (see node::set_stream_limits()). Must be called before run().
+     */
+    void set_stream_limits (std::size_t chunk_size, std::size_t window)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_stream_limits(chunk_size, window);
+    }
+
+    /**
+     * Sets the heartbeat interval (see node::set_heartbeat_interval()). Must be called before run().
+     */
+    void set_heartbeat_interval (std::chrono::milliseconds interval)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_heartbeat_interval(interval);
+    }
+
+    /**
+     * Sets the heartbeat expiration timeouts (see node::set_heartbeat_timeout()).
+     * Must be called before run().
+     */
+    void set_heartbeat_timeout (std::chrono::milliseconds timeout, std::chrono::milliseconds min_timeout)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_heartbeat_timeout(timeout, min_timeout);
+    }
+
+    /**
+     * Sets the reconnection delays (see node::set_reconnection_backoff()).
+     * Must be called before run().
+     */
+    void set_reconnection_backoff (std::chrono::milliseconds initial, std::chrono::milliseconds max)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_reconnection_backoff(initial, max);
+    }
+
+    /**
+     * Limits the reconnections of the whole node (see node::set_connection_limits()): the limits
+     * are shared by the shards, so their sum does not exceed the node-wide ones. Nonzero
+     * @a max_in_flight must not be less than the number of shards. Must be called before run().
+     */
+    void set_connection_limits (std::size_t max_in_flight, double per_second)
+    {
+        auto n = _shards.size();
+
+        // Zero value of the shard would disable its limit
+        PFS__TERMINATE(max_in_flight == 0 || max_in_flight >= n
+            , "sharded_node: max in flight connections is less than the number of shards");
+
+        for (std::size_t i = 0; i < n; i++) {
+            // Remainder is distributed one by one to the first shards
+            auto shard_in_flight = max_in_flight / n + (i < max_in_flight % n ? 1 : 0);
+            _shards[i]->node->set_connection_limits(shard_in_flight, per_second / static_cast<double>(n));
+        }
+    }
+
+    /**
+     * Enables periodic reporting of the statistics (see node::set_stats_interval()). Each shard
+     * reports its own statistics from its thread. Must be called before run().
+     */
+    void set_stats_interval (std::chrono::milliseconds interval)
+    {
+        for (auto & sh: _shards)
+            sh->node->set_stats_interval(interval);
+    }
+
+    /**
+     * Initiates connection to the remote host by the next shard. Connection failures are reported
+     * by the shard node.
+     */
+    void connect_host (netty::socket4_addr remote_saddr)
+    {
+        auto index = _next_connecting.fetch_add(1, std::memory_order_relaxed) % _shards.size();
+
+        _shards[index]->commands.push([remote_saddr] (node_type & n) {
+            n.connect_host(remote_saddr);
+        });
+
+        _shards[index]->node->wakeup();
+    }
+
+    void connect_host (netty::socket4_addr remote_saddr, netty::inet4_addr local_addr)
+    {
+        auto index = _next_connecting.fetch_add(1, std::memory_order_relaxed) % _shards.size();
+
+        _shards[index]->commands.push([remote_saddr, local_addr] (node_type & n) {
+            n.connect_host(remote_saddr, local_addr);
+        });
+
+        _shards[index]->node->wakeup();
+    }
+
+    /**
+     * Passes the message to the shard that serves the channel with the node @a id.
+     * Can be called from any thread.
+     *
+     * @return @c false if the channel with the node @a id is not established. The message is
+     *         enqueued by the shard asynchronously, so its rejection by the overflow policy is
+     *         reported by the statistics only (see traffic_counters::messages_dropped).
+     */
+    bool send (node_id id, int priority, bool force_checksum, std::vector<char> && data)
+    {
+        auto index = std::atomic_load(& _index);
+        auto pos = index->find(id);
+
+        if (pos == index->end())
+            return false;
+
+        _shards[pos->second.front()]->node->enqueue(id, priority, force_checksum, std::move(data));
+
+        return true;
+    }
+
+    bool send (node_id id, int priority, bool force_checksum, char const * data, std::size_t len)
+    {
+        return this->send(id, priority, force_checksum, std::vector<char>(data, data + len));
+    }
+
+    bool send (node_id id, int priority, char const * data, std::size_t len)
+    {
+        return this->send(id, priority, false, data, len);
+    }
+
+    bool send (node_id id, int priority, std::vector<char> && data)
+    {
+        return this->send(id, priority, false, std::move(data));
+    }
+
+    /**
+     * Starts the shard threads.
+     *
+     * @param step_interval Time limit for the single step of the shard event loop.
+     */
+    void run (std::chrono::milliseconds step_interval = std::chrono::milliseconds{10})
+    {
+        if (_running.exchange(true))
+            return;
+
+        for (auto & sh: _shards) {
+            auto psh = sh.get();
+
+            psh->thread = std::thread {[this, psh, step_interval] {
+                while (_running.load(std::memory_order_relaxed)) {
+                    process_queues(*psh);
+                    psh->node->step(step_interval);
+                }
+            }};
+        }
+    }
+
+    /**
+     * Stops the shard threads and waits for their completion.
+     */
+    void stop ()
+    {
+        if (!_running.exchange(false))
+            return;
+
+        for (auto & sh: _shards) {
+            if (sh->thread.joinable())
+                sh->thread.join();
+        }
+    }
+
+public: // static
+    static constexpr int priority_count () noexcept
+    {
+        return node_type::priority_count();
+    }
+
+private:
+    void process_queues (shard & sh)
+    {
+        std::function<void(node_type &)> command;
+
+        while (sh.commands.try_pop(command))
+            command(*sh.node);
+
+        socket_type sock;
+
+        while (sh.accepted.try_pop(sock))
+            sh.node->adopt_accepted(std::move(sock));
+    }
+
+    /**
+     * Registers channel with node @a id served by shard @a index.
+     *
+     * @return @c true if it is the first channel with the node.
+     */
+    bool index_add (node_id id, std::size_t index)
+    {
+        std::lock_guard<std::mutex> locker(_index_mtx);
+
+        auto new_index = std::make_shared<routing_index>(*_index);
+        auto & shards = (*new_index)[id];
+        auto first = shards.empty();
+
+        if (std::find(shards.begin(), shards.end(), index) == shards.end())
+            shards.push_back(index);
+
+        std::atomic_store(& _index, std::shared_ptr<routing_index const>(std::move(new_index)));
+        return first;
+    }
+
+    /**
+     * Unregisters channel with node @a id served by shard @a index.
+     *
+     * @return @c true if there are no more channels with the node.
+     */
+    bool index_remove (node_id id, std::size_t index)
+    {
+        std::lock_guard<std::mutex> locker(_index_mtx);
+
+        auto pos = _index->find(id);
+
+        if (pos == _index->end())
+            return false;
+
+        auto new_index = std::make_shared<routing_index>(*_index);
+        auto & shards = (*new_index)[id];
+        shards.erase(std::remove(shards.begin(), shards.end(), index), shards.end());
+
+        auto last = shards.empty();
+
+        if (last)
+            new_index->erase(id);
+
+        std::atomic_store(& _index, std::shared_ptr<routing_index const>(std::move(new_index)));
+        return last;
+    }
+};
+
+}} // namespace patterns::meshnet
+
+NETTY__NAMESPACE_END
@@ -5,55 +5,61 @@
 //
 // Changelog:
 //      2025.01.17 Initial version.
+//      2026.10.17 Heartbeats and their expiration are scheduled by the node timing wheel.
+//                 Round-trip time is measured by the heartbeat timestamps, expiration timeout
+//                 adapts to it.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "protocol.hpp"
+#include "rtt_estimator.hpp"
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/timing_wheel.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <functional>
-#include <set>
 #include <unordered_map>
-#include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
 namespace patterns {
 namespace meshnet {
 
+/**
+ * Heartbeat processor.
+ *
+ * If the peer supports heartbeat timestamps (negotiated by handshake) each heartbeat carries
+ * the send time and echoes the last timestamp received from the peer, so the round-trip time
+ * of the link is measured. Once measured, the heartbeat expiration timeout adapts to it:
+ * two peer heartbeat intervals (one heartbeat may be lost) plus RFC 6298 retransmission timeout,
+ * bounded by the minimum and the maximum (fixed) timeouts. The fixed timeout is used until then.
+ */
 template <typename Node>
 class simple_heartbeat
 {
     using socket_id = typename Node::socket_id;
     using serializer_traits = typename Node::serializer_traits;
-    using time_point_type = std::chrono::steady_clock::time_point;
+    using clock_type = std::chrono::steady_clock;
 
     struct heartbeat_item
     {
-        time_point_type t;
-        socket_id sid;
+        timing_wheel::timer_id heartbeat {0}; // Timer to send the next heartbeat
+        timing_wheel::timer_id limit {0};     // Timer of the heartbeat expiration
+
+        bool timestamps {false}; // Peer supports timestamps
+        bool has_echo {false};   // Peer timestamp is received and not echoed yet
+        std::uint32_t peer_timestamp {0};
+        clock_type::time_point peer_timestamp_time;
+        std::chrono::milliseconds peer_interval {0};
+        rtt_estimator rtt;
     };
 
-    // Sort by ascending order
-    friend constexpr bool operator < (heartbeat_item const & lhs, heartbeat_item const & rhs)
-    {
-        return lhs.t < rhs.t;
-    }
-
-    // // Sort by descending order
-    // friend constexpr bool operator < (timelimit_item const & lhs, timelimit_item const & rhs)
-    // {
-    //     return lhs.t > rhs.t;
-    // }
-
 private:
     Node & _node;
-    std::chrono::seconds _interval {5};
-    std::chrono::seconds _timeout {15};
-    std::set<heartbeat_item> _q;
-    std::vector<socket_id> _tmp;
-
-    // TODO May be not optimized for large number of sockets
-    std::unordered_map<socket_id, time_point_type> _limits;
+    std::chrono::milliseconds _interval {5000};
+    std::chrono::milliseconds _timeout {15000};   // Fixed and maximum expiration timeout
+    std::chrono::milliseconds _min_timeout {200}; // Minimum adaptive expiration timeout
+    std::unordered_map<socket_id, heartbeat_item> _items;
 
     std::function<void (socket_id)> _on_expired = [] (socket_id) {};
 
@@ -64,83 +70,153 @@ public:
     {}
 
 private:
+    // Microseconds modulo 2^32
+    static std::uint32_t timestamp (clock_type::time_point t) noexcept
+    {
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            t.time_since_epoch()).count());
+    }
+
     void enqueue (socket_id sid)
     {
-        _q.insert(heartbeat_item{std::chrono::steady_clock::now() + _interval, sid});
+        _items[sid].heartbeat = _node.timers().start(_interval, [this, sid] () {
+            auto out = serializer_traits::make_serializer();
+            heartbeat_packet pkt;
+            auto & item = _items[sid];
+
+            if (item.timestamps) {
+                auto now = clock_type::now();
+                auto delay = item.has_echo
+                    ? timestamp(now) - timestamp(item.peer_timestamp_time)
+                    : heartbeat_packet::no_echo;
+
+                pkt.set_timestamps(timestamp(now), item.peer_timestamp, delay
+                    , static_cast<std::uint32_t>(_interval.count()));
+
+                item.has_echo = false;
+            }
+
+            pkt.serialize(out);
+
+            _node.send_private(sid, 0, out.data(), out.size());
+            enqueue(sid);
+        });
+    }
+
+    std::chrono::milliseconds expiration_timeout (heartbeat_item const & item) const
+    {
+        if (!item.rtt.measured() || item.peer_interval.count() == 0)
+            return _timeout;
+
+        // Rounded up to milliseconds
+        auto rto = std::chrono::duration_cast<std::chrono::milliseconds>(item.rtt.rto()
+            + std::chrono::microseconds{999});
+
+        auto timeout = item.peer_interval * 2 + rto;
+        return (std::min)((std::max)(timeout, _min_timeout), _timeout);
     }
 
 public:
-    void add (socket_id sid)
+    /**
+     * Sets the interval of sending the heartbeats. Applied to the heartbeats scheduled after the
+     * current ones.
+     */
+    void set_interval (std::chrono::milliseconds interval)
     {
-        remove(sid);
-        enqueue(sid);
+        _interval = interval;
     }
 
-    void remove (socket_id sid)
+    /**
+     * Sets the fixed expiration @a timeout (used until RTT is measured and for the peers without
+     * timestamps support), that is the upper bound of the adaptive timeout too, and the lower bound
+     * @a min_timeout of the adaptive timeout.
+     */
+    void set_timeout (std::chrono::milliseconds timeout, std::chrono::milliseconds min_timeout)
     {
-        for (auto pos = _q.begin(); pos != _q.end();) {
-            if (pos->sid == sid)
-                pos = _q.erase(pos);
-            else
-                ++pos;
-        }
+        _timeout = timeout;
+        _min_timeout = min_timeout;
+    }
 
-        _limits.erase(sid);
+    /**
+     * Enables heartbeat timestamps for the socket @a sid if the peer supports them.
+     */
+    template <typename HandshakePacket>
+    void negotiate (socket_id sid, HandshakePacket const & pkt)
+    {
+        _items[sid].timestamps = pkt.supports_heartbeat_timestamps();
     }
 
-    void process (socket_id sid, heartbeat_packet const & /*pkt*/)
+    void add (socket_id sid)
     {
-        LOGD("[meshnet]", "heartbeat: {}", sid);
-        _limits[sid] = std::chrono::steady_clock::now() + _timeout;
+        auto & item = _items[sid];
+        _node.timers().cancel(item.heartbeat);
+        _node.timers().cancel(item.limit);
+        enqueue(sid);
     }
 
-    template <typename F>
-    simple_heartbeat & on_expired (F && f)
+    void remove (socket_id sid)
     {
-        _on_expired = std::forward<F>(f);
-        return *this;
+        auto pos = _items.find(sid);
+
+        if (pos != _items.end()) {
+            _node.timers().cancel(pos->second.heartbeat);
+            _node.timers().cancel(pos->second.limit);
+            _items.erase(pos);
+        }
     }
 
-    void step ()
+    /**
+     * RTT estimation of the socket @a sid or @c nullptr if the socket is not found.
+     */
+    rtt_estimator const * rtt (socket_id sid) const
     {
-        if (!_q.empty()) {
-            auto now = std::chrono::steady_clock::now();
-            auto pos = _q.begin();
+        auto pos = _items.find(sid);
+        return pos != _items.end() ? & pos->second.rtt : nullptr;
+    }
 
-            auto out = serializer_traits::make_serializer();
-            heartbeat_packet pkt;
-            pkt.serialize(out);
+    void process (socket_id sid, heartbeat_packet const & pkt)
+    {
+        LOGD("[meshnet]", "heartbeat: {}", sid);
 
-            _tmp.clear();
+        auto & item = _items[sid];
 
-            while (!_q.empty() && pos->t <= now) {
-                _node.send_private(pos->sid, 0, out.data(), out.size());
-                auto sid = pos->sid;
-                pos = _q.erase(pos);
-                _tmp.push_back(sid);
-            }
+        if (pkt.has_timestamps()) {
+            auto now = clock_type::now();
 
-            for (auto sid: _tmp)
-                enqueue(sid);
+            item.has_echo = true;
+            item.peer_timestamp = pkt.timestamp;
+            item.peer_timestamp_time = now;
+            item.peer_interval = std::chrono::milliseconds{pkt.interval};
 
-            _tmp.clear();
-        }
+            if (pkt.echo_delay != heartbeat_packet::no_echo) {
+                auto r = static_cast<std::uint32_t>(timestamp(now) - pkt.echo_timestamp - pkt.echo_delay);
 
-        if (!_limits.empty()) {
-            auto now = std::chrono::steady_clock::now();
-
-            for (auto pos = _limits.begin(); pos != _limits.end();) {
-                if (pos->second <= now) {
-                    auto sid = pos->first;
-                    pos = _limits.erase(pos);
-                    remove(sid);
-                    _on_expired(sid);
-                } else {
-                    ++pos;
-                }
+                // Negative value (e.g. corrupted timestamps) is ignored
+                if (r < 0x80000000u)
+                    item.rtt.add(std::chrono::microseconds{r});
             }
         }
+
+        _node.timers().cancel(item.limit);
+
+        item.limit = _node.timers().start(expiration_timeout(item), [this, sid] () {
+            remove(sid);
+            _on_expired(sid);
+        });
+    }
+
+    template <typename F>
+    simple_heartbeat & on_expired (F && f)
+    {
+        _on_expired = std::forward<F>(f);
+        return *this;
     }
+
+    /**
+     * Heartbeats and their expiration are processed by the node timers, nothing to do here.
+     */
+    void step ()
+    {}
 };
 
 }} // namespace patterns::meshnet
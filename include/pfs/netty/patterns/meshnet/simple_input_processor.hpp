@@ -5,15 +5,21 @@
 //
 // Changelog:
 //      2025.02.05 Initial version.
+//      2026.10.17 Input is accumulated by the cursor-based buffer.
+//                 Message payload is passed without copying.
+//                 Stream chunks are passed to the node.
+//                 Route packets and routed data packets are passed to the node.
+//                 Data packets with bad checksum are passed to the node.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "basic_input_processor.hpp"
+#include "input_buffer.hpp"
 // #include "protocol.hpp"
 #include <pfs/assert.hpp>
 // #include <pfs/utility.hpp>
 // #include <pfs/netty/namespace.hpp>
 // #include <cstring>
-// #include <unordered_map>
+#include <unordered_map>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -31,7 +37,7 @@ class simple_input_processor: public basic_input_processor<simple_input_processo
     struct account
     {
         socket_id sid;
-        std::vector<char> b; // Buffer to accumulate raw data
+        input_buffer b; // Buffer to accumulate raw data
     };
 
 private:
@@ -63,11 +69,11 @@ private:
 
     void append_chunk (account & acc, std::vector<char> && chunk)
     {
-        acc.b.insert(acc.b.end(), chunk.begin(), chunk.end());
+        acc.b.append(std::move(chunk));
         _frame_ready = true;
     }
 
-    std::vector<char> & inpb_ref (account & acc)
+    input_buffer & inpb_ref (account & acc)
     {
         return acc.b;
     }
@@ -108,9 +114,39 @@ public:
         this->_node.heartbeat_processor().process(sid, pkt);
     }
 
-    void process (socket_id sid, std::vector<char> && bytes)
+    void process (socket_id sid, char const * data, std::size_t len)
     {
-        this->_node.process_message_received(sid, std::move(bytes));
+        this->_node.process_message_received(sid, data, len);
+    }
+
+    void process_chunk (socket_id sid, data_packet const & pkt, char const * data, std::size_t len)
+    {
+        this->_node.process_stream_chunk(sid, pkt.stream_id(), pkt.stream_offset(), data, len
+            , pkt.is_last_chunk());
+    }
+
+    void process_corrupted (socket_id sid, data_packet const & pkt)
+    {
+        this->_node.process_corrupted_packet(sid, pkt);
+    }
+
+    void process (socket_id sid, route_packet const & pkt)
+    {
+        this->_node.process_route(sid, pkt);
+    }
+
+    void process_routed (socket_id sid, data_packet const & pkt, char const * data, std::size_t len)
+    {
+        this->_node.process_routed_message(sid, pkt, data, len);
+    }
+
+    /**
+     * @return @c false if the routed packet is addressed to this node.
+     */
+    bool forward (account const &, socket_id sid, data_packet const & pkt, char const * packet
+        , std::size_t size)
+    {
+        return this->_node.forward_packet(sid, 0, pkt, packet, size);
     }
 };
 
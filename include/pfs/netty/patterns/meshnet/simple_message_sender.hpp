@@ -5,10 +5,30 @@
 //
 // Changelog:
 //      2025.02.10 Initial version.
+//      2026.10.17 Checksum algorithm is chosen per socket by handshake.
+//                 Added optional coalescing of small messages.
+//                 Added optional compression of messages (negotiated by handshake).
+//                 Added streams: chunks are pulled from the producer within the output window.
+//                 Added routed messages.
+//                 Added broadcast of the shared packets.
+//                 Stream fails if its chunk is rejected by the output queue, chunks are not
+//                 coalesced.
+//                 send() reports the message rejected by the output queue.
+//                 Routed messages are not compressed.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "protocol.hpp"
+#include <pfs/assert.hpp>
+#include <pfs/netty/checksum.hpp>
+#include <pfs/netty/compression.hpp>
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/shared_buffer.hpp>
+#include <pfs/netty/timing_wheel.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 NETTY__NAMESPACE_BEGIN
@@ -16,35 +36,561 @@ NETTY__NAMESPACE_BEGIN
 namespace patterns {
 namespace meshnet {
 
+/**
+ * Message sender.
+ *
+ * Optionally coalesces small messages (see set_coalescing()): consecutive messages for the same
+ * socket and priority are packed into a single buffer and enqueued for writing as a whole (so they
+ * are sent by a single frame). The buffer is flushed when it reaches the size threshold, when the
+ * latency budget of the priority expires, or by flush().
+ *
+ * Optionally compresses messages (see set_compression()) by the algorithm chosen for the priority
+ * if the peer supports it (see handshake_packet::compressions()). Routed messages are not
+ * compressed.
+ *
+ * Streams (see send_stream()) are sent by chunks pulled from the producer while the output queue
+ * of the socket is smaller than the stream window, so the memory used by a stream is bounded
+ * whatever its size. Chunks are regular data packets, so they interleave with other messages
+ * according to the priority. Chunks are not coalesced, and the stream fails (see
+ * Node::fail_stream()) if its chunk is rejected by the output queue, so the receiver never gets
+ * the stream with a gap completed by the last chunk.
+ */
 template <typename Node>
 class simple_message_sender
 {
     using socket_id = typename Node::socket_id;
     using serializer_traits = typename Node::serializer_traits;
 
+public:
+    /**
+     * Stream producer: appends the next chunk (not larger than @a max_size bytes) to @a chunk and
+     * returns @c false if it is the last one. Empty @a chunk with @c true result means there is no
+     * data at the moment (producer is called again on the next step).
+     */
+    using stream_producer = std::function<bool (std::vector<char> & chunk, std::size_t max_size)>;
+
+    static constexpr std::size_t default_stream_chunk_size () noexcept
+    {
+        return 64 * 1024;
+    }
+
+    static constexpr std::size_t default_stream_window () noexcept
+    {
+        return 256 * 1024;
+    }
+
+private:
+    struct coalescing
+    {
+        std::size_t threshold {0}; // Coalescing is disabled if zero
+        std::chrono::microseconds budget {0};
+    };
+
+    struct compression
+    {
+        compression_enum alg {compression_enum::none};
+        std::size_t threshold {0};
+    };
+
+    struct peer
+    {
+        checksum_enum checksum {checksum_enum::crc32};
+        std::uint8_t compressions {0}; // Algorithms supported by both sides
+        bool streams {false};
+    };
+
+    struct stream
+    {
+        std::uint32_t id;
+        socket_id sid;
+        int priority;
+        bool has_checksum;
+        std::uint64_t offset;
+        stream_producer producer;
+    };
+
+    struct batch
+    {
+        std::vector<char> data;
+        timing_wheel::timer_id timer {0};
+    };
+
+    // Broadcast packet serialized for the peers with the same checksum and compression algorithms
+    struct variant
+    {
+        checksum_enum checksum;
+        compression_enum alg;
+        shared_buffer packet;
+    };
+
 private:
     Node & _node;
 
+    // Negotiated parameters of the sockets (CRC-32 without compression if not negotiated)
+    std::unordered_map<socket_id, peer> _peers;
+
+    std::vector<coalescing> _coalescing;   // Per priority
+    std::vector<compression> _compression; // Per priority
+
+    compressor _compressor;
+    std::vector<char> _zbuf;
+    std::vector<char> _rbuf; // Body of the routed packet
+
+    // Coalesced messages per socket and priority
+    std::unordered_map<socket_id, std::vector<batch>> _batches;
+
+    // Sockets with the batches to flush by step() (with zero latency budget)
+    std::vector<socket_id> _deferred;
+
+    std::vector<stream> _streams;
+    std::uint32_t _last_stream_id {0};
+    std::size_t _stream_chunk_size {default_stream_chunk_size()};
+    std::size_t _stream_window {default_stream_window()};
+    std::vector<char> _chunk;
+    std::vector<variant> _variants;
+
 public:
     simple_message_sender (Node & node)
         : _node(node)
+        , _coalescing(Node::priority_count())
+        , _compression(Node::priority_count())
     {}
 
-public:
-    void send (socket_id sid, int priority, bool has_checksum, char const * data, std::size_t len)
+private:
+    peer const * locate_peer (socket_id sid) const
     {
-        auto out = serializer_traits::make_serializer();
-        data_packet pkt {has_checksum};
-        pkt.serialize(out, data, len);
-        _node.send_private(sid, priority, out.data(), out.size());
+        auto pos = _peers.find(sid);
+        return pos != _peers.end() ? & pos->second : nullptr;
     }
 
-    void send (socket_id sid, int priority, bool has_checksum, std::vector<char> && data)
+    /**
+     * @return @c false if the packet is rejected by the output queue.
+     */
+    bool serialize_and_enqueue (socket_id sid, int priority, data_packet & pkt, peer const * p
+        , char const * data, std::size_t len)
     {
+        PFS__TERMINATE(priority >= 0 && static_cast<std::size_t>(priority) < _compression.size()
+            , "simple_message_sender: priority is out of range");
+
         auto out = serializer_traits::make_serializer();
-        data_packet pkt {has_checksum};
-        pkt.serialize(out, std::move(data));
-        _node.send_private(sid, priority, out.data(), out.size());
+        auto const & cfg = _compression[priority];
+
+        // Routed packet is decompressed by the destination, but the algorithms are negotiated
+        // with the neighbor only, so it is never compressed
+        if (p != nullptr && !pkt.is_routed() && len >= cfg.threshold
+                && (compression_bit(cfg.alg) & p->compressions)
+                && _compressor.compress(cfg.alg, data, len, _zbuf)) {
+            pkt.set_compression(cfg.alg, len);
+            data = _zbuf.data();
+            len = _zbuf.size();
+        }
+
+        // Body of the routed packet starts with the route identifiers (already in _rbuf)
+        if (pkt.is_routed()) {
+            _rbuf.insert(_rbuf.end(), data, data + len);
+            pkt.serialize(out, _rbuf.data(), _rbuf.size());
+        } else {
+            pkt.serialize(out, data, len);
+        }
+
+        // Rejection of the coalesced chunk could not be reported to the stream
+        if (pkt.is_stream_chunk())
+            return enqueue_now(sid, priority, out);
+
+        return enqueue(sid, priority, out);
+    }
+
+    bool serialize_and_enqueue (socket_id sid, int priority, bool has_checksum, char const * data
+        , std::size_t len)
+    {
+        auto p = locate_peer(sid);
+        data_packet pkt {has_checksum, p != nullptr ? p->checksum : checksum_enum::crc32};
+        return serialize_and_enqueue(sid, priority, pkt, p, data, len);
+    }
+
+    /**
+     * Pulls the chunks from the producers while the output queues of the sockets are smaller than
+     * the stream window. Streams of the same socket take chunks in turn.
+     */
+    void pump_streams ()
+    {
+        auto progress = true;
+
+        while (progress) {
+            progress = false;
+
+            for (std::size_t i = 0; i < _streams.size();) {
+                if (_node.remain_bytes(_streams[i].sid) >= _stream_window) {
+                    i++;
+                    continue;
+                }
+
+                _chunk.clear();
+
+                // Producer may start new streams, so the reference is taken after the call
+                auto more = _streams[i].producer(_chunk, _stream_chunk_size);
+                auto & s = _streams[i];
+
+                if (more && _chunk.empty()) {
+                    i++;
+                    continue;
+                }
+
+                auto p = locate_peer(s.sid);
+                data_packet pkt {s.has_checksum, p != nullptr ? p->checksum : checksum_enum::crc32};
+                pkt.set_stream_chunk(s.id, s.offset, !more);
+
+                // The rest of the stream is useless for the receiver without the rejected chunk
+                if (!serialize_and_enqueue(s.sid, s.priority, pkt, p, _chunk.data(), _chunk.size())) {
+                    auto sid = s.sid;
+                    auto id = s.id;
+                    _streams.erase(_streams.begin() + i);
+                    _node.fail_stream(sid, id, "stream chunk rejected by the output queue");
+                    continue;
+                }
+
+                s.offset += _chunk.size();
+                progress = true;
+
+                if (more)
+                    i++;
+                else
+                    _streams.erase(_streams.begin() + i);
+            }
+        }
+    }
+
+    void flush (socket_id sid, int priority, batch & b)
+    {
+        if (b.timer != 0) {
+            _node.timers().cancel(b.timer);
+            b.timer = 0;
+        }
+
+        if (!b.data.empty()) {
+            _node.send_private(sid, priority, b.data.data(), b.data.size());
+            b.data.clear(); // Capacity is kept
+        }
+    }
+
+    void flush (socket_id sid, std::vector<batch> & batches)
+    {
+        for (std::size_t i = 0; i < batches.size(); i++)
+            flush(sid, static_cast<int>(i), batches[i]);
+    }
+
+    /**
+     * Enqueues the packet bypassing the coalescing (messages coalesced before are sent first).
+     */
+    template <typename Serializer>
+    bool enqueue_now (socket_id sid, int priority, Serializer const & out)
+    {
+        auto pos = _batches.find(sid);
+
+        if (pos != _batches.end())
+            flush(sid, priority, pos->second[priority]);
+
+        return _node.send_private(sid, priority, out.data(), out.size());
+    }
+
+    /**
+     * @return @c false if the packet is rejected by the output queue (coalesced packets are
+     *         reported as accepted).
+     */
+    template <typename Serializer>
+    bool enqueue (socket_id sid, int priority, Serializer const & out)
+    {
+        auto const & cfg = _coalescing[priority];
+
+        if (cfg.threshold == 0)
+            return _node.send_private(sid, priority, out.data(), out.size());
+
+        auto & batches = _batches[sid];
+
+        if (batches.empty())
+            batches.resize(_coalescing.size());
+
+        auto & b = batches[priority];
+
+        // Large message is sent as is after the coalesced ones
+        if (out.size() >= cfg.threshold) {
+            flush(sid, priority, b);
+            return _node.send_private(sid, priority, out.data(), out.size());
+        }
+
+        auto first = b.data.empty();
+        b.data.insert(b.data.end(), out.data(), out.data() + out.size());
+
+        if (b.data.size() >= cfg.threshold) {
+            flush(sid, priority, b);
+            return true;
+        }
+
+        if (cfg.budget > std::chrono::microseconds{0}) {
+            if (b.timer == 0) {
+                b.timer = _node.timers().start_at(std::chrono::steady_clock::now() + cfg.budget
+                    , [this, sid, priority] () {
+                        auto pos = _batches.find(sid);
+
+                        if (pos != _batches.end()) {
+                            pos->second[priority].timer = 0;
+                            flush(sid, priority, pos->second[priority]);
+                        }
+                    });
+            }
+        } else if (first) {
+            _deferred.push_back(sid);
+        }
+
+        return true;
+    }
+
+public:
+    /**
+     * Chooses the checksum and compression algorithms for the socket by the masks of the algorithms
+     * supported by the peer (see handshake_packet::checksums() and handshake_packet::compressions()),
+     * checks if the peer supports streams.
+     */
+    void negotiate (socket_id sid, handshake_packet const & pkt)
+    {
+        peer p;
+        p.checksum = select_checksum(pkt.checksums());
+        p.compressions = pkt.compressions() & supported_compressions();
+        p.streams = pkt.supports_streams();
+
+        if (p.checksum == checksum_enum::crc32 && p.compressions == 0 && !p.streams)
+            _peers.erase(sid);
+        else
+            _peers[sid] = p;
+    }
+
+    /**
+     * Enables compression of the messages of @a priority not smaller than @a threshold bytes by
+     * algorithm @a alg. Messages are sent uncompressed if the peer does not support @a alg or
+     * if they are not compressible. compression_enum::none disables compression.
+     */
+    void set_compression (int priority, compression_enum alg, std::size_t threshold)
+    {
+        PFS__TERMINATE(priority >= 0 && static_cast<std::size_t>(priority) < _compression.size()
+            , "simple_message_sender: priority is out of range");
+
+        _compression[priority].alg = alg;
+        _compression[priority].threshold = threshold;
+    }
+
+    /**
+     * Enables coalescing of the messages of @a priority smaller than @a threshold bytes (serialized).
+     * Coalesced messages are sent when their total size reaches @a threshold, or after @a budget
+     * since the first of them (with the resolution of the node timers), or by flush(). If
+     * @a budget is zero, messages are coalesced until the next step of the node. Zero @a threshold
+     * disables coalescing.
+     */
+    void set_coalescing (int priority, std::size_t threshold, std::chrono::microseconds budget)
+    {
+        PFS__TERMINATE(priority >= 0 && static_cast<std::size_t>(priority) < _coalescing.size()
+            , "simple_message_sender: priority is out of range");
+
+        _coalescing[priority].threshold = threshold;
+        _coalescing[priority].budget = budget;
+
+        // Do not delay the messages already coalesced
+        if (threshold == 0) {
+            for (auto & x: _batches)
+                flush(x.first, priority, x.second[priority]);
+        }
+    }
+
+    /**
+     * Sets the maximum size of the stream chunk and the size of the output queue of the socket
+     * the chunks are pulled up to.
+     */
+    void set_stream_limits (std::size_t chunk_size, std::size_t window)
+    {
+        PFS__TERMINATE(chunk_size > 0, "simple_message_sender: zero stream chunk size");
+
+        _stream_chunk_size = chunk_size;
+        _stream_window = window;
+    }
+
+    /**
+     * Starts sending the stream produced by @a producer.
+     *
+     * @return Stream ID or zero if the peer does not support streams.
+     */
+    std::uint32_t send_stream (socket_id sid, int priority, bool has_checksum, stream_producer && producer)
+    {
+        PFS__TERMINATE(priority >= 0 && static_cast<std::size_t>(priority) < _compression.size()
+            , "simple_message_sender: priority is out of range");
+
+        auto p = locate_peer(sid);
+
+        if (p == nullptr || !p->streams)
+            return 0;
+
+        if (++_last_stream_id == 0)
+            _last_stream_id = 1;
+
+        _streams.push_back(stream {_last_stream_id, sid, priority, has_checksum, 0, std::move(producer)});
+        return _last_stream_id;
+    }
+
+    /**
+     * Fails the streams of the @a priority (e.g. the overflow policy that may drop their chunks
+     * is set for it).
+     */
+    void fail_streams (int priority, char const * reason)
+    {
+        for (std::size_t i = 0; i < _streams.size();) {
+            if (_streams[i].priority != priority) {
+                i++;
+                continue;
+            }
+
+            auto sid = _streams[i].sid;
+            auto id = _streams[i].id;
+            _streams.erase(_streams.begin() + i);
+            _node.fail_stream(sid, id, reason);
+        }
+    }
+
+    /**
+     * Sends all the coalesced messages.
+     */
+    void flush ()
+    {
+        for (auto & x: _batches)
+            flush(x.first, x.second);
+
+        _deferred.clear();
+    }
+
+    /**
+     * Sends the coalesced messages for the socket @a sid.
+     */
+    void flush (socket_id sid)
+    {
+        auto pos = _batches.find(sid);
+
+        if (pos != _batches.end())
+            flush(sid, pos->second);
+    }
+
+    void remove (socket_id sid)
+    {
+        _peers.erase(sid);
+
+        // Producers are destroyed, the peer sees the stream interrupted by disconnection
+        _streams.erase(std::remove_if(_streams.begin(), _streams.end()
+            , [sid] (stream const & s) { return s.sid == sid; }), _streams.end());
+
+        auto pos = _batches.find(sid);
+
+        if (pos != _batches.end()) {
+            for (auto & b: pos->second)
+                _node.timers().cancel(b.timer);
+
+            _batches.erase(pos);
+        }
+    }
+
+    /**
+     * @return @c false if the message is rejected by the output queue (coalesced messages are
+     *         reported as accepted).
+     */
+    bool send (socket_id sid, int priority, bool has_checksum, char const * data, std::size_t len)
+    {
+        return serialize_and_enqueue(sid, priority, has_checksum, data, len);
+    }
+
+    bool send (socket_id sid, int priority, bool has_checksum, std::vector<char> && data)
+    {
+        return serialize_and_enqueue(sid, priority, has_checksum, data.data(), data.size());
+    }
+
+    /**
+     * Sends the message routed from the node @a source to the node @a destination (identifiers are
+     * encoded) through the neighbor on socket @a sid.
+     */
+    bool send_routed (socket_id sid, int priority, bool has_checksum, std::uint8_t ttl
+        , std::string const & source, std::string const & destination, char const * data
+        , std::size_t len)
+    {
+        auto p = locate_peer(sid);
+        data_packet pkt {has_checksum, p != nullptr ? p->checksum : checksum_enum::crc32};
+        pkt.set_routed(ttl);
+
+        _rbuf.clear();
+        data_packet::make_route(source, destination, _rbuf);
+        return serialize_and_enqueue(sid, priority, pkt, p, data, len);
+    }
+
+    /**
+     * Sends the message to the sockets @a sids. The packet is serialized once per distinct
+     * combination of the negotiated checksum and compression algorithms, and the output queues
+     * of the sockets share it. Messages coalesced for the sockets are sent before it.
+     */
+    template <typename SocketIds>
+    void broadcast (SocketIds const & sids, int priority, bool has_checksum, shared_buffer const & data)
+    {
+        PFS__TERMINATE(priority >= 0 && static_cast<std::size_t>(priority) < _compression.size()
+            , "simple_message_sender: priority is out of range");
+
+        auto const & cfg = _compression[priority];
+
+        for (auto sid: sids) {
+            auto p = locate_peer(sid);
+            auto checksum = p != nullptr ? p->checksum : checksum_enum::crc32;
+            auto alg = (p != nullptr && data.size() >= cfg.threshold
+                && (compression_bit(cfg.alg) & p->compressions)) ? cfg.alg : compression_enum::none;
+
+            auto pos = std::find_if(_variants.begin(), _variants.end(), [checksum, alg] (variant const & v) {
+                return v.checksum == checksum && v.alg == alg;
+            });
+
+            if (pos == _variants.end()) {
+                auto out = serializer_traits::make_serializer();
+                data_packet pkt {has_checksum, checksum};
+                char const * payload = data.data();
+                std::size_t len = data.size();
+
+                if (alg != compression_enum::none && _compressor.compress(alg, payload, len, _zbuf)) {
+                    pkt.set_compression(alg, len);
+                    payload = _zbuf.data();
+                    len = _zbuf.size();
+                }
+
+                pkt.serialize(out, payload, len);
+                _variants.push_back(variant{checksum, alg, shared_buffer{out.data(), out.size()}});
+                pos = _variants.end() - 1;
+            }
+
+            auto bpos = _batches.find(sid);
+
+            if (bpos != _batches.end())
+                flush(sid, priority, bpos->second[priority]);
+
+            _node.send_private(sid, priority, pos->packet);
+        }
+
+        // Packets are released with the last reference from the output queues
+        _variants.clear();
+    }
+
+    /**
+     * Pulls the chunks of the streams, sends the messages coalesced with zero latency budget.
+     */
+    void step ()
+    {
+        if (!_streams.empty())
+            pump_streams();
+
+        if (_deferred.empty())
+            return;
+
+        for (auto sid: _deferred)
+            flush(sid);
+
+        _deferred.clear();
     }
 };
 
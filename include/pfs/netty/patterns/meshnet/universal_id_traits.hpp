@@ -5,11 +5,16 @@
 //
 // Changelog:
 //      2025.01.25 Initial version.
+//      2026.10.17 Added fixed-size binary encoding of the identifier.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <pfs/binary_istream.hpp>
+#include <pfs/binary_ostream.hpp>
+#include <pfs/endian.hpp>
 #include <pfs/optional.hpp>
 #include <pfs/universal_id.hpp>
 #include <pfs/universal_id_hash.hpp>
+#include <pfs/universal_id_pack.hpp>
 #include <string>
 
 NETTY__NAMESPACE_BEGIN
@@ -30,6 +35,35 @@ struct universal_id_traits
     {
         return pfs::parse_universal_id(s, n);
     }
+
+    /**
+     * Size of the binary representation of the identifier (see encode()).
+     */
+    static constexpr std::size_t encoded_size () noexcept
+    {
+        return 16;
+    }
+
+    /**
+     * Binary representation of the identifier (network byte order) to send it on the wire.
+     */
+    static std::string encode (node_id const & id)
+    {
+        pfs::binary_ostream<pfs::endian::network> out;
+        out << id;
+        return std::string(out.data(), out.size());
+    }
+
+    static pfs::optional<node_id> decode (char const * s, std::size_t n)
+    {
+        if (n != encoded_size())
+            return pfs::nullopt;
+
+        pfs::binary_istream<pfs::endian::network> in {s, n};
+        node_id id;
+        in >> id;
+        return id;
+    }
 };
 
 }} // namespace patterns::meshnet
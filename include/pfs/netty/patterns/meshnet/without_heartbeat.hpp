@@ -5,10 +5,13 @@
 //
 // Changelog:
 //      2025.01.17 Initial version.
+//      2026.10.17 Added negotiate(), set_interval(), set_timeout() and rtt() stubs.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "rtt_estimator.hpp"
 #include <pfs/netty/namespace.hpp>
 #include <pfs/netty/socket4_addr.hpp>
+#include <chrono>
 
 NETTY__NAMESPACE_BEGIN
 
@@ -25,8 +28,19 @@ public:
     without_heartbeat (Node &) {}
 
 public:
+    template <typename HandshakePacket>
+    void negotiate (socket_id, HandshakePacket const &) {}
+
+    void set_interval (std::chrono::milliseconds) {}
+    void set_timeout (std::chrono::milliseconds, std::chrono::milliseconds) {}
     void add (socket_id) {}
     void remove (socket_id) {}
+
+    rtt_estimator const * rtt (socket_id) const
+    {
+        return nullptr;
+    }
+
     void process (socket_id, heartbeat_packet const &) {}
     void step () {}
 
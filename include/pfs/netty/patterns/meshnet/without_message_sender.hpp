@@ -5,9 +5,19 @@
 //
 // Changelog:
 //      2025.02.10 Initial version.
+//      2026.10.17 Added negotiate() and remove().
+//                 Added flush() and step().
+//                 Added set_compression().
+//                 Added streams stubs.
+//                 Added send_routed() stub.
+//                 Added broadcast() stub.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <pfs/netty/compression.hpp>
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/shared_buffer.hpp>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 NETTY__NAMESPACE_BEGIN
@@ -25,11 +35,42 @@ public:
     {}
 
 public:
-    void send (socket_id, int, bool, char const *, std::size_t)
-    {}
+    template <typename HandshakePacket>
+    void negotiate (socket_id, HandshakePacket const &) {}
+
+    void set_compression (int, compression_enum, std::size_t) {}
+    void set_stream_limits (std::size_t, std::size_t) {}
+    void fail_streams (int, char const *) {}
+    void remove (socket_id) {}
+    void flush () {}
+    void flush (socket_id) {}
+    void step () {}
+
+    bool send (socket_id, int, bool, char const *, std::size_t)
+    {
+        return false;
+    }
 
-    void send (socket_id, int, bool, std::vector<char> &&)
+    bool send (socket_id, int, bool, std::vector<char> &&)
+    {
+        return false;
+    }
+
+    bool send_routed (socket_id, int, bool, std::uint8_t, std::string const &, std::string const &
+        , char const *, std::size_t)
+    {
+        return false;
+    }
+
+    template <typename SocketIds>
+    void broadcast (SocketIds const &, int, bool, shared_buffer const &)
     {}
+
+    template <typename Producer>
+    std::uint32_t send_stream (socket_id, int, bool, Producer &&)
+    {
+        return 0;
+    }
 };
 
 }} // namespace patterns::meshnet
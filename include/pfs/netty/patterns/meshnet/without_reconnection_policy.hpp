@@ -5,9 +5,11 @@
 //
 // Changelog:
 //      2025.02.04 Initial version.
+//      2026.10.17 Matches the interface of the reconnection_policy with backoff.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <pfs/netty/namespace.hpp>
+#include <pfs/netty/socket4_addr.hpp>
 #include <chrono>
 
 NETTY__NAMESPACE_BEGIN
@@ -17,10 +19,19 @@ namespace meshnet {
 
 struct without_reconnection_policy
 {
-    static std::chrono::seconds timeout ()
+    static constexpr bool enabled () noexcept
     {
-        return std::chrono::seconds{0};
+        return false;
     }
+
+    void set_backoff (std::chrono::milliseconds, std::chrono::milliseconds) {}
+
+    std::chrono::milliseconds timeout (socket4_addr const &)
+    {
+        return std::chrono::milliseconds{0};
+    }
+
+    void reset (socket4_addr const &) {}
 };
 
 }} // namespace patterns::meshnet
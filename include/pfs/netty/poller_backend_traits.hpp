@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+//      2026.10.17 Added is_completion_backend.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <type_traits>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Poller backend can be shared by listener, connecting, reader and writer pollers. Events for all
+ * of them are dispatched by a single poll call of the reader poller.
+ */
+template <typename Backend>
+struct is_shared_backend: std::false_type {};
+
+/**
+ * Poller backend transfers the data itself: reader receives into the buffers owned by the backend
+ * (reader_poller::data_received), writer passes the data to the backend (writer_poller::send),
+ * listener accepts (listener_poller::accepted) and connecting poller connects
+ * (connecting_poller::connect) by the backend operations instead of the socket system calls.
+ */
+template <typename Backend>
+struct is_completion_backend: std::false_type {};
+
+NETTY__NAMESPACE_END
@@ -5,6 +5,9 @@
 //
 // Changelog:
 //      2023.01.19 Initial version.
+//      2026.10.16 Added edge-triggered epoll reader poller.
+//                 Added pollers with shared epoll backend.
+//                 Added io_uring pollers.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "connecting_poller.hpp"
@@ -34,11 +37,31 @@ NETTY__NAMESPACE_END
 
 #if NETTY__EPOLL_ENABLED
 #   include "linux/epoll_poller.hpp"
+#   include "linux/shared_epoll_poller.hpp"
 NETTY__NAMESPACE_BEGIN
 using connecting_epoll_poller_t = connecting_poller<linux_os::epoll_poller>;
 using listener_epoll_poller_t = listener_poller<linux_os::epoll_poller>;
 using reader_epoll_poller_t = reader_poller<linux_os::epoll_poller>;
 using writer_epoll_poller_t = writer_poller<linux_os::epoll_poller>;
+
+// Edge-triggered epoll reader poller, no extra `recv` call per event to distinguish data from EOF
+using reader_epoll_et_poller_t = reader_poller<linux_os::epoll_et_poller>;
+
+// Pollers sharing the single epoll instance (when used together by meshnet node)
+using connecting_shared_epoll_poller_t = connecting_poller<linux_os::shared_epoll_poller>;
+using listener_shared_epoll_poller_t = listener_poller<linux_os::shared_epoll_poller>;
+using reader_shared_epoll_poller_t = reader_poller<linux_os::shared_epoll_poller>;
+using writer_shared_epoll_poller_t = writer_poller<linux_os::shared_epoll_poller>;
+NETTY__NAMESPACE_END
+#endif
+
+#if NETTY__IO_URING_ENABLED
+#   include "linux/io_uring_poller.hpp"
+NETTY__NAMESPACE_BEGIN
+using connecting_io_uring_poller_t = connecting_poller<linux_os::io_uring_poller>;
+using listener_io_uring_poller_t = listener_poller<linux_os::io_uring_poller>;
+using reader_io_uring_poller_t = reader_poller<linux_os::io_uring_poller>;
+using writer_io_uring_poller_t = writer_poller<linux_os::io_uring_poller>;
 NETTY__NAMESPACE_END
 #endif
 
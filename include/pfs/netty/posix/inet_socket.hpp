@@ -9,6 +9,7 @@
 #pragma once
 #include <pfs/netty/error.hpp>
 #include <pfs/netty/exports.hpp>
+#include <pfs/netty/frame_view.hpp>
 #include <pfs/netty/inet4_addr.hpp>
 #include <pfs/netty/namespace.hpp>
 #include <pfs/netty/send_result.hpp>
@@ -101,6 +102,17 @@ public:
      */
     NETTY__EXPORT send_result send (char const * data, int len, error * perr = nullptr);
 
+    /**
+     * Send data represented by the sequence of @a chunks in one system call (gather write).
+     *
+     * @param chunks Chunks of data to send.
+     * @param count Number of chunks.
+     * @param perr Pointer to structure to store error if occurred.
+     *
+     * @return Send result. Number of bytes sent may be less than the total size of the chunks.
+     */
+    NETTY__EXPORT send_result send (frame_chunk const * chunks, int count, error * perr = nullptr);
+
     NETTY__EXPORT int recv_from (char * data, int len, socket4_addr * saddr = nullptr
         , error * perr = nullptr);
 
@@ -6,6 +6,7 @@
 // Changelog:
 //      2023.01.01 Initial version.
 //      2024.05.14 Renamed to tcp_listener.
+//      2026.10.17 Added adopt().
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/netty/exports.hpp"
@@ -49,6 +50,12 @@ public:
     NETTY__EXPORT socket_type accept (error * perr = nullptr);
     NETTY__EXPORT socket_type accept_nonblocking (error * perr = nullptr);
 
+    /**
+     * Takes ownership of the socket @a sock accepted by the completion-based poller backend (see
+     * is_completion_backend) from the peer @a saddr.
+     */
+    NETTY__EXPORT socket_type adopt (socket_id sock, socket4_addr const & saddr);
+
     // For compatiblity with listener_pool
     socket_type accept_nonblocking (listener_id /*id*/, error * perr = nullptr)
     {
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2023.01.01 Initial version.
+//      2026.10.17 Added prepare_connect().
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/netty/conn_status.hpp"
@@ -58,6 +59,19 @@ public:
     NETTY__EXPORT conn_status connect (socket4_addr const & remote_saddr, inet4_addr const & local_addr
         , error * perr = nullptr);
 
+    /**
+     * Creates the socket for the connection to @a remote_saddr without connecting: the connection
+     * is established by the completion-based poller backend (see is_completion_backend).
+     */
+    NETTY__EXPORT bool prepare_connect (socket4_addr const & remote_saddr, error * perr = nullptr);
+
+    /**
+     * Creates the socket bound to the local address @a local_addr for the connection to
+     * @a remote_saddr without connecting.
+     */
+    NETTY__EXPORT bool prepare_connect (socket4_addr const & remote_saddr, inet4_addr const & local_addr
+        , error * perr = nullptr);
+
     /**
      * Shutdown connection.
      */
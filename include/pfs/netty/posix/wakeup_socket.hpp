@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/exports.hpp>
+#include <pfs/netty/namespace.hpp>
+#include <atomic>
+
+#if _MSC_VER
+#   include <winsock2.h>
+#endif
+
+NETTY__NAMESPACE_BEGIN
+
+namespace posix {
+
+/**
+ * Pair of connected stream sockets used to interrupt the poll from another thread.
+ *
+ * The receiving end (id()) is registered in the reader poller like an ordinary socket, so it works
+ * with any poller backend (including those that peek the socket input before reporting the event).
+ */
+class wakeup_socket
+{
+public:
+#if _MSC_VER
+    using socket_id = SOCKET;
+#else
+    using socket_id = int;
+#endif
+
+private:
+    socket_id _rd;
+    socket_id _wr;
+    std::atomic<bool> _pending {false}; // Wakeup is signaled but not cleared yet
+
+public:
+    NETTY__EXPORT wakeup_socket (error * perr = nullptr);
+    NETTY__EXPORT ~wakeup_socket ();
+
+    wakeup_socket (wakeup_socket const &) = delete;
+    wakeup_socket & operator = (wakeup_socket const &) = delete;
+
+public:
+    /**
+     * Socket identifier to register in the poller.
+     */
+    socket_id id () const noexcept
+    {
+        return _rd;
+    }
+
+    /**
+     * Interrupts the poll. Can be called from any thread, repeated calls before clear() are cheap
+     * (no system calls).
+     */
+    NETTY__EXPORT void notify () noexcept;
+
+    /**
+     * Drains the signaled wakeups. Must be called by the polling thread before processing the work
+     * submitted by the notifiers, so no notification is lost.
+     */
+    NETTY__EXPORT void clear () noexcept;
+};
+
+} // namespace posix
+
+NETTY__NAMESPACE_END
@@ -5,12 +5,15 @@
 //
 // Changelog:
 //      2023.01.23 Initial version.
+//      2026.10.16 Backend can be shared by pollers.
+//      2026.10.17 Added data_received callback for completion-based backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "chrono.hpp"
 #include "error.hpp"
 #include "exports.hpp"
 #include "namespace.hpp"
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -20,18 +23,32 @@ template <typename Backend>
 class reader_poller
 {
 public:
+    using backend_type = Backend;
     using socket_id = typename Backend::socket_id;
 
 private:
-    std::unique_ptr<Backend> _rep;
+    std::shared_ptr<Backend> _rep;
 
 public:
     mutable std::function<void(socket_id, error const &)> on_failure;
     mutable std::function<void(socket_id)> disconnected;
     mutable std::function<void(socket_id)> ready_read;
 
+    /**
+     * Called by the completion-based backend (see is_completion_backend) instead of ready_read with
+     * the data received into the buffer owned by the backend (valid during the call only).
+     */
+    mutable std::function<void(socket_id, char const *, std::size_t)> data_received;
+
 public:
     NETTY__EXPORT reader_poller ();
+
+    /**
+     * Constructs poller with the shared backend (see is_shared_backend). If @a backend is null the
+     * poller owns its backend.
+     */
+    NETTY__EXPORT explicit reader_poller (std::shared_ptr<Backend> backend);
+
     NETTY__EXPORT ~reader_poller ();
 
     reader_poller (reader_poller const &) = delete;
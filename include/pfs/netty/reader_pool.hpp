@@ -5,6 +5,12 @@
 //
 // Changelog:
 //      2024.12.31 Initial version.
+//      2026.10.16 Input buffers are recycled between read events.
+//                 Added per-socket input buffer size.
+//                 Duplicate failure/disconnection notifications are suppressed.
+//                 Added constructor with shared poller backend.
+//      2026.10.17 Added wakeup socket support.
+//                 Added support of the completion-based poller backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "error.hpp"
@@ -16,6 +22,7 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -28,34 +35,66 @@ public:
     using socket_type = Socket;
     using socket_id = typename Socket::socket_id;
 
+public:
+    /**
+     * Default size of the data read by a single `recv` call (default MTU size).
+     */
+    static constexpr std::size_t default_buffer_size () { return 1500; }
+
+    /**
+     * Maximum number of the recycled input buffers kept by the pool.
+     */
+    static constexpr std::size_t max_free_buffers () { return 8; }
+
 private:
     struct account
     {
         socket_id id;
-        std::uint16_t frame_size {1500}; // Initial value is default MTU size
+        std::size_t buffer_size {default_buffer_size()}; // Size of the data read by a single `recv` call
+        bool removable {false}; // Account is scheduled for removal
+        bool wakeup {false};    // Socket interrupts the poll, data is not read by the pool
     };
 
 private:
     std::unordered_map<socket_id, account> _accounts;
     std::vector<socket_id> _removable;
 
+    // Input buffers returned to the pool, reused by subsequent read events.
+    std::vector<std::vector<char>> _free_buffers;
+
     mutable std::function<void(socket_id, error const &)> _on_failure = [] (socket_id, error const &) {};
     mutable std::function<void(socket_id, std::vector<char> &&)> _on_data_ready;
     mutable std::function<void(socket_id)> _on_disconnected;
+    mutable std::function<void(socket_id)> _on_wakeup = [] (socket_id) {};
     mutable std::function<Socket *(socket_id)> _locate_socket = [] (socket_id) -> Socket * {
         PFS__TERMINATE(false, "socket location callback must be set");
         return nullptr;
     };
 
 public:
-    reader_pool (): ReaderPoller()
+    reader_pool ()
+        : reader_pool(nullptr)
+    {}
+
+    /**
+     * Constructs pool with the poller backend shared with other pools (see is_shared_backend).
+     */
+    explicit reader_pool (std::shared_ptr<typename ReaderPoller::backend_type> backend)
+        : ReaderPoller(std::move(backend))
     {
         ReaderPoller::on_failure = [this] (socket_id id, error const & err) {
+            if (is_removable(id))
+                return;
+
             remove_later(id);
             _on_failure(id, err);
         };
 
         ReaderPoller::disconnected = [this] (socket_id id) {
+            // Edge-triggered poller may report the disconnection right after the read failure
+            if (is_removable(id))
+                return;
+
             if (_on_disconnected)
                 _on_disconnected(id);
             remove_later(id);
@@ -68,6 +107,14 @@ public:
             PFS__TERMINATE(acc != nullptr, "Fix the algorithm of ready read for a reader pool:"
                 " reader account not found by id");
 
+            if (acc->removable)
+                return;
+
+            if (acc->wakeup) {
+                _on_wakeup(id);
+                return;
+            }
+
             auto sock = _locate_socket(id);
 
             if (sock == nullptr) {
@@ -77,17 +124,18 @@ public:
                 return;
             }
 
-            std::vector<char> inpb;
+            auto inpb = acquire_buffer();
 
             // Read all received data and put it into input buffer.
             for (;;) {
                 error err;
                 auto offset = inpb.size();
-                inpb.resize(offset + acc->frame_size);
+                inpb.resize(offset + acc->buffer_size);
 
-                auto n = sock->recv(inpb.data() + offset, acc->frame_size, & err);
+                auto n = sock->recv(inpb.data() + offset, static_cast<int>(acc->buffer_size), & err);
 
                 if (n < 0) {
+                    recycle(std::move(inpb));
                     _on_failure(id, err);
                     remove_later(id);
                     return;
@@ -95,12 +143,40 @@ public:
 
                 inpb.resize(offset + n);
 
-                if (n == 0)
+                // No more data available: short read means the socket input is drained, so the extra `recv`
+                // call is not needed.
+                if (static_cast<std::size_t>(n) < acc->buffer_size)
                     break;
             }
 
+            if (!inpb.empty() && _on_data_ready)
+                _on_data_ready(id, std::move(inpb));
+
+            // Callback did not take ownership of the buffer, so it is still owned by the pool.
+            if (inpb.capacity() > 0)
+                recycle(std::move(inpb));
+        };
+
+        // Data received by the completion-based backend is copied out of the backend buffer
+        ReaderPoller::data_received = [this] (socket_id id, char const * data, std::size_t size) {
+            auto acc = locate_account(id);
+
+            if (acc == nullptr || acc->removable)
+                return;
+
+            if (acc->wakeup) {
+                _on_wakeup(id);
+                return;
+            }
+
+            auto inpb = acquire_buffer();
+            inpb.insert(inpb.end(), data, data + size);
+
             if (_on_data_ready)
                 _on_data_ready(id, std::move(inpb));
+
+            if (inpb.capacity() > 0)
+                recycle(std::move(inpb));
         };
     }
 
@@ -141,14 +217,68 @@ private:
         return acc;
     }
 
+    bool is_removable (socket_id id)
+    {
+        auto acc = locate_account(id);
+        return acc != nullptr && acc->removable;
+    }
+
+    std::vector<char> acquire_buffer ()
+    {
+        if (_free_buffers.empty())
+            return std::vector<char>{};
+
+        auto inpb = std::move(_free_buffers.back());
+        _free_buffers.pop_back();
+        return inpb;
+    }
+
 public:
-    void add (socket_id id)
+    /**
+     * Adds socket to the pool.
+     *
+     * @param id Socket identifier.
+     * @param buffer_size Size of the data read by a single `recv` call. Larger values reduce the number
+     *        of system calls for bulk traffic. Completion-based backends (see is_completion_backend)
+     *        receive into their own buffers and ignore it.
+     */
+    void add (socket_id id, std::size_t buffer_size = default_buffer_size())
+    {
+        auto acc = ensure_account(id);
+        acc->buffer_size = buffer_size > 0 ? buffer_size : default_buffer_size();
+    }
+
+    /**
+     * Adds the socket that interrupts the poll (see posix::wakeup_socket). Wakeup callback is called
+     * instead of reading the data.
+     */
+    void add_wakeup (socket_id id)
     {
-        /*auto acc = */ensure_account(id);
+        auto acc = ensure_account(id);
+        acc->wakeup = true;
+    }
+
+    /**
+     * Returns the input buffer to the pool for reuse. Data ready callback may take ownership of the
+     * buffer (by moving it) and return it later by this method. Buffers not taken by the callback are
+     * recycled automatically.
+     */
+    void recycle (std::vector<char> && inpb)
+    {
+        if (_free_buffers.size() >= max_free_buffers())
+            return;
+
+        inpb.clear(); // Capacity is kept
+        _free_buffers.push_back(std::move(inpb));
     }
 
     void remove_later (socket_id id)
     {
+        auto acc = locate_account(id);
+
+        if (acc != nullptr)
+            acc->removable = true;
+
         _removable.push_back(id);
     }
 
@@ -176,6 +306,8 @@ public:
 
     /**
      * Sets a callback for reading from the socket. Callback signature is void(socket_id, std::vector<char> &&).
+     * The buffer is owned by the pool and reused after the callback returns unless the callback moves it
+     * out (see recycle()).
      */
     template <typename F>
     reader_pool & on_data_ready (F && f)
@@ -191,6 +323,16 @@ public:
         return *this;
     }
 
+    /**
+     * Sets a callback for the wakeup socket readiness. Callback signature is void(socket_id).
+     */
+    template <typename F>
+    reader_pool & on_wakeup (F && f)
+    {
+        _on_wakeup = std::forward<F>(f);
+        return *this;
+    }
+
     template <typename F>
     reader_pool & on_locate_socket (F && f)
     {
@@ -5,12 +5,14 @@
 //
 // Changelog:
 //      2024.05.07 Initial version.
+//      2026.10.17 Respondent output queues share the broadcast data (shared_buffer).
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "connection_refused_reason.hpp"
 #include "error.hpp"
 #include "property.hpp"
 #include "send_result.hpp"
+#include "shared_buffer.hpp"
 #include "socket4_addr.hpp"
 #include <pfs/i18n.hpp>
 #include <pfs/ring_buffer.hpp>
@@ -32,6 +34,15 @@ class service
 {
     using output_queue_type = pfs::ring_buffer<std::vector<char>, 64>;
 
+    // Output item referencing the data shared by the output queues
+    struct shared_output_item
+    {
+        shared_buffer data;
+        std::size_t cursor; // Number of bytes already sent
+    };
+
+    using shared_output_queue_type = pfs::ring_buffer<shared_output_item, 64>;
+
 public:
     using input_envelope_type  = InputEnvelope;
     using output_envelope_type = OutputEnvelope;
@@ -52,7 +63,7 @@ public:
             Socket sock;
             bool can_write {true};
             std::vector<char> inb;  // Input buffer
-            output_queue_type outq; // Output queue
+            shared_output_queue_type outq; // Output queue
         };
 
     public:
@@ -181,12 +192,7 @@ public:
 
         void enqueue (socket_id sock, char const * data, int len)
         {
-            auto arequester = locate_account(sock);
-
-            if (arequester == nullptr)
-                return;
-
-            arequester.outq.push(std::vector<char>(data, data + len));
+            enqueue(sock, shared_buffer{data, static_cast<std::size_t>(len)});
         }
 
         void enqueue (socket_id sock, std::string const & data)
@@ -205,23 +211,37 @@ public:
         }
 
         void enqueue (socket_id sock, std::vector<char> && data)
+        {
+            enqueue(sock, shared_buffer{std::move(data)});
+        }
+
+        void enqueue (socket_id sock, shared_buffer const & data)
         {
             auto arequester = locate_account(sock);
 
             if (arequester == nullptr)
                 return;
 
-            arequester->outq.push(std::move(data));
+            arequester->outq.push(shared_output_item{data, 0});
         }
 
-        void enqueue_broadcast (char const * data, int len)
+        /**
+         * Enqueues the data for all requesters. The data is stored once and shared by the output
+         * queues.
+         */
+        void enqueue_broadcast (shared_buffer const & data)
         {
             for (auto & item: _requesters) {
-                auto & arequester = item->second;
-                arequester.outq.push(std::vector<char>(data, data + len));
+                auto & arequester = item.second;
+                arequester.outq.push(shared_output_item{data, 0});
             }
         }
 
+        void enqueue_broadcast (char const * data, int len)
+        {
+            enqueue_broadcast(shared_buffer{data, static_cast<std::size_t>(len)});
+        }
+
         void enqueue_broadcast (std::string const & data)
         {
             enqueue_broadcast(data.data(), data.size());
@@ -239,10 +259,7 @@ public:
 
         void enqueue_broadcast (std::vector<char> && data)
         {
-            for (auto & item: _requesters) {
-                auto & arequester = item.second;
-                arequester.outq.push(data);
-            }
+            enqueue_broadcast(shared_buffer{std::move(data)});
         }
 
     private:
@@ -319,17 +336,17 @@ public:
                     continue;
 
                 while (!break_sending && !arequester->outq.empty()) {
-                    auto & data = arequester->outq.front();
-                    auto sendresult = arequester->sock.send(data.data(), data.size(), & err);
+                    auto & item = arequester->outq.front();
+                    auto sendresult = arequester->sock.send(item.data.data() + item.cursor
+                        , item.data.size() - item.cursor, & err);
 
                     switch (sendresult.status) {
                         case netty::send_status::good:
                             if (sendresult.n > 0) {
-                                if (sendresult.n == data.size()) {
+                                item.cursor += sendresult.n;
+
+                                if (item.cursor == item.data.size())
                                     arequester->outq.pop();
-                                } else {
-                                    data.erase(data.cbegin(), data.cbegin() + sendresult.n);
-                                }
 
                                 total_bytes_sent += sendresult.n;
                             }
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Immutable reference-counted byte buffer.
+ *
+ * Copies of the buffer share the same bytes, so the data enqueued to many writer queues (e.g. the
+ * message broadcast to all neighbors) is stored once and released with the last reference. The
+ * reference counter is atomic, so the buffer can be passed between threads.
+ */
+class shared_buffer
+{
+    std::shared_ptr<std::vector<char> const> _b;
+
+public:
+    shared_buffer () = default;
+
+    /**
+     * Takes the ownership of the @a data without copying.
+     */
+    explicit shared_buffer (std::vector<char> && data)
+        : _b(std::make_shared<std::vector<char> const>(std::move(data)))
+    {}
+
+    shared_buffer (char const * data, std::size_t len)
+        : _b(std::make_shared<std::vector<char> const>(data, data + len))
+    {}
+
+public:
+    char const * data () const noexcept
+    {
+        return _b ? _b->data() : nullptr;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _b ? _b->size() : 0;
+    }
+
+    bool empty () const noexcept
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Number of the buffer copies sharing the data.
+     */
+    long use_count () const noexcept
+    {
+        return _b.use_count();
+    }
+};
+
+NETTY__NAMESPACE_END
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "namespace.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+NETTY__NAMESPACE_BEGIN
+
+/**
+ * Hierarchical timing wheel (4 levels of 64 slots).
+ *
+ * Starting and cancelling a timer are O(1), advancing costs O(1) per expired (or cascaded) timer,
+ * empty ticks are skipped. Timers never fire before their deadline, but may fire up to one tick
+ * later.
+ */
+class timing_wheel
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+    using callback_type = std::function<void()>;
+
+    /**
+     * Timer handle. Zero value is never used by active timers.
+     */
+    using timer_id = std::uint64_t;
+
+private:
+    static constexpr int kLEVEL_BITS = 6;
+    static constexpr int kSLOT_COUNT = 1 << kLEVEL_BITS;
+    static constexpr int kLEVEL_COUNT = 4;
+    static constexpr std::uint64_t kSLOT_MASK = kSLOT_COUNT - 1;
+    static constexpr std::int32_t kNIL = -1;
+
+    struct timer_node
+    {
+        std::uint64_t expires {0};     // Expiration tick
+        std::uint32_t generation {1};  // Incremented when the node is released
+        std::int32_t prev {kNIL};
+        std::int32_t next {kNIL};      // Next node in the slot list or in the free list
+        std::int32_t slot {kNIL};      // Slot index (level * kSLOT_COUNT + index) or kNIL if not scheduled
+        callback_type callback;
+    };
+
+private:
+    std::chrono::milliseconds _resolution;
+    time_point _origin;
+    std::uint64_t _current {0}; // Last processed tick
+    std::size_t _size {0};
+
+    std::vector<timer_node> _nodes;
+    std::int32_t _free {kNIL};
+    std::int32_t _slots[kLEVEL_COUNT * kSLOT_COUNT];
+    std::uint64_t _occupied[kLEVEL_COUNT]; // Bit per non-empty slot
+
+public:
+    /**
+     * Constructs timing wheel.
+     *
+     * @param resolution Duration of the tick.
+     */
+    NETTY__EXPORT timing_wheel (std::chrono::milliseconds resolution = std::chrono::milliseconds{1});
+
+    timing_wheel (timing_wheel const &) = delete;
+    timing_wheel & operator = (timing_wheel const &) = delete;
+
+public:
+    /**
+     * Starts the timer that calls @a callback after @a timeout.
+     */
+    NETTY__EXPORT timer_id start (std::chrono::milliseconds timeout, callback_type && callback);
+
+    /**
+     * Starts the timer that calls @a callback at @a deadline.
+     */
+    NETTY__EXPORT timer_id start_at (time_point deadline, callback_type && callback);
+
+    /**
+     * Cancels the timer.
+     *
+     * @return @c false if the timer is already expired or cancelled.
+     */
+    NETTY__EXPORT bool cancel (timer_id id) noexcept;
+
+    /**
+     * Checks if the timer is scheduled.
+     */
+    NETTY__EXPORT bool active (timer_id id) const noexcept;
+
+    /**
+     * Calls the callbacks of the timers expired by the time @a now. Callbacks may start and cancel
+     * timers.
+     *
+     * @return Number of the expired timers.
+     */
+    NETTY__EXPORT std::size_t advance (time_point now = clock_type::now());
+
+    /**
+     * Returns the time the next advance() will have work at (the nearest expiration or cascading
+     * of the timers), or @c time_point::max() if there are no timers. It is a lower bound of the
+     * nearest timer deadline, so it can be used as the poll timeout.
+     */
+    NETTY__EXPORT time_point next_deadline () const noexcept;
+
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+private:
+    std::uint64_t floor_tick (time_point t) const noexcept;
+    std::uint64_t ceil_tick (time_point t) const noexcept;
+    std::uint64_t next_tick () const noexcept;
+    std::int32_t acquire_node ();
+    void release_node (std::int32_t index) noexcept;
+    void link (std::int32_t index);
+    void unlink (std::int32_t index) noexcept;
+    void cascade (int level);
+    std::size_t expire ();
+};
+
+NETTY__NAMESPACE_END
@@ -12,6 +12,7 @@
 #include <pfs/netty/conn_status.hpp>
 #include <pfs/netty/error.hpp>
 #include <pfs/netty/exports.hpp>
+#include <pfs/netty/frame_view.hpp>
 #include <pfs/netty/send_result.hpp>
 #include <pfs/netty/socket4_addr.hpp>
 // #include <pfs/netty/uninitialized.hpp>
@@ -111,6 +112,7 @@ public:
 
     NETTY__EXPORT int recv (char * data, int len, error * perr = nullptr);
     NETTY__EXPORT send_result send (char const * data, int len, error * perr = nullptr);
+    NETTY__EXPORT send_result send (frame_chunk const * chunks, int count, error * perr = nullptr);
 
     /**
      * Connects to the UDT server.
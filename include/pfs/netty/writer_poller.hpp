@@ -5,10 +5,13 @@
 //
 // Changelog:
 //      2023.01.24 Initial version.
+//      2026.10.16 Backend can be shared by pollers.
+//      2026.10.17 Added send() for completion-based backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "error.hpp"
 #include "exports.hpp"
+#include "frame_view.hpp"
 #include "namespace.hpp"
 #include <chrono>
 #include <functional>
@@ -20,10 +23,11 @@ template <typename Backend>
 class writer_poller
 {
 public:
+    using backend_type = Backend;
     using socket_id = typename Backend::socket_id;
 
 private:
-    std::unique_ptr<Backend> _rep;
+    std::shared_ptr<Backend> _rep;
 
 public:
     mutable std::function<void(socket_id, error const &)> on_failure;
@@ -31,6 +35,13 @@ public:
 
 public:
     NETTY__EXPORT writer_poller ();
+
+    /**
+     * Constructs poller with the shared backend (see is_shared_backend). If @a backend is null the
+     * poller owns its backend.
+     */
+    NETTY__EXPORT explicit writer_poller (std::shared_ptr<Backend> backend);
+
     NETTY__EXPORT ~writer_poller ();
 
     writer_poller (writer_poller const &) = delete;
@@ -40,6 +51,16 @@ public:
 
     NETTY__EXPORT void wait_for_write (socket_id sock, error * perr = nullptr);
     NETTY__EXPORT void remove (socket_id sock, error * perr = nullptr);
+
+    /**
+     * Passes the data to the completion-based backend (see is_completion_backend): the data of
+     * @a chunks is copied into the buffer owned by the backend and written by it. Write completion
+     * is reported by can_write if it is requested by wait_for_write().
+     *
+     * @return Number of bytes accepted, zero if the previous data is still being written.
+     */
+    NETTY__EXPORT std::size_t send (socket_id sock, frame_chunk const * chunks, int count
+        , error * perr = nullptr);
     NETTY__EXPORT int poll (std::chrono::milliseconds millis, error * perr = nullptr);
     NETTY__EXPORT bool empty () const noexcept;
 };
@@ -5,24 +5,54 @@
 //
 // Changelog:
 //      2024.12.27 Initial version.
+//      2026.10.16 Frames are sent by gather write without intermediate copying.
+//                 Only accounts ready for writing are visited by the send pass.
+//                 Added constructor with shared poller backend.
+//      2026.10.17 Added has_active().
+//                 Added output queue setup (e.g. priority weights).
+//                 Added remain_bytes() per socket.
+//                 Remain bytes are accounted by the payload released by the queue (framing
+//                 overhead excluded), fixed underflow on removed sockets.
+//                 Added water marks with congestion callbacks and per-priority overflow policies.
+//                 Added enqueue of the shared buffers without copying.
+//                 Added overflow_policy().
+//                 Added sampling of the send queue delay (on_queue_delay callback).
+//                 Added support of the completion-based poller backends.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "error.hpp"
+#include "frame_view.hpp"
 #include "namespace.hpp"
+#include "poller_backend_traits.hpp"
 #include "send_result.hpp"
+#include "shared_buffer.hpp"
 #include "writer_queue.hpp"
 #include <pfs/assert.hpp>
+#include <pfs/i18n.hpp>
 #include <pfs/stopwatch.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 NETTY__NAMESPACE_BEGIN
 
+/**
+ * Action on the message that overflows the limit of the priority queue.
+ */
+enum class overflow_policy_enum
+{
+      accept      // Message is accepted (limit is not applied)
+    , reject      // Message is rejected
+    , drop_oldest // Oldest messages not sent yet are dropped to free the space (for lossy data)
+};
+
 template <typename Socket, typename WriterPoller, typename WriterQueue = writer_queue>
 class writer_pool: protected WriterPoller
 {
@@ -35,6 +65,14 @@ public:
         return 1500;
     }
 
+    /**
+     * Maximum number of frames sent by one system call.
+     */
+    static constexpr std::size_t max_frame_count ()
+    {
+        return 16;
+    }
+
 private:
     struct account
     {
@@ -42,6 +80,23 @@ private:
         bool writable {false};   // Socket is writable
         std::uint16_t frame_size {default_frame_size()}; // Initial value is default MTU size
         WriterQueue q; // Output queue
+        std::uint64_t remain_bytes {0}; // Bytes in the output queue
+
+        // Congestion state is set when remain_bytes reaches the high water mark and reset when
+        // it falls to the low water mark (disabled if high_mark is zero)
+        std::uint64_t high_mark {0};
+        std::uint64_t low_mark {0};
+        bool congested {false};
+
+        // Sampled message (see on_queue_delay()): number of bytes to release until it is written
+        bool probe {false};
+        std::uint64_t probe_bytes {0};
+        std::chrono::steady_clock::time_point probe_time;
+
+        // Links in the list of active (writable and non-empty) accounts
+        bool active {false};
+        account * prev {nullptr};
+        account * next {nullptr};
     };
 
     struct item
@@ -49,20 +104,56 @@ private:
         socket_id id;
     };
 
+    struct priority_limit
+    {
+        std::size_t limit {0}; // Maximum number of bytes in the priority queue, zero is unlimited
+        overflow_policy_enum policy {overflow_policy_enum::accept};
+    };
+
 private:
     std::uint64_t _remain_bytes {0};
-    std::unordered_map<socket_id, account> _accounts;
+    std::unordered_map<socket_id, account> _accounts; // References to elements are stable
     std::vector<socket_id> _removable;
 
+    // List of active accounts (writable and with non-empty output queue)
+    account * _active_head {nullptr};
+    account * _active_tail {nullptr};
+
+    // Next account visited by the send pass (kept valid when the account is unlinked)
+    account * _active_cursor {nullptr};
+    frame_view _fv; // Reusable frame view
+
+    // Initializes the output queue of the new accounts
+    std::function<void(WriterQueue &)> _queue_setup;
+
+    // Water marks for the new accounts
+    std::uint64_t _high_mark {0};
+    std::uint64_t _low_mark {0};
+
+    std::vector<priority_limit> _limits; // Per priority, empty if there are no limits
+
+    mutable std::function<void(socket_id)> _on_congested;
+    mutable std::function<void(socket_id)> _on_drained;
+    mutable std::function<void(socket_id, int, std::size_t)> _on_message_dropped;
+
     mutable std::function<void(socket_id, error const &)> _on_failure = [] (socket_id, error const &) {};
     mutable std::function<void(socket_id, std::uint64_t)> _on_bytes_written;
+    mutable std::function<void(socket_id, std::chrono::microseconds)> _on_queue_delay;
     mutable std::function<Socket *(socket_id)> _locate_socket = [] (socket_id) -> Socket * {
         PFS__TERMINATE(false, "socket location callback must be set");
         return nullptr;
     };
 
 public:
-    writer_pool (): WriterPoller()
+    writer_pool ()
+        : writer_pool(nullptr)
+    {}
+
+    /**
+     * Constructs pool with the poller backend shared with other pools (see is_shared_backend).
+     */
+    explicit writer_pool (std::shared_ptr<typename WriterPoller::backend_type> backend)
+        : WriterPoller(std::move(backend))
     {
         WriterPoller::on_failure = [this] (socket_id id, error const & err) {
             remove_later(id);
@@ -72,8 +163,10 @@ public:
         WriterPoller::can_write = [this] (socket_id id) {
             auto acc = locate_account(id);
 
-            if (acc != nullptr)
+            if (acc != nullptr) {
                 acc->writable = true;
+                update_active(*acc);
+            }
         };
     }
 
@@ -93,6 +186,58 @@ private:
         return & acc;
     }
 
+    void link_active (account & acc)
+    {
+        if (acc.active)
+            return;
+
+        acc.active = true;
+        acc.prev = _active_tail;
+        acc.next = nullptr;
+
+        if (_active_tail != nullptr)
+            _active_tail->next = & acc;
+        else
+            _active_head = & acc;
+
+        _active_tail = & acc;
+    }
+
+    void unlink_active (account & acc)
+    {
+        if (!acc.active)
+            return;
+
+        if (_active_cursor == & acc)
+            _active_cursor = acc.next;
+
+        if (acc.prev != nullptr)
+            acc.prev->next = acc.next;
+        else
+            _active_head = acc.next;
+
+        if (acc.next != nullptr)
+            acc.next->prev = acc.prev;
+        else
+            _active_tail = acc.prev;
+
+        acc.active = false;
+        acc.prev = nullptr;
+        acc.next = nullptr;
+    }
+
+    /**
+     * Links the account into the active list if it is writable and has data to send, or unlinks it
+     * otherwise.
+     */
+    void update_active (account & acc)
+    {
+        if (acc.writable && !acc.q.empty())
+            link_active(acc);
+        else
+            unlink_active(acc);
+    }
+
     account * ensure_account (socket_id id, std::uint16_t frame_size = default_frame_size())
     {
         auto acc = locate_account(id);
@@ -101,28 +246,154 @@ private:
             account a;
             a.id = id;
             a.frame_size = frame_size;
+            a.high_mark = _high_mark;
+            a.low_mark = _low_mark;
             auto res = _accounts.emplace(id, std::move(a));
 
             acc = & res.first->second;
+
+            if (_queue_setup)
+                _queue_setup(acc->q);
+
             WriterPoller::wait_for_write(acc->id);
         }
 
         return acc;
     }
 
+    void update_congestion (account & acc)
+    {
+        if (!acc.congested) {
+            if (acc.high_mark > 0 && acc.remain_bytes >= acc.high_mark) {
+                acc.congested = true;
+
+                if (_on_congested)
+                    _on_congested(acc.id);
+            }
+        } else if (acc.high_mark == 0 || acc.remain_bytes <= acc.low_mark) {
+            acc.congested = false;
+
+            if (_on_drained)
+                _on_drained(acc.id);
+        }
+    }
+
+    /**
+     * Applies the overflow policy of the @a priority to the message of @a len bytes.
+     *
+     * @return @c false if the message must be rejected.
+     */
+    bool admit (account & acc, int priority, std::size_t len)
+    {
+        PFS__TERMINATE(priority >= 0 && priority < priority_count(), "writer_pool: priority is out of range");
+
+        if (_limits.empty())
+            return true;
+
+        auto const & lim = _limits[priority];
+
+        if (lim.limit == 0 || lim.policy == overflow_policy_enum::accept)
+            return true;
+
+        if (acc.q.size(priority) + len <= lim.limit)
+            return true;
+
+        if (lim.policy == overflow_policy_enum::drop_oldest && len <= lim.limit) {
+            while (acc.q.size(priority) + len > lim.limit) {
+                auto n = acc.q.drop_front(priority);
+
+                // Remaining data is being sent
+                if (n == 0)
+                    break;
+
+                acc.remain_bytes -= n;
+                _remain_bytes -= n;
+
+                // Released bytes of the sampled message can not be tracked anymore
+                acc.probe = false;
+
+                if (_on_message_dropped)
+                    _on_message_dropped(acc.id, priority, n);
+            }
+
+            if (acc.q.size(priority) + len <= lim.limit)
+                return true;
+        }
+
+        if (_on_message_dropped)
+            _on_message_dropped(acc.id, priority, len);
+
+        return false;
+    }
+
+    /**
+     * Starts sampling of the message just enqueued if no message of the socket is sampled.
+     */
+    void start_probe (account & acc)
+    {
+        if (!_on_queue_delay || acc.probe)
+            return;
+
+        acc.probe = true;
+        acc.probe_bytes = acc.remain_bytes;
+        acc.probe_time = std::chrono::steady_clock::now();
+    }
+
+    void update_probe (account & acc, std::uint64_t released)
+    {
+        if (!acc.probe)
+            return;
+
+        if (released < acc.probe_bytes) {
+            acc.probe_bytes -= released;
+            return;
+        }
+
+        acc.probe = false;
+
+        if (_on_queue_delay) {
+            _on_queue_delay(acc.id, std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - acc.probe_time));
+        }
+    }
+
+    /**
+     * Writes the frames by the socket.
+     */
+    send_result write_frames (account &, Socket & sock, error * perr, std::false_type)
+    {
+        return sock.send(_fv.data(), static_cast<int>(_fv.count()), perr);
+    }
+
+    /**
+     * Passes the frames to the completion-based backend: the data is copied into the buffer of the
+     * backend, so it is released from the queue (and accounted as written) when it is accepted.
+     */
+    send_result write_frames (account & acc, Socket &, error * perr, std::true_type)
+    {
+        auto n = WriterPoller::send(acc.id, _fv.data(), static_cast<int>(_fv.count()), perr);
+
+        if (perr != nullptr && *perr)
+            return send_result{send_status::failure, 0};
+
+        return n > 0
+            ? send_result{send_status::good, static_cast<std::uint64_t>(n)}
+            : send_result{send_status::again, 0};
+    }
+
     void send (std::chrono::milliseconds limit = std::chrono::milliseconds{0}, error * perr = nullptr)
     {
         pfs::stopwatch<std::milli> stopwatch;
 
         do {
-            for (auto & item: _accounts) {
-                auto & acc = item.second;
+            if (_active_head == nullptr)
+                break;
 
-                if (!acc.writable)
-                    continue;
+            _active_cursor = _active_head;
 
-                if (acc.q.empty())
-                    continue;
+            while (_active_cursor != nullptr) {
+                auto & acc = *_active_cursor;
+                _active_cursor = acc.next;
 
                 auto sock = _locate_socket(acc.id);
 
@@ -133,13 +404,16 @@ private:
                     continue;
                 }
 
-                auto frame = acc.q.frame(acc.frame_size);
+                acc.q.frames(acc.frame_size, max_frame_count(), _fv);
 
-                if (frame.empty())
+                if (_fv.empty()) {
+                    unlink_active(acc);
                     continue;
+                }
 
                 netty::error err;
-                auto res = sock->send(frame.data(), frame.size(), & err);
+                auto res = write_frames(acc, *sock, & err
+                    , is_completion_backend<typename WriterPoller::backend_type>{});
 
                 switch (res.status) {
                     case netty::send_status::failure:
@@ -152,14 +426,21 @@ private:
                     case netty::send_status::overflow:
                         if (acc.writable) {
                             acc.writable = false;
+                            unlink_active(acc);
                             WriterPoller::wait_for_write(acc.id);
                         }
                         break;
 
                     case netty::send_status::good:
                         if (res.n > 0) {
-                            _remain_bytes -= res.n;
-                            acc.q.shift(res.n);
+                            // Sent bytes may include the framing added by the queue, so
+                            // only the released payload is accounted
+                            auto n = acc.q.shift(res.n);
+                            _remain_bytes -= n;
+                            acc.remain_bytes -= n;
+                            update_probe(acc, n);
+                            update_active(acc);
+                            update_congestion(acc);
 
                             if (_on_bytes_written)
                                 _on_bytes_written(acc.id, res.n);
@@ -167,6 +448,8 @@ private:
                         break;
                 }
             }
+
+            _active_cursor = nullptr;
         } while (stopwatch.current_count() < limit.count());
     }
 
@@ -178,6 +461,12 @@ public:
 
     void remove_later (socket_id id)
     {
+        auto acc = locate_account(id);
+
+        // Account will not be visited by the send pass anymore
+        if (acc != nullptr)
+            unlink_active(*acc);
+
         _removable.push_back(id);
     }
 
@@ -185,6 +474,13 @@ public:
     {
         if (!_removable.empty()) {
             for (auto id: _removable) {
+                auto acc = locate_account(id);
+
+                if (acc != nullptr) {
+                    unlink_active(*acc);
+                    _remain_bytes -= acc->remain_bytes;
+                }
+
                 WriterPoller::remove(id);
                 _accounts.erase(id);
             }
@@ -198,34 +494,178 @@ public:
         return _remain_bytes;
     }
 
-    void enqueue (socket_id id, int priority, char const * data, std::size_t len)
+    /**
+     * Number of bytes in the output queue of the socket @a id.
+     */
+    std::uint64_t remain_bytes (socket_id id) const noexcept
+    {
+        auto pos = _accounts.find(id);
+        return pos != _accounts.end() ? pos->second.remain_bytes : 0;
+    }
+
+    /**
+     * Checks if there are sockets ready for writing with data to send.
+     */
+    bool has_active () const noexcept
+    {
+        return _active_head != nullptr;
+    }
+
+    /**
+     * Enqueues the data for writing.
+     *
+     * @return @c false if the data is rejected by the overflow policy of the @a priority.
+     */
+    bool enqueue (socket_id id, int priority, char const * data, std::size_t len)
     {
         if (len == 0)
-            return;
+            return true;
 
         auto acc = ensure_account(id);
+
+        if (!admit(*acc, priority, len))
+            return false;
+
         acc->q.enqueue(priority, data, len);
         _remain_bytes += len;
+        acc->remain_bytes += len;
+        start_probe(*acc);
+        update_active(*acc);
+        update_congestion(*acc);
+        return true;
     }
 
-    void enqueue (socket_id id, char const * data, std::size_t len)
+    bool enqueue (socket_id id, char const * data, std::size_t len)
     {
-        enqueue(id, 0, data, len);
+        return enqueue(id, 0, data, len);
     }
 
-    void enqueue (socket_id id, int priority, std::vector<char> && data)
+    bool enqueue (socket_id id, int priority, std::vector<char> && data)
     {
         if (data.empty())
-            return;
+            return true;
 
         auto acc = ensure_account(id);
+
+        if (!admit(*acc, priority, data.size()))
+            return false;
+
         _remain_bytes += data.size();
+        acc->remain_bytes += data.size();
         acc->q.enqueue(priority, std::move(data));
+        start_probe(*acc);
+        update_active(*acc);
+        update_congestion(*acc);
+        return true;
+    }
+
+    bool enqueue (socket_id id, std::vector<char> && data)
+    {
+        return enqueue(id, 0, std::move(data));
+    }
+
+    /**
+     * Enqueues the reference to the @a data, so the same bytes can be enqueued for many sockets
+     * without copying.
+     *
+     * @return @c false if the data is rejected by the overflow policy of the @a priority.
+     */
+    bool enqueue (socket_id id, int priority, shared_buffer const & data)
+    {
+        if (data.empty())
+            return true;
+
+        auto acc = ensure_account(id);
+
+        if (!admit(*acc, priority, data.size()))
+            return false;
+
+        _remain_bytes += data.size();
+        acc->remain_bytes += data.size();
+        acc->q.enqueue(priority, data);
+        start_probe(*acc);
+        update_active(*acc);
+        update_congestion(*acc);
+        return true;
+    }
+
+    bool enqueue (socket_id id, shared_buffer const & data)
+    {
+        return enqueue(id, 0, data);
+    }
+
+    /**
+     * Sets the water marks of the output queues of all sockets (existing and new): socket becomes
+     * congested when the number of bytes in its queue reaches @a high_mark, and drained when it
+     * falls to @a low_mark. Zero @a high_mark disables the congestion tracking.
+     */
+    void set_water_marks (std::uint64_t high_mark, std::uint64_t low_mark)
+    {
+        PFS__TERMINATE(high_mark == 0 || low_mark < high_mark, "writer_pool: low water mark must be less than high one");
+
+        _high_mark = high_mark;
+        _low_mark = low_mark;
+
+        for (auto & x: _accounts) {
+            x.second.high_mark = high_mark;
+            x.second.low_mark = low_mark;
+            update_congestion(x.second);
+        }
+    }
+
+    /**
+     * Sets the water marks of the output queue of the socket @a id only.
+     *
+     * @return @c false if the socket is not found.
+     */
+    bool set_water_marks (socket_id id, std::uint64_t high_mark, std::uint64_t low_mark)
+    {
+        PFS__TERMINATE(high_mark == 0 || low_mark < high_mark, "writer_pool: low water mark must be less than high one");
+
+        auto acc = locate_account(id);
+
+        if (acc == nullptr)
+            return false;
+
+        acc->high_mark = high_mark;
+        acc->low_mark = low_mark;
+        update_congestion(*acc);
+        return true;
     }
 
-    void enqueue (socket_id id, std::vector<char> && data)
+    bool is_congested (socket_id id) const
     {
-        enqueue(id, 0, std::move(data));
+        auto pos = _accounts.find(id);
+        return pos != _accounts.end() && pos->second.congested;
+    }
+
+    /**
+     * Limits the number of bytes of the @a priority (not sent yet) in the output queue of each
+     * socket. The message that overflows the @a limit is handled according to the @a policy.
+     * Zero @a limit removes the limit.
+     */
+    void set_overflow_policy (int priority, std::size_t limit, overflow_policy_enum policy)
+    {
+        PFS__TERMINATE(priority >= 0 && priority < priority_count(), "writer_pool: priority is out of range");
+
+        if (_limits.empty())
+            _limits.resize(priority_count());
+
+        _limits[priority].limit = limit;
+        _limits[priority].policy = policy;
+    }
+
+    /**
+     * Overflow policy applied to the @a priority (overflow_policy_enum::accept if it is not limited).
+     */
+    overflow_policy_enum overflow_policy (int priority) const
+    {
+        PFS__TERMINATE(priority >= 0 && priority < priority_count(), "writer_pool: priority is out of range");
+
+        if (_limits.empty() || _limits[priority].limit == 0)
+            return overflow_policy_enum::accept;
+
+        return _limits[priority].policy;
     }
 
     /**
@@ -245,6 +685,53 @@ public:
         return *this;
     }
 
+    /**
+     * Sets a callback for the send queue delay samples: time from the enqueue of the message until
+     * the message and the data queued before it are written (for the queue with priorities it is
+     * the time to write the same number of bytes of any priority). One message per socket is
+     * sampled at a time, the sample is discarded if the overflow policy drops the messages.
+     * Callback signature is void(socket_id, std::chrono::microseconds).
+     */
+    template <typename F>
+    writer_pool & on_queue_delay (F && f)
+    {
+        _on_queue_delay = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Sets a callback for the socket that reaches the high water mark.
+     * Callback signature is void(socket_id).
+     */
+    template <typename F>
+    writer_pool & on_congested (F && f)
+    {
+        _on_congested = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Sets a callback for the congested socket that falls to the low water mark.
+     * Callback signature is void(socket_id).
+     */
+    template <typename F>
+    writer_pool & on_drained (F && f)
+    {
+        _on_drained = std::forward<F>(f);
+        return *this;
+    }
+
+    /**
+     * Sets a callback for the messages dropped or rejected by the overflow policy.
+     * Callback signature is void(socket_id, int priority, std::size_t size).
+     */
+    template <typename F>
+    writer_pool & on_message_dropped (F && f)
+    {
+        _on_message_dropped = std::forward<F>(f);
+        return *this;
+    }
+
     template <typename F>
     writer_pool & on_locate_socket (F && f)
     {
@@ -252,6 +739,40 @@ public:
         return *this;
     }
 
+    /**
+     * Sets a callback to initialize the output queues (e.g. priority weights). It is applied to
+     * the existing queues immediately and to the new ones on the account creation.
+     * Callback signature is void(WriterQueue &).
+     */
+    template <typename F>
+    writer_pool & on_queue_setup (F && f)
+    {
+        _queue_setup = std::forward<F>(f);
+
+        for (auto & x: _accounts)
+            _queue_setup(x.second.q);
+
+        return *this;
+    }
+
+    /**
+     * Applies @a f to the output queue of the socket @a id only.
+     * Callback signature is void(WriterQueue &).
+     *
+     * @return @c false if the socket is not found.
+     */
+    template <typename F>
+    bool setup_queue (socket_id id, F && f)
+    {
+        auto acc = locate_account(id);
+
+        if (acc == nullptr)
+            return false;
+
+        f(acc->q);
+        return true;
+    }
+
     /**
      * @resturn Number of sockets waiting for writing.
      */
@@ -5,12 +5,17 @@
 //
 // Changelog:
 //      2025.01.08 Initial version.
+//      2026.10.16 Frames are represented by views to queued data now.
+//      2026.10.17 Added size() and drop_front().
+//                 Added enqueue of the shared buffers without copying.
+//                 shift() returns the number of bytes released.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "frame_view.hpp"
 #include "namespace.hpp"
+#include "shared_buffer.hpp"
 #include <algorithm>
-#include <list>
-#include <queue>
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -21,13 +26,25 @@ class writer_queue
     struct elem
     {
         std::vector<char> b;
+        shared_buffer s; // Used instead of `b` if not empty
         std::size_t cursor;
+
+        char const * data () const noexcept
+        {
+            return s.empty() ? b.data() : s.data();
+        }
+
+        std::size_t size () const noexcept
+        {
+            return s.empty() ? b.size() : s.size();
+        }
     };
 
-    using queue_type = std::queue<elem, std::list<elem>>;
+    using queue_type = std::deque<elem>;
 
 private:
     queue_type _q;
+    std::size_t _size {0}; // Number of bytes not sent yet
 
 public:
     writer_queue () {}
@@ -35,10 +52,7 @@ public:
 public:
     void enqueue (int /*priority*/, char const * data, std::size_t len)
     {
-        if (len == 0)
-            return;
-
-        _q.push(elem{std::vector<char>{data, data + len}, 0});
+        enqueue(data, len);
     }
 
     void enqueue (char const * data, std::size_t len)
@@ -46,23 +60,39 @@ public:
         if (len == 0)
             return;
 
-        _q.push(elem{std::vector<char>{data, data + len}, 0});
+        _q.push_back(elem{std::vector<char>{data, data + len}, shared_buffer{}, 0});
+        _size += len;
     }
 
     void enqueue (int /*priority*/, std::vector<char> && data)
+    {
+        enqueue(std::move(data));
+    }
+
+    void enqueue (std::vector<char> && data)
     {
         if (data.empty())
             return;
 
-        _q.push(elem{std::move(data), 0});
+        _size += data.size();
+        _q.push_back(elem{std::move(data), shared_buffer{}, 0});
     }
 
-    void enqueue (std::vector<char> && data)
+    void enqueue (int /*priority*/, shared_buffer const & data)
+    {
+        enqueue(data);
+    }
+
+    /**
+     * Enqueues the reference to the @a data (bytes are not copied).
+     */
+    void enqueue (shared_buffer const & data)
     {
         if (data.empty())
             return;
 
-        _q.push(elem{std::move(data), 0});
+        _size += data.size();
+        _q.push_back(elem{std::vector<char>{}, data, 0});
     }
 
     bool empty () const
@@ -70,24 +100,78 @@ public:
         return _q.empty();
     }
 
-    std::vector<char> frame (std::size_t frame_size) const
+    /**
+     * Number of bytes not sent yet.
+     */
+    std::size_t size (int /*priority*/) const
     {
-        if (empty())
-            return std::vector<char>{};
+        return _size;
+    }
 
-        auto & front = _q.front();
-        auto size = (std::min)(front.b.size() - front.cursor, frame_size);
-        auto first = front.b.data() + front.cursor;
-        return std::vector<char>(first, first + size);
+    /**
+     * Drops the oldest message not sent yet (even partially).
+     *
+     * @return Size of the dropped message or zero if there is no message to drop.
+     */
+    std::size_t drop_front (int /*priority*/)
+    {
+        auto pos = _q.begin();
+
+        if (pos != _q.end() && pos->cursor > 0)
+            ++pos;
+
+        if (pos == _q.end())
+            return 0;
+
+        auto len = pos->size();
+        _q.erase(pos);
+        _size -= len;
+
+        return len;
     }
 
-    void shift (std::size_t n)
+    /**
+     * Fills @a fv with views to the queued data without copying it. The view contains at most
+     * @a frame_count chunks (one per queued message) with total size not greater than
+     * @a frame_size * @a frame_count bytes.
+     */
+    void frames (std::size_t frame_size, std::size_t frame_count, frame_view & fv)
     {
-        auto & front = _q.front();
-        front.cursor += n;
+        fv.clear();
+
+        auto limit = frame_size * frame_count;
+
+        for (auto pos = _q.cbegin(); pos != _q.cend() && fv.count() < frame_count; ++pos) {
+            auto size = (std::min)(pos->size() - pos->cursor, limit - fv.size());
+            fv.append(pos->data() + pos->cursor, size);
+
+            if (fv.size() == limit)
+                break;
+        }
+    }
+
+    /**
+     * Removes @a n bytes (sent) from the head of the queue.
+     *
+     * @return Number of bytes released.
+     */
+    std::size_t shift (std::size_t n)
+    {
+        std::size_t released = 0;
+
+        while (n > 0 && !_q.empty()) {
+            auto & front = _q.front();
+            auto size = (std::min)(front.size() - front.cursor, n);
+            front.cursor += size;
+            _size -= size;
+            n -= size;
+            released += size;
+
+            if (front.cursor >= front.size())
+                _q.pop_front();
+        }
 
-        if (front.cursor >= front.b.size())
-            _q.pop();
+        return released;
     }
 
 public: // static
@@ -32,16 +32,37 @@ if (MSVC)
 endif()
 
 target_sources(netty PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/src/checksum.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/compression.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/error.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/inet4_addr.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/socket4_addr.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/startup.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/timing_wheel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/posix/inet_socket.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/posix/tcp_listener.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/posix/tcp_socket.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/posix/udp_receiver.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/posix/udp_socket.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/src/posix/udp_sender.cpp)
+    ${CMAKE_CURRENT_LIST_DIR}/src/posix/udp_sender.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/posix/wakeup_socket.cpp)
+
+# Optional compression backends (see compression.hpp)
+check_include_file("lz4.h" __has_lz4)
+
+if (__has_lz4)
+    target_compile_definitions(netty PUBLIC "NETTY__LZ4_ENABLED=1")
+    target_link_libraries(netty PRIVATE lz4)
+    set_target_properties(netty PROPERTIES NETTY__LZ4_ENABLED ON)
+endif()
+
+check_include_file("zstd.h" __has_zstd)
+
+if (__has_zstd)
+    target_compile_definitions(netty PUBLIC "NETTY__ZSTD_ENABLED=1")
+    target_link_libraries(netty PRIVATE zstd)
+    set_target_properties(netty PROPERTIES NETTY__ZSTD_ENABLED ON)
+endif()
 
 if (NETTY__ENABLE_UTILS)
     if (UNIX OR ANDROID)
@@ -118,10 +139,20 @@ if (UNIX OR ANDROID)
             ${CMAKE_CURRENT_LIST_DIR}/src/linux/epoll_poller.cpp
             ${CMAKE_CURRENT_LIST_DIR}/src/linux/listener_poller.cpp
             ${CMAKE_CURRENT_LIST_DIR}/src/linux/reader_poller.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/src/linux/shared_epoll_poller.cpp
 #            ${CMAKE_CURRENT_LIST_DIR}/src/linux/server_poller.cpp
             ${CMAKE_CURRENT_LIST_DIR}/src/linux/writer_poller.cpp)
         target_compile_definitions(netty PUBLIC "NETTY__EPOLL_ENABLED=1")
         set_target_properties(netty PROPERTIES NETTY__EPOLL_ENABLED ON)
+
+        # io_uring pollers are specializations in the epoll poller sources
+        check_include_file("linux/io_uring.h" __has_io_uring)
+
+        if (__has_io_uring)
+            target_sources(netty PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/linux/io_uring_poller.cpp)
+            target_compile_definitions(netty PUBLIC "NETTY__IO_URING_ENABLED=1")
+            set_target_properties(netty PROPERTIES NETTY__IO_URING_ENABLED ON)
+        endif()
     endif()
 
     check_include_file("libmnl/libmnl.h" __has_libmnl)
@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/netty/checksum.hpp"
+#include <pfs/crc32.hpp>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#   define NETTY__CRC32C_SSE42 1
+#   include <nmmintrin.h>
+#   if _MSC_VER
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#   define NETTY__CRC32C_ARMV8 1
+#   include <arm_acle.h>
+#endif
+
+NETTY__NAMESPACE_BEGIN
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CRC-32C
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct crc32c_table
+{
+    std::uint32_t t[256];
+
+    crc32c_table ()
+    {
+        // Reversed Castagnoli polynomial
+        constexpr std::uint32_t poly = 0x82F63B78;
+
+        for (std::uint32_t i = 0; i < 256; i++) {
+            auto c = i;
+
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+
+            t[i] = c;
+        }
+    }
+};
+
+std::uint32_t crc32c_sw (std::uint32_t crc, unsigned char const * p, std::size_t len) noexcept
+{
+    static crc32c_table const table;
+
+    while (len-- > 0)
+        crc = table.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+    return crc;
+}
+
+#if NETTY__CRC32C_SSE42
+
+#if !_MSC_VER
+__attribute__((target("sse4.2")))
+#endif
+std::uint32_t crc32c_hw (std::uint32_t crc, unsigned char const * p, std::size_t len) noexcept
+{
+    std::uint64_t c = crc;
+
+    for (; len >= 8; len -= 8, p += 8) {
+        std::uint64_t v;
+        std::memcpy(& v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+
+    auto c32 = static_cast<std::uint32_t>(c);
+
+    while (len-- > 0)
+        c32 = _mm_crc32_u8(c32, *p++);
+
+    return c32;
+}
+
+bool cpu_has_sse42 () noexcept
+{
+#if _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+#elif NETTY__CRC32C_ARMV8
+
+std::uint32_t crc32c_hw (std::uint32_t crc, unsigned char const * p, std::size_t len) noexcept
+{
+    for (; len >= 8; len -= 8, p += 8) {
+        std::uint64_t v;
+        std::memcpy(& v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+
+    while (len-- > 0)
+        crc = __crc32cb(crc, *p++);
+
+    return crc;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// xxHash64
+////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr std::uint64_t kPRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t kPRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t kPRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t kPRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t kPRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotl64 (std::uint64_t x, int r) noexcept
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+// Little-endian loads regardless of the host byte order
+inline std::uint64_t read64 (unsigned char const * p) noexcept
+{
+    return static_cast<std::uint64_t>(p[0])
+        | (static_cast<std::uint64_t>(p[1]) << 8)
+        | (static_cast<std::uint64_t>(p[2]) << 16)
+        | (static_cast<std::uint64_t>(p[3]) << 24)
+        | (static_cast<std::uint64_t>(p[4]) << 32)
+        | (static_cast<std::uint64_t>(p[5]) << 40)
+        | (static_cast<std::uint64_t>(p[6]) << 48)
+        | (static_cast<std::uint64_t>(p[7]) << 56);
+}
+
+inline std::uint32_t read32 (unsigned char const * p) noexcept
+{
+    return static_cast<std::uint32_t>(p[0])
+        | (static_cast<std::uint32_t>(p[1]) << 8)
+        | (static_cast<std::uint32_t>(p[2]) << 16)
+        | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t xxh64_round (std::uint64_t acc, std::uint64_t input) noexcept
+{
+    acc += input * kPRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * kPRIME64_1;
+}
+
+inline std::uint64_t xxh64_merge_round (std::uint64_t acc, std::uint64_t val) noexcept
+{
+    acc ^= xxh64_round(0, val);
+    return acc * kPRIME64_1 + kPRIME64_4;
+}
+
+} // namespace
+
+bool crc32c_accelerated () noexcept
+{
+#if NETTY__CRC32C_SSE42
+    static bool const accelerated = cpu_has_sse42();
+    return accelerated;
+#elif NETTY__CRC32C_ARMV8
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::uint32_t crc32c (char const * data, std::size_t len, std::uint32_t crc) noexcept
+{
+    auto p = reinterpret_cast<unsigned char const *>(data);
+    crc = ~crc;
+
+#if NETTY__CRC32C_SSE42 || NETTY__CRC32C_ARMV8
+    if (crc32c_accelerated())
+        return ~crc32c_hw(crc, p, len);
+#endif
+
+    return ~crc32c_sw(crc, p, len);
+}
+
+std::uint64_t xxh64 (char const * data, std::size_t len, std::uint64_t seed) noexcept
+{
+    auto p = reinterpret_cast<unsigned char const *>(data);
+    auto end = p + len;
+    std::uint64_t h = 0;
+
+    if (len >= 32) {
+        auto limit = end - 32;
+        std::uint64_t v1 = seed + kPRIME64_1 + kPRIME64_2;
+        std::uint64_t v2 = seed + kPRIME64_2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - kPRIME64_1;
+
+        do {
+            v1 = xxh64_round(v1, read64(p)); p += 8;
+            v2 = xxh64_round(v2, read64(p)); p += 8;
+            v3 = xxh64_round(v3, read64(p)); p += 8;
+            v4 = xxh64_round(v4, read64(p)); p += 8;
+        } while (p <= limit);
+
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh64_merge_round(h, v1);
+        h = xxh64_merge_round(h, v2);
+        h = xxh64_merge_round(h, v3);
+        h = xxh64_merge_round(h, v4);
+    } else {
+        h = seed + kPRIME64_5;
+    }
+
+    h += static_cast<std::uint64_t>(len);
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= xxh64_round(0, read64(p));
+        h = rotl64(h, 27) * kPRIME64_1 + kPRIME64_4;
+    }
+
+    if (p + 4 <= end) {
+        h ^= static_cast<std::uint64_t>(read32(p)) * kPRIME64_1;
+        h = rotl64(h, 23) * kPRIME64_2 + kPRIME64_3;
+        p += 4;
+    }
+
+    for (; p < end; p++) {
+        h ^= static_cast<std::uint64_t>(*p) * kPRIME64_5;
+        h = rotl64(h, 11) * kPRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= kPRIME64_2;
+    h ^= h >> 29;
+    h *= kPRIME64_3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+std::uint32_t checksum (checksum_enum alg, char const * data, std::size_t len) noexcept
+{
+    switch (alg) {
+        case checksum_enum::crc32c:
+            return crc32c(data, len);
+
+        case checksum_enum::xxh64: {
+            auto h = xxh64(data, len);
+            return static_cast<std::uint32_t>(h ^ (h >> 32));
+        }
+
+        case checksum_enum::crc32:
+        default:
+            break;
+    }
+
+    return static_cast<std::uint32_t>(pfs::crc32_of_ptr(data, len));
+}
+
+checksum_enum select_checksum (std::uint8_t peer_checksums) noexcept
+{
+    if (crc32c_accelerated() && (peer_checksums & checksum_bit(checksum_enum::crc32c)))
+        return checksum_enum::crc32c;
+
+    if (peer_checksums & checksum_bit(checksum_enum::xxh64))
+        return checksum_enum::xxh64;
+
+    if (peer_checksums & checksum_bit(checksum_enum::crc32c))
+        return checksum_enum::crc32c;
+
+    return checksum_enum::crc32;
+}
+
+NETTY__NAMESPACE_END
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/netty/compression.hpp"
+#include <limits>
+
+#if NETTY__LZ4_ENABLED
+#   include <lz4.h>
+#endif
+
+#if NETTY__ZSTD_ENABLED
+#   include <zstd.h>
+#endif
+
+NETTY__NAMESPACE_BEGIN
+
+constexpr std::size_t compressor::max_size;
+
+std::uint8_t supported_compressions () noexcept
+{
+    std::uint8_t result = 0;
+
+#if NETTY__LZ4_ENABLED
+    result |= compression_bit(compression_enum::lz4);
+#endif
+
+#if NETTY__ZSTD_ENABLED
+    result |= compression_bit(compression_enum::zstd);
+#endif
+
+    return result;
+}
+
+compressor::~compressor ()
+{
+#if NETTY__ZSTD_ENABLED
+    if (_zstd_cctx != nullptr)
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx *>(_zstd_cctx));
+
+    if (_zstd_dctx != nullptr)
+        ZSTD_freeDCtx(static_cast<ZSTD_DCtx *>(_zstd_dctx));
+#endif
+}
+
+bool compressor::compress (compression_enum alg, char const * data, std::size_t len
+    , std::vector<char> & out, int level)
+{
+    (void)data;
+    (void)level;
+    (void)out;
+
+    // Compressed data must be smaller than the source, so the capacity of the output is limited
+    // by len - 1: compressors stop as soon as the output exceeds it.
+    if (len < 2 || len > max_size)
+        return false;
+
+    switch (alg) {
+#if NETTY__LZ4_ENABLED
+        case compression_enum::lz4: {
+            if (_lz4_state.empty())
+                _lz4_state.resize(static_cast<std::size_t>(LZ4_sizeofState()));
+
+            out.resize(len - 1);
+
+            auto n = LZ4_compress_fast_extState(_lz4_state.data(), data, out.data()
+                , static_cast<int>(len), static_cast<int>(out.size()), level > 0 ? level : 1);
+
+            if (n <= 0)
+                return false;
+
+            out.resize(static_cast<std::size_t>(n));
+            return true;
+        }
+#endif
+
+#if NETTY__ZSTD_ENABLED
+        case compression_enum::zstd: {
+            if (_zstd_cctx == nullptr)
+                _zstd_cctx = ZSTD_createCCtx();
+
+            if (_zstd_cctx == nullptr)
+                return false;
+
+            out.resize(len - 1);
+
+            auto n = ZSTD_compressCCtx(static_cast<ZSTD_CCtx *>(_zstd_cctx), out.data(), out.size()
+                , data, len, level);
+
+            if (ZSTD_isError(n))
+                return false;
+
+            out.resize(n);
+            return true;
+        }
+#endif
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+bool compressor::decompress (compression_enum alg, char const * data, std::size_t len
+    , std::size_t original_size, std::vector<char> & out)
+{
+    (void)data;
+    (void)out;
+
+    if (original_size > max_size || len > static_cast<std::size_t>((std::numeric_limits<int>::max)()))
+        return false;
+
+    switch (alg) {
+#if NETTY__LZ4_ENABLED
+        case compression_enum::lz4: {
+            out.resize(original_size);
+
+            auto n = LZ4_decompress_safe(data, out.data(), static_cast<int>(len)
+                , static_cast<int>(original_size));
+
+            return n >= 0 && static_cast<std::size_t>(n) == original_size;
+        }
+#endif
+
+#if NETTY__ZSTD_ENABLED
+        case compression_enum::zstd: {
+            if (_zstd_dctx == nullptr)
+                _zstd_dctx = ZSTD_createDCtx();
+
+            if (_zstd_dctx == nullptr)
+                return false;
+
+            out.resize(original_size);
+
+            auto n = ZSTD_decompressDCtx(static_cast<ZSTD_DCtx *>(_zstd_dctx), out.data(), out.size()
+                , data, len);
+
+            return !ZSTD_isError(n) && n == original_size;
+        }
+#endif
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+NETTY__NAMESPACE_END
@@ -5,13 +5,22 @@
 //
 // Changelog:
 //      2023.01.11 Initial version.
+//      2026.10.16 Added constructor with shared backend.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "netty/connecting_poller.hpp"
 #include <pfs/i18n.hpp>
+#include <pfs/assert.hpp>
 
 NETTY__NAMESPACE_BEGIN
 
+template <typename Backend>
+connecting_poller<Backend>::connecting_poller (std::shared_ptr<Backend> backend)
+    : connecting_poller()
+{
+    PFS__TERMINATE(backend == nullptr, "poller backend can not be shared");
+}
+
 template <typename Backend>
 connecting_poller<Backend>::~connecting_poller () = default;
 
@@ -213,6 +213,51 @@ send_result enet_socket::send (char const * data, int len, error * perr)
     return send_result{send_status::good, static_cast<std::uint64_t>(len)};
 }
 
+send_result enet_socket::send (frame_chunk const * chunks, int count, error * perr)
+{
+    if (enet_peer_has_outgoing_commands(_peer))
+        return send_result{netty::send_status::again, 0};
+
+    std::size_t len = 0;
+
+    for (int i = 0; i < count; i++)
+        len += chunks[i].size;
+
+    // Data is copied by ENet into the packet anyway, so gather chunks directly into it.
+    ENetPacket * packet = enet_packet_create(nullptr, len, ENET_PACKET_FLAG_RELIABLE);
+
+    if (packet == nullptr) {
+        pfs::throw_or(perr, error {
+            std::make_error_code(std::errc::not_enough_memory)
+            , tr::_("create packet for sending failure")
+            });
+
+        return send_result{send_status::failure, 0};
+    }
+
+    auto p = reinterpret_cast<char *>(packet->data);
+
+    for (int i = 0; i < count; i++) {
+        std::memcpy(p, chunks[i].data, chunks[i].size);
+        p += chunks[i].size;
+    }
+
+    auto rc = enet_peer_send(_peer, 0, packet);
+
+    if (rc < 0) {
+        enet_packet_destroy(packet);
+
+        pfs::throw_or(perr, error {
+            errc::socket_error
+            , tr::_("send packet failure")
+            });
+
+        return send_result{send_status::failure, 0};
+    }
+
+    return send_result{send_status::good, static_cast<std::uint64_t>(len)};
+}
+
 conn_status enet_socket::connect (socket4_addr const & saddr, error * perr)
 {
     if (_host == nullptr) {
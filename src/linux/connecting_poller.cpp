@@ -5,14 +5,104 @@
 //
 // Changelog:
 //      2023.01.10 Initial version.
+//      2026.10.16 Added connecting poller specialization for shared epoll.
+//                 Added connecting poller specialization for io_uring.
+//      2026.10.17 io_uring connecting poller connects by the backend.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../connecting_poller_impl.hpp"
 #include "netty/linux/epoll_poller.hpp"
+#include "netty/linux/shared_epoll_poller.hpp"
+
 #include <pfs/i18n.hpp>
 #include <sys/socket.h>
 
+#if NETTY__IO_URING_ENABLED
+#   include "netty/linux/io_uring_poller.hpp"
+#endif
+
 NETTY__NAMESPACE_BEGIN
 
+/**
+ * @return @c true if socket is connected.
+ */
+template <typename ConnectingPoller>
+static bool process_event (ConnectingPoller & poller, epoll_event const & ev)
+{
+    // 1. Occured while tcp socket attempts to connect to non-existance server socket (connection_refused)
+    // 2. No route to host
+    // 3. ... ?
+    if (ev.events & EPOLLERR) {
+        int error_val = 0;
+        socklen_t len = sizeof(error_val);
+        auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
+
+        if (rc != 0) {
+            poller.on_failure(ev.data.fd
+                , error {
+                      make_error_code(pfs::errc::system_error)
+                    , tr::f_("get socket ({}) option failure: {} (errno={})"
+                        , ev.data.fd, pfs::system_error_text(), errno)
+                });
+        } else {
+            switch (error_val) {
+                case 0: // No error
+                    poller.on_failure(ev.data.fd, error {
+                          make_error_code(pfs::errc::unexpected_error)
+                        , tr::f_("EPOLLERR event happend, but no error occurred on socket: {}"
+                        , ev.data.fd)
+                    });
+                    break;
+
+                case EHOSTUNREACH:
+                    poller.connection_refused(ev.data.fd, connection_refused_reason::unreachable);
+                    break;
+
+                case ECONNREFUSED:
+                    poller.connection_refused(ev.data.fd, connection_refused_reason::other);
+                    break;
+
+                // Connection reset by peer
+                case ECONNRESET:
+                    poller.connection_refused(ev.data.fd, connection_refused_reason::reset);
+                    break;
+
+                case ETIMEDOUT:
+                    poller.connection_refused(ev.data.fd, connection_refused_reason::timeout);
+                    break;
+
+                default:
+                    poller.on_failure(ev.data.fd, error {
+                          make_error_code(pfs::errc::unexpected_error)
+                        , tr::f_("unhandled error value returned by `getsockopt`: {} (socket={})"
+                            , error_val, ev.data.fd)
+                    });
+                    break;
+            }
+        }
+
+        return false;
+    }
+
+    // Hang up (output only).
+    //
+    // Contexts:
+    // a. Attempt to connect to defunct server address/port
+    // b. ...
+    if (ev.events & (EPOLLHUP | EPOLLRDHUP)) {
+        poller.connection_refused(ev.data.fd, connection_refused_reason::other);
+        return false;
+    }
+
+    // Writing is now possible, though a write larger than the available space
+    // in a socket or pipe will still block (unless O_NONBLOCK is set).
+    if (ev.events & (EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND)) {
+        poller.connected(ev.data.fd);
+        return true;
+    }
+
+    return false;
+}
+
 template <>
 connecting_poller<linux_os::epoll_poller>::connecting_poller ()
     : _rep(new linux_os::epoll_poller(EPOLLERR | EPOLLHUP | EPOLLRDHUP | EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND))
@@ -38,77 +128,8 @@ int connecting_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds m
 
             n--;
 
-            // 1. Occured while tcp socket attempts to connect to non-existance server socket (connection_refused)
-            // 2. No route to host
-            // 3. ... ?
-            if (ev.events & EPOLLERR) {
-                int error_val = 0;
-                socklen_t len = sizeof(error_val);
-                auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
-
-                if (rc != 0) {
-                    on_failure(ev.data.fd
-                        , error {
-                              make_error_code(pfs::errc::system_error)
-                            , tr::f_("get socket ({}) option failure: {} (errno={})"
-                                , ev.data.fd, pfs::system_error_text(), errno)
-                        });
-                } else {
-                    switch (error_val) {
-                        case 0: // No error
-                            on_failure(ev.data.fd, error {
-                                  make_error_code(pfs::errc::unexpected_error)
-                                , tr::f_("EPOLLERR event happend, but no error occurred on socket: {}"
-                                , ev.data.fd)
-                            });
-                            break;
-
-                        case EHOSTUNREACH:
-                            connection_refused(ev.data.fd, connection_refused_reason::unreachable);
-                            break;
-
-                        case ECONNREFUSED:
-                            connection_refused(ev.data.fd, connection_refused_reason::other);
-                            break;
-
-                        // Connection reset by peer
-                        case ECONNRESET:
-                            connection_refused(ev.data.fd, connection_refused_reason::reset);
-                            break;
-
-                        case ETIMEDOUT:
-                            connection_refused(ev.data.fd, connection_refused_reason::timeout);
-                            break;
-
-                        default:
-                            on_failure(ev.data.fd, error {
-                                  make_error_code(pfs::errc::unexpected_error)
-                                , tr::f_("unhandled error value returned by `getsockopt`: {} (socket={})"
-                                    , error_val, ev.data.fd)
-                            });
-                            break;
-                    }
-                }
-
-                continue;
-            }
-
-            // Hang up (output only).
-            //
-            // Contexts:
-            // a. Attempt to connect to defunct server address/port
-            // b. ...
-            if (ev.events & (EPOLLHUP | EPOLLRDHUP)) {
-                connection_refused(ev.data.fd, connection_refused_reason::other);
-                continue;
-            }
-
-            // Writing is now possible, though a write larger than the available space
-            // in a socket or pipe will still block (unless O_NONBLOCK is set).
-            if (ev.events & (EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND)) {
+            if (process_event(*this, ev))
                 res++;
-                connected(ev.data.fd);
-            }
         }
     }
 
@@ -117,4 +138,107 @@ int connecting_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds m
 
 template class connecting_poller<linux_os::epoll_poller>;
 
+template <>
+connecting_poller<linux_os::shared_epoll_poller>::connecting_poller (std::shared_ptr<linux_os::shared_epoll_poller> backend)
+    : _rep(backend != nullptr ? std::move(backend) : std::make_shared<linux_os::shared_epoll_poller>())
+{
+    _rep->connecting_event = [this] (epoll_event const & ev) {
+        process_event(*this, ev);
+    };
+}
+
+template <>
+connecting_poller<linux_os::shared_epoll_poller>::connecting_poller ()
+    : connecting_poller(std::shared_ptr<linux_os::shared_epoll_poller>{})
+{}
+
+template <>
+void connecting_poller<linux_os::shared_epoll_poller>::add (socket_id sock, error * perr)
+{
+    _rep->add(sock, linux_os::shared_epoll_poller::connecting_role, perr);
+}
+
+template <>
+void connecting_poller<linux_os::shared_epoll_poller>::remove (socket_id sock, error * perr)
+{
+    _rep->remove(sock, linux_os::shared_epoll_poller::connecting_role, perr);
+}
+
+template <>
+bool connecting_poller<linux_os::shared_epoll_poller>::empty () const noexcept
+{
+    return _rep->empty(linux_os::shared_epoll_poller::connecting_role);
+}
+
+/**
+ * Events are dispatched by the reader poller if the backend is shared.
+ */
+template <>
+int connecting_poller<linux_os::shared_epoll_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    if (_rep.use_count() > 1)
+        return 0;
+
+    return _rep->poll(millis, perr);
+}
+
+template class connecting_poller<linux_os::shared_epoll_poller>;
+
+#if NETTY__IO_URING_ENABLED
+// Sockets are connected by the backend (see connect()).
+template <>
+connecting_poller<linux_os::io_uring_poller>::connecting_poller ()
+    : _rep(new linux_os::io_uring_poller(linux_os::io_uring_poller::operation_enum::connect))
+{
+    _rep->completed = [this] (linux_os::io_uring_poller::completion const & c) {
+        switch (-c.result) {
+            case 0:
+                connected(c.sock);
+                break;
+
+            case EHOSTUNREACH:
+            case ENETUNREACH:
+            case ENETDOWN:
+                connection_refused(c.sock, connection_refused_reason::unreachable);
+                break;
+
+            case ECONNREFUSED:
+                connection_refused(c.sock, connection_refused_reason::other);
+                break;
+
+            case ECONNRESET:
+                connection_refused(c.sock, connection_refused_reason::reset);
+                break;
+
+            case ETIMEDOUT:
+                connection_refused(c.sock, connection_refused_reason::timeout);
+                break;
+
+            default:
+                on_failure(c.sock, error {
+                      errc::socket_error
+                    , tr::f_("socket connect error: {} (socket={})"
+                        , pfs::system_error_text(-c.result), c.sock)
+                });
+                break;
+        }
+    };
+}
+
+template <>
+void connecting_poller<linux_os::io_uring_poller>::connect (socket_id sock, socket4_addr const & saddr
+    , error * perr)
+{
+    _rep->connect(sock, saddr, perr);
+}
+
+template <>
+int connecting_poller<linux_os::io_uring_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    return _rep->poll(millis, perr);
+}
+
+template class connecting_poller<linux_os::io_uring_poller>;
+#endif // NETTY__IO_URING_ENABLED
+
 NETTY__NAMESPACE_END
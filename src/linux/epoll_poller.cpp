@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2023.01.01 Initial version.
+//      2026.10.16 Added edge-triggered epoll_et_poller.
 ////////////////////////////////////////////////////////////////////////////////
 #include "netty/namespace.hpp"
 #include "netty/error.hpp"
@@ -144,6 +145,10 @@ bool epoll_poller::empty () const noexcept
     return events.size() == 0;
 }
 
+epoll_et_poller::epoll_et_poller (std::uint32_t observable_events)
+    : epoll_poller(observable_events | EPOLLET | EPOLLRDHUP)
+{}
+
 } // namespace linux_os
 
 NETTY__NAMESPACE_END
@@ -0,0 +1,858 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+//      2026.10.17 Cancelled requests of the registered sockets are re-queued (persistent) or
+//                 dropped (one-shot).
+//                 Reworked into completion-based I/O backend (receive into registered buffers,
+//                 send, accept and connect operations).
+////////////////////////////////////////////////////////////////////////////////
+#include "netty/namespace.hpp"
+#include "netty/error.hpp"
+#include "netty/linux/io_uring_poller.hpp"
+#include <pfs/assert.hpp>
+#include <pfs/endian.hpp>
+#include <pfs/i18n.hpp>
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace linux_os {
+
+static constexpr unsigned const RING_ENTRIES = 1024;
+
+// Sizes of the socket buffers owned by the backend
+static constexpr std::size_t const RECV_BUFFER_SIZE = 16384;
+static constexpr std::size_t const SEND_BUFFER_SIZE = 65536;
+
+// Number of the receive buffers registered in the ring
+static constexpr std::size_t const REGISTERED_BUFFERS = 64;
+
+// Maximum time to wait for the cancelled operations on destruction
+static constexpr std::chrono::milliseconds const CANCEL_TIMEOUT {1000};
+
+static inline unsigned load_acquire (unsigned const * p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release (unsigned * p, unsigned value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+static inline bool is_interrupted (int res) noexcept
+{
+    return res == -ECANCELED || res == -EAGAIN || res == -EINTR;
+}
+
+/**
+ * Accept failures caused by the aborted connection or by the lack of resources do not break the
+ * listener.
+ */
+static inline bool is_transient_accept_failure (int res) noexcept
+{
+    return is_interrupted(res) || res == -ECONNABORTED || res == -EPROTO || res == -EPERM
+        || res == -EMFILE || res == -ENFILE || res == -ENOBUFS || res == -ENOMEM;
+}
+
+/**
+ * State of the registered socket. Its address is the user data of the submitted operations, so the
+ * slot of the removed socket is kept until its operation is completed.
+ */
+struct slot
+{
+    int sock {-1};
+    char * buffer {nullptr};      // Buffer owned by the backend (recv and send operations)
+    std::unique_ptr<char[]> heap; // Buffer allocated if no registered one is available
+    int buffer_index {-1};        // Index of the registered buffer
+    std::size_t size {0};         // Number of bytes to write (send operation)
+    std::size_t offset {0};       // Number of bytes written (send operation)
+    bool in_flight {false};       // Operation is queued or submitted and not completed yet
+    bool removed {false};         // Socket is removed
+    bool notify {false};          // Write completion must be reported (see wait_for_write())
+    sockaddr_in addr;             // Peer address (accept and connect operations)
+    socklen_t addrlen {0};
+};
+
+class io_uring_poller::ring
+{
+public:
+    int fd {-1};
+    io_uring_params params;
+
+    void * sq_ptr {nullptr};
+    std::size_t sq_size {0};
+    void * cq_ptr {nullptr};
+    std::size_t cq_size {0};
+    io_uring_sqe * sqes {nullptr};
+    std::size_t sqes_size {0};
+
+    unsigned * sq_head {nullptr};
+    unsigned * sq_tail {nullptr};
+    unsigned * sq_mask {nullptr};
+    unsigned * sq_array {nullptr};
+    unsigned * cq_head {nullptr};
+    unsigned * cq_tail {nullptr};
+    unsigned * cq_mask {nullptr};
+    io_uring_cqe * cqes {nullptr};
+
+    unsigned local_tail {0}; // Submission queue tail not yet published to the kernel
+    unsigned pending {0};    // Number of queued requests not yet submitted
+
+    operation_enum op;
+    std::size_t buffer_size;
+
+    // Registered receive buffers
+    char * arena {nullptr};
+    std::size_t arena_size {0};
+    std::vector<int> free_buffers;
+
+    std::unordered_map<int, std::unique_ptr<slot>> slots;      // Registered sockets
+    std::unordered_map<slot *, std::unique_ptr<slot>> retired; // Removed sockets
+    std::size_t in_flight {0}; // Number of operations not completed yet
+
+    std::vector<slot *> rearm;  // Operations resubmitted after their completions are dispatched
+    std::vector<slot *> ready;  // Write completions to report (see wait_for_write())
+    std::vector<slot *> notified;
+    std::vector<std::pair<slot *, int>> reaped;
+
+public:
+    ring (operation_enum op)
+        : op(op)
+        , buffer_size(op == operation_enum::send ? SEND_BUFFER_SIZE : RECV_BUFFER_SIZE)
+    {
+        std::memset(& params, 0, sizeof(params));
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, & params));
+
+        if (fd < 0) {
+            throw error {
+                  errc::poller_error
+                , tr::_("io_uring setup failure")
+                , pfs::system_error_text()
+            };
+        }
+
+        if (!(params.features & IORING_FEAT_EXT_ARG)) {
+            ::close(fd);
+
+            throw error {
+                  errc::poller_error
+                , tr::_("io_uring: waiting with timeout is not supported by kernel (Linux 5.11+ required)")
+            };
+        }
+
+        sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            sq_size = (std::max)(sq_size, cq_size);
+            cq_size = sq_size;
+        }
+
+        sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+            , fd, IORING_OFF_SQ_RING);
+
+        if (sq_ptr == MAP_FAILED) {
+            sq_ptr = nullptr;
+            release();
+            throw error {errc::poller_error, tr::_("io_uring submission ring mapping failure")
+                , pfs::system_error_text()};
+        }
+
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            cq_ptr = sq_ptr;
+        } else {
+            cq_ptr = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+                , fd, IORING_OFF_CQ_RING);
+
+            if (cq_ptr == MAP_FAILED) {
+                cq_ptr = nullptr;
+                release();
+                throw error {errc::poller_error, tr::_("io_uring completion ring mapping failure")
+                    , pfs::system_error_text()};
+            }
+        }
+
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        auto p = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+            , fd, IORING_OFF_SQES);
+
+        if (p == MAP_FAILED) {
+            release();
+            throw error {errc::poller_error, tr::_("io_uring submission entries mapping failure")
+                , pfs::system_error_text()};
+        }
+
+        sqes = static_cast<io_uring_sqe *>(p);
+
+        auto sq = static_cast<char *>(sq_ptr);
+        sq_head  = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sq_tail  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask  = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+        auto cq = static_cast<char *>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        local_tail = *sq_tail;
+
+        if (op == operation_enum::recv)
+            register_buffers();
+    }
+
+    ~ring ()
+    {
+        cancel_all();
+        release();
+    }
+
+    void register_buffers ()
+    {
+        arena_size = REGISTERED_BUFFERS * buffer_size;
+        auto p = mmap(nullptr, arena_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        // Heap buffers are used
+        if (p == MAP_FAILED)
+            return;
+
+        std::vector<iovec> iov(REGISTERED_BUFFERS);
+
+        for (std::size_t i = 0; i < REGISTERED_BUFFERS; i++) {
+            iov[i].iov_base = static_cast<char *>(p) + i * buffer_size;
+            iov[i].iov_len = buffer_size;
+        }
+
+        auto rc = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iov.data()
+            , static_cast<unsigned>(iov.size()));
+
+        // Registration is not permitted (e.g. RLIMIT_MEMLOCK is exceeded), heap buffers are used
+        if (rc < 0) {
+            munmap(p, arena_size);
+            return;
+        }
+
+        arena = static_cast<char *>(p);
+
+        for (auto i = static_cast<int>(REGISTERED_BUFFERS); i > 0; i--)
+            free_buffers.push_back(i - 1);
+    }
+
+    void release ()
+    {
+        if (sqes != nullptr)
+            munmap(sqes, sqes_size);
+
+        if (cq_ptr != nullptr && cq_ptr != sq_ptr)
+            munmap(cq_ptr, cq_size);
+
+        if (sq_ptr != nullptr)
+            munmap(sq_ptr, sq_size);
+
+        if (fd >= 0)
+            ::close(fd);
+
+        // Registered buffers are unregistered by closing the ring
+        if (arena != nullptr)
+            munmap(arena, arena_size);
+
+        sqes = nullptr;
+        cq_ptr = nullptr;
+        sq_ptr = nullptr;
+        arena = nullptr;
+        fd = -1;
+    }
+
+    /**
+     * Cancels the operations in flight and waits for their completions, so the kernel does not
+     * access the buffers after they are released.
+     */
+    void cancel_all ()
+    {
+        error err;
+
+        for (auto & x: slots) {
+            if (x.second->in_flight)
+                queue_cancel(*x.second, & err);
+        }
+
+        for (auto & x: retired) {
+            if (x.second->in_flight)
+                queue_cancel(*x.second, & err);
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + CANCEL_TIMEOUT;
+
+        while (in_flight > 0 && !err && std::chrono::steady_clock::now() < deadline) {
+            __kernel_timespec ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 100000000;
+
+            io_uring_getevents_arg arg;
+            std::memset(& arg, 0, sizeof(arg));
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<std::uint64_t>(& ts);
+
+            if (!submit(1, & arg, & err))
+                break;
+
+            reap();
+
+            for (auto const & x: reaped)
+                complete_removed(x.second);
+        }
+    }
+
+    int enter (unsigned to_submit, unsigned min_complete, unsigned flags, void const * arg, std::size_t argsz)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz));
+    }
+
+    /**
+     * Publishes queued requests and submits them to the kernel.
+     */
+    bool submit (unsigned min_complete, io_uring_getevents_arg const * arg, error * perr)
+    {
+        store_release(sq_tail, local_tail);
+
+        unsigned flags = 0;
+
+        if (min_complete > 0)
+            flags |= IORING_ENTER_GETEVENTS;
+
+        if (arg != nullptr)
+            flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+
+        auto rc = enter(pending, min_complete, flags, arg, arg != nullptr ? sizeof(*arg) : 0);
+
+        if (rc < 0) {
+            // Timeout expired, interrupted or completion queue is full (must be reaped first):
+            // are not critical errors
+            if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN)
+                return true;
+
+            pfs::throw_or(perr, error {
+                  errc::poller_error
+                , tr::_("io_uring enter failure")
+                , pfs::system_error_text()
+            });
+
+            return false;
+        }
+
+        pending -= (std::min)(pending, static_cast<unsigned>(rc));
+        return true;
+    }
+
+    io_uring_sqe * get_sqe (error * perr)
+    {
+        // Submission queue is full, submit queued requests first
+        if (local_tail - load_acquire(sq_head) >= params.sq_entries) {
+            if (!submit(0, nullptr, perr))
+                return nullptr;
+
+            if (local_tail - load_acquire(sq_head) >= params.sq_entries) {
+                pfs::throw_or(perr, error {
+                      errc::poller_error
+                    , tr::_("io_uring submission queue overflow")
+                });
+
+                return nullptr;
+            }
+        }
+
+        auto index = local_tail & *sq_mask;
+        auto sqe = & sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sq_array[index] = index;
+        ++local_tail;
+        ++pending;
+
+        return sqe;
+    }
+
+    slot * ensure_slot (int sock)
+    {
+        auto pos = slots.find(sock);
+
+        if (pos != slots.end())
+            return pos->second.get();
+
+        std::unique_ptr<slot> s {new slot};
+        s->sock = sock;
+
+        if (op == operation_enum::recv) {
+            if (!free_buffers.empty()) {
+                s->buffer_index = free_buffers.back();
+                s->buffer = arena + static_cast<std::size_t>(s->buffer_index) * buffer_size;
+                free_buffers.pop_back();
+            } else {
+                s->heap.reset(new char[buffer_size]);
+                s->buffer = s->heap.get();
+            }
+        }
+
+        auto res = slots.emplace(sock, std::move(s));
+        return res.first->second.get();
+    }
+
+    void retire (int sock, error * perr)
+    {
+        auto pos = slots.find(sock);
+
+        // Not registered is not a failure
+        if (pos == slots.end())
+            return;
+
+        auto s = pos->second.get();
+        s->removed = true;
+
+        if (s->in_flight)
+            queue_cancel(*s, perr);
+
+        retired.emplace(s, std::move(pos->second));
+        slots.erase(pos);
+    }
+
+    /**
+     * Releases the slots of the removed sockets without operations in flight.
+     */
+    void sweep ()
+    {
+        if (retired.empty())
+            return;
+
+        ready.erase(std::remove_if(ready.begin(), ready.end(), [] (slot * s) {
+            return s->removed;
+        }), ready.end());
+
+        for (auto pos = retired.begin(); pos != retired.end();) {
+            if (pos->second->in_flight) {
+                ++pos;
+                continue;
+            }
+
+            if (pos->second->buffer_index >= 0)
+                free_buffers.push_back(pos->second->buffer_index);
+
+            pos = retired.erase(pos);
+        }
+    }
+
+    bool queue_operation (slot & s, error * perr)
+    {
+        auto sqe = get_sqe(perr);
+
+        if (sqe == nullptr)
+            return false;
+
+        sqe->fd = s.sock;
+        sqe->user_data = reinterpret_cast<std::uint64_t>(& s);
+
+        switch (op) {
+            case operation_enum::recv:
+                sqe->addr = reinterpret_cast<std::uint64_t>(s.buffer);
+                sqe->len = static_cast<std::uint32_t>(buffer_size);
+
+                if (s.buffer_index >= 0) {
+                    // Socket read accepts zero offset only
+                    sqe->opcode = IORING_OP_READ_FIXED;
+                    sqe->off = 0;
+                    sqe->buf_index = static_cast<std::uint16_t>(s.buffer_index);
+                } else {
+                    sqe->opcode = IORING_OP_RECV;
+                }
+
+                break;
+
+            // IORING_OP_WRITE_FIXED can not suppress SIGPIPE on the reset connection
+            case operation_enum::send:
+                sqe->opcode = IORING_OP_SEND;
+                sqe->addr = reinterpret_cast<std::uint64_t>(s.buffer + s.offset);
+                sqe->len = static_cast<std::uint32_t>(s.size - s.offset);
+                sqe->msg_flags = MSG_NOSIGNAL;
+                break;
+
+            case operation_enum::accept:
+                s.addrlen = sizeof(s.addr);
+                sqe->opcode = IORING_OP_ACCEPT;
+                sqe->addr = reinterpret_cast<std::uint64_t>(& s.addr);
+                sqe->addr2 = reinterpret_cast<std::uint64_t>(& s.addrlen);
+                sqe->accept_flags = SOCK_NONBLOCK;
+                break;
+
+            case operation_enum::connect:
+                sqe->opcode = IORING_OP_CONNECT;
+                sqe->addr = reinterpret_cast<std::uint64_t>(& s.addr);
+                sqe->off = sizeof(s.addr);
+                break;
+        }
+
+        s.in_flight = true;
+        ++in_flight;
+        return true;
+    }
+
+    bool queue_cancel (slot & s, error * perr)
+    {
+        auto sqe = get_sqe(perr);
+
+        if (sqe == nullptr)
+            return false;
+
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<std::uint64_t>(& s);
+        sqe->user_data = 0; // Completion is ignored
+        return true;
+    }
+
+    /**
+     * Moves completions from the completion ring into the reaped list.
+     */
+    void reap ()
+    {
+        reaped.clear();
+
+        auto head = *cq_head;
+        auto tail = load_acquire(cq_tail);
+
+        for (; head != tail; ++head) {
+            auto const & cqe = cqes[head & *cq_mask];
+
+            // Completion of the cancel request
+            if (cqe.user_data == 0)
+                continue;
+
+            auto s = reinterpret_cast<slot *>(cqe.user_data);
+            s->in_flight = false;
+            --in_flight;
+            reaped.emplace_back(s, cqe.res);
+        }
+
+        store_release(cq_head, head);
+    }
+
+    void complete_removed (int res)
+    {
+        // Accepted after the listener is removed
+        if (op == operation_enum::accept && res >= 0)
+            ::close(res);
+    }
+
+    /**
+     * Processes the completion of the registered socket operation.
+     *
+     * @return @c true if the completion @a c must be reported.
+     */
+    bool complete (slot & s, int res, completion & c, error * perr)
+    {
+        c.sock = s.sock;
+        c.result = res;
+        c.data = nullptr;
+
+        switch (op) {
+            case operation_enum::recv:
+                // Including the request cancelled by the kernel (e.g. the submitting thread exited)
+                if (is_interrupted(res)) {
+                    rearm.push_back(& s);
+                    return false;
+                }
+
+                // Zero result is the end of stream: the socket is not resubmitted
+                if (res > 0) {
+                    c.data = s.buffer;
+                    rearm.push_back(& s);
+                }
+
+                return true;
+
+            case operation_enum::send:
+                if (is_interrupted(res)) {
+                    queue_operation(s, perr);
+                    return false;
+                }
+
+                if (res < 0) {
+                    s.size = 0;
+                    s.offset = 0;
+                    return true;
+                }
+
+                s.offset += static_cast<std::size_t>(res);
+
+                // Short write
+                if (s.offset < s.size) {
+                    queue_operation(s, perr);
+                    return false;
+                }
+
+                s.size = 0;
+                s.offset = 0;
+
+                if (!s.notify)
+                    return false;
+
+                s.notify = false;
+                c.result = 0;
+                return true;
+
+            case operation_enum::accept:
+                if (is_transient_accept_failure(res)) {
+                    rearm.push_back(& s);
+                    return false;
+                }
+
+                if (res >= 0) {
+                    c.saddr = socket4_addr {
+                          pfs::to_native_order(static_cast<std::uint32_t>(s.addr.sin_addr.s_addr))
+                        , pfs::to_native_order(static_cast<std::uint16_t>(s.addr.sin_port))
+                    };
+
+                    rearm.push_back(& s);
+                }
+
+                return true;
+
+            case operation_enum::connect:
+                if (res == -ECANCELED || res == -EINTR) {
+                    queue_operation(s, perr);
+                    return false;
+                }
+
+                // Connected by the interrupted request
+                if (res == -EISCONN)
+                    c.result = 0;
+
+                return true;
+        }
+
+        return false;
+    }
+};
+
+io_uring_poller::io_uring_poller (operation_enum op)
+    : _d(new ring(op))
+{}
+
+io_uring_poller::~io_uring_poller () = default;
+
+void io_uring_poller::add_socket (socket_id sock, error * perr)
+{
+    PFS__TERMINATE(_d->op == operation_enum::recv, "io_uring_poller: socket can be added to the receiving backend only");
+
+    // Is not an error
+    if (_d->slots.find(sock) != _d->slots.end())
+        return;
+
+    auto s = _d->ensure_slot(sock);
+
+    if (!_d->queue_operation(*s, perr))
+        _d->retire(sock, nullptr);
+}
+
+void io_uring_poller::add_listener (listener_id sock, error * perr)
+{
+    PFS__TERMINATE(_d->op == operation_enum::accept, "io_uring_poller: listener can be added to the accepting backend only");
+
+    // Is not an error
+    if (_d->slots.find(sock) != _d->slots.end())
+        return;
+
+    auto s = _d->ensure_slot(sock);
+
+    if (!_d->queue_operation(*s, perr))
+        _d->retire(sock, nullptr);
+}
+
+void io_uring_poller::wait_for_write (socket_id sock, error * perr)
+{
+    PFS__TERMINATE(_d->op == operation_enum::send, "io_uring_poller: write completion is reported by the sending backend only");
+    (void)perr;
+
+    auto s = _d->ensure_slot(sock);
+
+    if (s->notify)
+        return;
+
+    s->notify = true;
+
+    if (!s->in_flight)
+        _d->ready.push_back(s);
+}
+
+std::size_t io_uring_poller::send (socket_id sock, frame_chunk const * chunks, int count, error * perr)
+{
+    PFS__TERMINATE(_d->op == operation_enum::send, "io_uring_poller: data can be sent by the sending backend only");
+
+    auto s = _d->ensure_slot(sock);
+
+    // Previous data is being written
+    if (s->in_flight || s->size > 0)
+        return 0;
+
+    // Allocated on the first use: idle sockets do not hold the buffers
+    if (s->buffer == nullptr) {
+        s->heap.reset(new char[_d->buffer_size]);
+        s->buffer = s->heap.get();
+    }
+
+    std::size_t n = 0;
+
+    for (int i = 0; i < count && n < _d->buffer_size; i++) {
+        auto size = (std::min)(chunks[i].size, _d->buffer_size - n);
+        std::memcpy(s->buffer + n, chunks[i].data, size);
+        n += size;
+    }
+
+    if (n == 0)
+        return 0;
+
+    s->size = n;
+    s->offset = 0;
+
+    if (!_d->queue_operation(*s, perr)) {
+        s->size = 0;
+        return 0;
+    }
+
+    return n;
+}
+
+void io_uring_poller::connect (socket_id sock, socket4_addr const & saddr, error * perr)
+{
+    PFS__TERMINATE(_d->op == operation_enum::connect, "io_uring_poller: socket can be connected by the connecting backend only");
+
+    auto s = _d->ensure_slot(sock);
+
+    std::memset(& s->addr, 0, sizeof(s->addr));
+    s->addr.sin_family = AF_INET;
+    s->addr.sin_port = pfs::to_network_order(static_cast<std::uint16_t>(saddr.port));
+    s->addr.sin_addr.s_addr = pfs::to_network_order(static_cast<std::uint32_t>(saddr.addr));
+
+    if (!_d->queue_operation(*s, perr))
+        _d->retire(sock, nullptr);
+}
+
+void io_uring_poller::remove_socket (socket_id sock, error * perr)
+{
+    _d->retire(sock, perr);
+}
+
+void io_uring_poller::remove_listener (listener_id sock, error * perr)
+{
+    _d->retire(sock, perr);
+}
+
+bool io_uring_poller::empty () const noexcept
+{
+    return _d->slots.empty();
+}
+
+int io_uring_poller::poll (std::chrono::milliseconds millis, error * perr)
+{
+    auto & d = *_d;
+
+    // Buffers of the dispatched completions are not used anymore
+    if (!d.rearm.empty()) {
+        for (auto s: d.rearm) {
+            if (!s->removed && !s->in_flight)
+                d.queue_operation(*s, perr);
+        }
+
+        d.rearm.clear();
+    }
+
+    d.sweep();
+
+    if (d.in_flight == 0 && d.pending == 0 && d.ready.empty())
+        return 0;
+
+    if (millis < std::chrono::milliseconds{0} || !d.ready.empty())
+        millis = std::chrono::milliseconds{0};
+
+    bool success = true;
+
+    if (millis > std::chrono::milliseconds{0}) {
+        __kernel_timespec ts;
+        ts.tv_sec = millis.count() / 1000;
+        ts.tv_nsec = (millis.count() % 1000) * 1000000;
+
+        io_uring_getevents_arg arg;
+        std::memset(& arg, 0, sizeof(arg));
+        arg.sigmask = 0;
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<std::uint64_t>(& ts);
+
+        // Wait only if there are no completions yet
+        auto ready = load_acquire(d.cq_tail) - *d.cq_head;
+        success = d.submit(ready == 0 ? 1 : 0, & arg, perr);
+    } else if (d.pending > 0) {
+        success = d.submit(0, nullptr, perr);
+    }
+
+    if (!success)
+        return -1;
+
+    d.reap();
+
+    int n = 0;
+    completion c;
+
+    for (auto const & x: d.reaped) {
+        auto s = x.first;
+
+        // Socket is removed after the operation was submitted or by the previous completion handler
+        if (s->removed) {
+            d.complete_removed(x.second);
+            continue;
+        }
+
+        if (d.complete(*s, x.second, c, perr)) {
+            completed(c);
+            n++;
+        }
+    }
+
+    // Requested write completions of the sockets without data in flight
+    if (!d.ready.empty()) {
+        d.notified.clear();
+        d.notified.swap(d.ready);
+
+        for (auto s: d.notified) {
+            if (s->removed || !s->notify || s->in_flight)
+                continue;
+
+            s->notify = false;
+            c.sock = s->sock;
+            c.result = 0;
+            c.data = nullptr;
+            completed(c);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+} // namespace linux_os
+
+NETTY__NAMESPACE_END
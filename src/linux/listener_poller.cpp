@@ -5,16 +5,63 @@
 //
 // Changelog:
 //      2023.01.10 Initial version.
+//      2026.10.16 Added listener poller specialization for shared epoll.
+//                 Added listener poller specialization for io_uring.
+//      2026.10.17 io_uring listener poller accepts by the backend.
 ////////////////////////////////////////////////////////////////////////////////
 #if NETTY__EPOLL_ENABLED
 #include "../listener_poller_impl.hpp"
 #include "netty/namespace.hpp"
 #include "netty/linux/epoll_poller.hpp"
+#include "netty/linux/shared_epoll_poller.hpp"
+
 #include <pfs/i18n.hpp>
 #include <sys/socket.h>
 
+#if NETTY__IO_URING_ENABLED
+#   include "netty/linux/io_uring_poller.hpp"
+#endif
+
 NETTY__NAMESPACE_BEGIN
 
+/**
+ * @return @c true if incoming connection can be accepted.
+ */
+template <typename ListenerPoller>
+static bool process_event (ListenerPoller & poller, epoll_event const & ev)
+{
+    if (ev.events & EPOLLERR) {
+        int error_val = 0;
+        socklen_t len = sizeof(error_val);
+        auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
+
+        if (rc != 0) {
+            poller.on_failure(ev.data.fd, error {
+                  make_error_code(pfs::errc::system_error)
+                , tr::f_("get socket option failure: {}, listener socket removed: {}"
+                    , pfs::system_error_text(), ev.data.fd)
+            });
+        } else {
+            poller.on_failure(ev.data.fd, error {
+                  errc::socket_error
+                , tr::f_("accept socket error: {}, listener socket removed: {}"
+                    , pfs::system_error_text(error_val), ev.data.fd)
+            });
+        }
+
+        return false;
+    }
+
+    // There is data to read - can accept
+    // Identical to `poll_poller`
+    if (ev.events & (EPOLLIN | EPOLLRDNORM | EPOLLRDBAND)) {
+        poller.accept(ev.data.fd);
+        return true;
+    }
+
+    return false;
+}
+
 template <>
 listener_poller<linux_os::epoll_poller>::listener_poller ()
     : _rep(new linux_os::epoll_poller(EPOLLERR | EPOLLIN | EPOLLRDNORM | EPOLLRDBAND))
@@ -40,34 +87,8 @@ int listener_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds mil
 
             n--;
 
-            if (ev.events & EPOLLERR) {
-                int error_val = 0;
-                socklen_t len = sizeof(error_val);
-                auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
-
-                if (rc != 0) {
-                    on_failure(ev.data.fd, error {
-                          make_error_code(pfs::errc::system_error)
-                        , tr::f_("get socket option failure: {}, listener socket removed: {}"
-                            , pfs::system_error_text(), ev.data.fd)
-                    });
-                } else {
-                    on_failure(ev.data.fd, error {
-                          errc::socket_error
-                        , tr::f_("accept socket error: {}, listener socket removed: {}"
-                            , pfs::system_error_text(error_val), ev.data.fd)
-                    });
-                }
-
-                continue;
-            }
-
-            // There is data to read - can accept
-            // Identical to `poll_poller`
-            if (ev.events & (EPOLLIN | EPOLLRDNORM | EPOLLRDBAND)) {
+            if (process_event(*this, ev))
                 res++;
-                accept(ev.data.fd);
-            }
         }
     }
 
@@ -76,6 +97,80 @@ int listener_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds mil
 
 template class listener_poller<linux_os::epoll_poller>;
 
+template <>
+listener_poller<linux_os::shared_epoll_poller>::listener_poller (std::shared_ptr<linux_os::shared_epoll_poller> backend)
+    : _rep(backend != nullptr ? std::move(backend) : std::make_shared<linux_os::shared_epoll_poller>())
+{
+    _rep->listener_event = [this] (epoll_event const & ev) {
+        process_event(*this, ev);
+    };
+}
+
+template <>
+listener_poller<linux_os::shared_epoll_poller>::listener_poller ()
+    : listener_poller(std::shared_ptr<linux_os::shared_epoll_poller>{})
+{}
+
+template <>
+void listener_poller<linux_os::shared_epoll_poller>::add (listener_id sock, error * perr)
+{
+    _rep->add(sock, linux_os::shared_epoll_poller::listener_role, perr);
+}
+
+template <>
+void listener_poller<linux_os::shared_epoll_poller>::remove (listener_id sock, error * perr)
+{
+    _rep->remove(sock, linux_os::shared_epoll_poller::listener_role, perr);
+}
+
+template <>
+bool listener_poller<linux_os::shared_epoll_poller>::empty () const noexcept
+{
+    return _rep->empty(linux_os::shared_epoll_poller::listener_role);
+}
+
+/**
+ * Events are dispatched by the reader poller if the backend is shared.
+ */
+template <>
+int listener_poller<linux_os::shared_epoll_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    if (_rep.use_count() > 1)
+        return 0;
+
+    return _rep->poll(millis, perr);
+}
+
+template class listener_poller<linux_os::shared_epoll_poller>;
+
+#if NETTY__IO_URING_ENABLED
+// Connections are accepted by the backend and passed by accepted.
+template <>
+listener_poller<linux_os::io_uring_poller>::listener_poller ()
+    : _rep(new linux_os::io_uring_poller(linux_os::io_uring_poller::operation_enum::accept))
+{
+    _rep->completed = [this] (linux_os::io_uring_poller::completion const & c) {
+        if (c.result >= 0) {
+            accepted(c.sock, c.result, c.saddr);
+        } else {
+            on_failure(c.sock, error {
+                  errc::socket_error
+                , tr::f_("accept socket error: {}, listener socket removed: {}"
+                    , pfs::system_error_text(-c.result), c.sock)
+            });
+        }
+    };
+}
+
+template <>
+int listener_poller<linux_os::io_uring_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    return _rep->poll(millis, perr);
+}
+
+template class listener_poller<linux_os::io_uring_poller>;
+#endif // NETTY__IO_URING_ENABLED
+
 NETTY__NAMESPACE_END
 
 #endif // NETTY__EPOLL_ENABLED
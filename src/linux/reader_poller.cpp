@@ -5,14 +5,122 @@
 //
 // Changelog:
 //      2023.01.23 Initial version.
+//      2026.10.16 Added reader poller specialization for edge-triggered epoll.
+//                 Added reader poller specialization for shared epoll.
+//                 Added reader poller specialization for io_uring.
+//      2026.10.17 io_uring reader poller receives the data by the backend.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../reader_poller_impl.hpp"
 #include "netty/linux/epoll_poller.hpp"
+#include "netty/linux/shared_epoll_poller.hpp"
+
 #include <pfs/i18n.hpp>
 #include <sys/socket.h>
 
+#if NETTY__IO_URING_ENABLED
+#   include "netty/linux/io_uring_poller.hpp"
+#endif
+
 NETTY__NAMESPACE_BEGIN
 
+template <typename ReaderPoller>
+static void process_socket_error (ReaderPoller & poller, int fd)
+{
+    int error_val = 0;
+    socklen_t len = sizeof(error_val);
+    auto rc = getsockopt(fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
+
+    if (rc != 0) {
+        poller.on_failure(fd, error {
+              make_error_code(pfs::errc::system_error)
+            , tr::f_("get socket ({}) option failure: {} (errno={})"
+                , fd, pfs::system_error_text(), errno)
+        });
+    } else {
+        if (error_val == EPIPE || error_val == ETIMEDOUT || error_val == EHOSTUNREACH
+                || error_val == ECONNRESET) {
+            poller.disconnected(fd);
+        } else {
+            poller.on_failure(fd, error {
+                  errc::socket_error
+                , tr::f_("get socket ({}) option failure: {} (error_val={})"
+                    , fd, pfs::system_error_text(error_val), error_val)
+            });
+        }
+    }
+}
+
+/**
+ * Processes level-triggered event.
+ *
+ * @return @c true if data is ready for reading.
+ */
+template <typename ReaderPoller>
+static bool process_event (ReaderPoller & poller, epoll_event const & ev)
+{
+    if (ev.events & EPOLLERR) {
+        process_socket_error(poller, ev.data.fd);
+        return false;
+    }
+
+    if (ev.events & (EPOLLHUP | EPOLLRDHUP)) {
+        poller.disconnected(ev.data.fd);
+        return false;
+    }
+
+    if (ev.events & (EPOLLIN | EPOLLRDNORM | EPOLLRDBAND)) {
+        char buf[1];
+        auto n = ::recv(ev.data.fd, buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT);
+
+        if (n > 0) {
+            poller.ready_read(ev.data.fd);
+        } else if (n == 0) {
+            poller.disconnected(ev.data.fd);
+        } else {
+            if (errno == ECONNRESET) {
+                poller.disconnected(ev.data.fd);
+            } else {
+                poller.on_failure(ev.data.fd, error {
+                      errc::socket_error
+                      , tr::f_("read socket failure: {} (socket={})"
+                        , pfs::system_error_text(errno), ev.data.fd)
+                });
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Processes event without extra check for available data: the reader drains the socket, and peer
+ * shutdown is reported by EPOLLRDHUP/EPOLLHUP. Data received before the shutdown must be read first.
+ *
+ * @return @c true if data is ready for reading.
+ */
+template <typename ReaderPoller>
+static bool process_edge_event (ReaderPoller & poller, epoll_event const & ev)
+{
+    bool res = false;
+
+    if (ev.events & EPOLLERR) {
+        process_socket_error(poller, ev.data.fd);
+        return res;
+    }
+
+    if (ev.events & (EPOLLIN | EPOLLRDNORM | EPOLLRDBAND)) {
+        res = true;
+        poller.ready_read(ev.data.fd);
+    }
+
+    if (ev.events & (EPOLLHUP | EPOLLRDHUP))
+        poller.disconnected(ev.data.fd);
+
+    return res;
+}
+
 template <>
 reader_poller<linux_os::epoll_poller>::reader_poller ()
     : _rep(new linux_os::epoll_poller(EPOLLERR | EPOLLIN | EPOLLRDNORM | EPOLLRDBAND
@@ -40,65 +148,135 @@ int reader_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds milli
 
             n--;
 
-            if (ev.events & EPOLLERR) {
-                int error_val = 0;
-                socklen_t len = sizeof(error_val);
-                auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
-
-                if (rc != 0) {
-                    on_failure(ev.data.fd, error {
-                          make_error_code(pfs::errc::system_error)
-                        , tr::f_("get socket ({}) option failure: {} (errno={})"
-                            , ev.data.fd, pfs::system_error_text(), errno)
-                    });
-                } else {
-                    if (error_val == EPIPE || error_val == ETIMEDOUT || error_val == EHOSTUNREACH
-                            || error_val == ECONNRESET) {
-                        disconnected(ev.data.fd);
-                    } else {
-                        on_failure(ev.data.fd, error {
-                              errc::socket_error
-                            , tr::f_("get socket ({}) option failure: {} (error_val={})"
-                                , ev.data.fd, pfs::system_error_text(error_val), error_val)
-                        });
-                    }
-                }
+            if (process_event(*this, ev))
+                res++;
+        }
+    }
 
-                continue;
-            }
+    return res;
+}
+
+template class reader_poller<linux_os::epoll_poller>;
+
+template <>
+reader_poller<linux_os::epoll_et_poller>::reader_poller ()
+    : _rep(new linux_os::epoll_et_poller(EPOLLERR | EPOLLIN | EPOLLRDNORM | EPOLLRDBAND
+        | EPOLLHUP | EPOLLRDHUP
+    ))
+{}
+
+template <>
+int reader_poller<linux_os::epoll_et_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    auto n = _rep->poll(millis, perr);
+
+    if (n < 0)
+        return n;
 
-            if (ev.events & (EPOLLHUP | EPOLLRDHUP)) {
-                disconnected(ev.data.fd);
+    int res = 0;
+
+    if (n > 0) {
+        for (auto const & ev: _rep->events) {
+            if (n == 0)
+                break;
+
+            if (ev.events == 0)
                 continue;
-            }
 
-            if (ev.events & (EPOLLIN | EPOLLRDNORM | EPOLLRDBAND)) {
+            n--;
+
+            if (process_edge_event(*this, ev))
                 res++;
-                char buf[1];
-                auto n = ::recv(ev.data.fd, buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT);
-
-                if (n > 0) {
-                    ready_read(ev.data.fd);
-                } else if (n == 0) {
-                    disconnected(ev.data.fd);
-                } else {
-                    if (errno == ECONNRESET) {
-                        disconnected(ev.data.fd);
-                    } else {
-                        on_failure(ev.data.fd, error {
-                              errc::socket_error
-                              , tr::f_("read socket failure: {} (socket={})"
-                                , pfs::system_error_text(errno), ev.data.fd)
-                        });
-                    }
-                }
-            }
         }
     }
 
     return res;
 }
 
-template class reader_poller<linux_os::epoll_poller>;
+template class reader_poller<linux_os::epoll_et_poller>;
+
+template <>
+reader_poller<linux_os::shared_epoll_poller>::reader_poller (std::shared_ptr<linux_os::shared_epoll_poller> backend)
+    : _rep(backend != nullptr ? std::move(backend) : std::make_shared<linux_os::shared_epoll_poller>())
+{
+    _rep->reader_event = [this] (epoll_event const & ev) {
+        process_event(*this, ev);
+    };
+}
+
+template <>
+reader_poller<linux_os::shared_epoll_poller>::reader_poller ()
+    : reader_poller(std::shared_ptr<linux_os::shared_epoll_poller>{})
+{}
+
+template <>
+void reader_poller<linux_os::shared_epoll_poller>::add (socket_id sock, error * perr)
+{
+    _rep->add(sock, linux_os::shared_epoll_poller::reader_role, perr);
+}
+
+template <>
+void reader_poller<linux_os::shared_epoll_poller>::remove (socket_id sock, error * perr)
+{
+    _rep->remove(sock, linux_os::shared_epoll_poller::reader_role, perr);
+}
+
+template <>
+bool reader_poller<linux_os::shared_epoll_poller>::empty () const noexcept
+{
+    return _rep->empty(linux_os::shared_epoll_poller::reader_role);
+}
+
+/**
+ * Reader poller drives the shared backend: one wait dispatches events for all pollers sharing it.
+ */
+template <>
+int reader_poller<linux_os::shared_epoll_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    return _rep->poll(millis, perr);
+}
+
+template class reader_poller<linux_os::shared_epoll_poller>;
+
+#if NETTY__IO_URING_ENABLED
+// Data is received by the backend into its buffers and passed by data_received.
+template <>
+reader_poller<linux_os::io_uring_poller>::reader_poller ()
+    : _rep(new linux_os::io_uring_poller(linux_os::io_uring_poller::operation_enum::recv))
+{
+    _rep->completed = [this] (linux_os::io_uring_poller::completion const & c) {
+        if (c.result > 0) {
+            data_received(c.sock, c.data, static_cast<std::size_t>(c.result));
+            return;
+        }
+
+        switch (-c.result) {
+            case 0: // End of stream
+            case EPIPE:
+            case ETIMEDOUT:
+            case EHOSTUNREACH:
+            case ECONNRESET:
+                disconnected(c.sock);
+                break;
+
+            default:
+                on_failure(c.sock, error {
+                      errc::socket_error
+                    , tr::f_("read socket failure: {} (socket={})"
+                        , pfs::system_error_text(-c.result), c.sock)
+                });
+                break;
+        }
+    };
+}
+
+template <>
+int reader_poller<linux_os::io_uring_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    return _rep->poll(millis, perr);
+}
+
+template class reader_poller<linux_os::io_uring_poller>;
+#endif // NETTY__IO_URING_ENABLED
 
 NETTY__NAMESPACE_END
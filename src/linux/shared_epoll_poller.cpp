@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.16 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "netty/namespace.hpp"
+#include "netty/error.hpp"
+#include "netty/linux/shared_epoll_poller.hpp"
+#include <pfs/i18n.hpp>
+#include <unistd.h>
+
+NETTY__NAMESPACE_BEGIN
+
+namespace linux_os {
+
+static constexpr std::size_t const DEFAULT_INCREMENT = 32;
+
+static constexpr std::uint32_t const LISTENER_EVENTS = EPOLLERR | EPOLLIN | EPOLLRDNORM | EPOLLRDBAND;
+static constexpr std::uint32_t const CONNECTING_EVENTS = EPOLLERR | EPOLLHUP | EPOLLRDHUP | EPOLLOUT
+    | EPOLLWRNORM | EPOLLWRBAND;
+static constexpr std::uint32_t const READER_EVENTS = EPOLLERR | EPOLLIN | EPOLLRDNORM | EPOLLRDBAND
+    | EPOLLHUP | EPOLLRDHUP;
+static constexpr std::uint32_t const WRITER_EVENTS = EPOLLERR | EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND;
+
+shared_epoll_poller::shared_epoll_poller ()
+{
+    _eid = epoll_create1(0);
+
+    if (_eid < 0) {
+        throw error {
+              errc::poller_error
+            , tr::_("epoll create failure")
+            , pfs::system_error_text()
+        };
+    }
+}
+
+shared_epoll_poller::~shared_epoll_poller ()
+{
+    if (_eid > 0) {
+        ::close(_eid);
+        _eid = -1;
+    }
+}
+
+std::uint32_t shared_epoll_poller::interest_mask (std::uint8_t roles) noexcept
+{
+    std::uint32_t mask = 0;
+
+    if (roles & listener_role)
+        mask |= LISTENER_EVENTS;
+
+    if (roles & connecting_role)
+        mask |= CONNECTING_EVENTS;
+
+    if (roles & reader_role)
+        mask |= READER_EVENTS;
+
+    if (roles & writer_role)
+        mask |= WRITER_EVENTS;
+
+    return mask;
+}
+
+std::size_t & shared_epoll_poller::role_counter (role_enum role) noexcept
+{
+    switch (role) {
+        case listener_role: return _role_counters[0];
+        case connecting_role: return _role_counters[1];
+        case reader_role: return _role_counters[2];
+        case writer_role:
+        default:
+            break;
+    }
+
+    return _role_counters[3];
+}
+
+void shared_epoll_poller::update (socket_id sock, std::uint8_t old_roles, std::uint8_t new_roles, error * perr)
+{
+    if (old_roles == new_roles)
+        return;
+
+    if (new_roles == 0) {
+        auto rc = epoll_ctl(_eid, EPOLL_CTL_DEL, sock, nullptr);
+
+        // ENOENT is not a failure
+        if (rc != 0 && errno != ENOENT) {
+            pfs::throw_or(perr, error {
+                  errc::poller_error
+                , tr::f_("epoll delete socket ({}) failure", sock)
+                , pfs::system_error_text()
+            });
+        }
+
+        return;
+    }
+
+    struct epoll_event ev;
+    ev.events = interest_mask(new_roles);
+    ev.data.fd = sock;
+
+    auto rc = epoll_ctl(_eid, old_roles == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, sock, & ev);
+
+    if (rc != 0) {
+        pfs::throw_or(perr, error {
+              errc::poller_error
+            , tr::f_("epoll {} socket ({}) failure", (old_roles == 0 ? "add" : "modify"), sock)
+            , pfs::system_error_text()
+        });
+    }
+}
+
+void shared_epoll_poller::add (socket_id sock, role_enum role, error * perr)
+{
+    auto & roles = _roles[sock];
+
+    if (roles & role)
+        return;
+
+    error err;
+    update(sock, roles, roles | role, & err);
+
+    if (err) {
+        if (roles == 0)
+            _roles.erase(sock);
+
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    roles |= role;
+    ++role_counter(role);
+
+    if (_events.size() < _roles.size())
+        _events.resize(_events.size() + DEFAULT_INCREMENT);
+}
+
+void shared_epoll_poller::remove (socket_id sock, role_enum role, error * perr)
+{
+    auto pos = _roles.find(sock);
+
+    if (pos == _roles.end() || !(pos->second & role))
+        return;
+
+    auto old_roles = pos->second;
+    auto new_roles = static_cast<std::uint8_t>(old_roles & ~role);
+
+    // Socket is not monitored for the role regardless of the result
+    if (new_roles == 0)
+        _roles.erase(pos);
+    else
+        pos->second = new_roles;
+
+    --role_counter(role);
+
+    update(sock, old_roles, new_roles, perr);
+}
+
+bool shared_epoll_poller::empty (role_enum role) const noexcept
+{
+    return const_cast<shared_epoll_poller *>(this)->role_counter(role) == 0;
+}
+
+int shared_epoll_poller::poll (std::chrono::milliseconds millis, error * perr)
+{
+    auto maxevents = static_cast<int>(_events.size());
+
+    if (_roles.empty() || maxevents == 0)
+        return 0;
+
+    if (millis < std::chrono::milliseconds{0})
+        millis = std::chrono::milliseconds{0};
+
+    auto n = epoll_wait(_eid, _events.data(), maxevents, millis.count());
+
+    if (n < 0) {
+        if (errno == EINTR) {
+            // Is not a critical error, ignore it
+            return 0;
+        }
+
+        pfs::throw_or(perr, error {
+              errc::poller_error
+            , tr::_("epoll wait failure")
+            , pfs::system_error_text()
+        });
+
+        return n;
+    }
+
+    int res = 0;
+
+    for (int i = 0; i < n; i++) {
+        // Copy the event: handlers can register new sockets and resize the events buffer
+        auto ev = _events[i];
+        auto fd = ev.data.fd;
+        auto pos = _roles.find(fd);
+
+        // Socket was removed by one of the previous handlers
+        if (pos == _roles.end())
+            continue;
+
+        auto roles = pos->second;
+
+        if (roles & listener_role) {
+            res++;
+            listener_event(ev);
+            continue;
+        }
+
+        if (roles & connecting_role) {
+            res++;
+            connecting_event(ev);
+            continue;
+        }
+
+        if ((roles & reader_role) && (ev.events & READER_EVENTS)) {
+            res++;
+            reader_event(ev);
+        }
+
+        if (roles & writer_role) {
+            // Error is already processed by the reader
+            if (roles & reader_role)
+                ev.events &= ~EPOLLERR;
+
+            if (!(ev.events & WRITER_EVENTS))
+                continue;
+
+            // Reader can remove the socket
+            pos = _roles.find(fd);
+
+            if (pos == _roles.end() || !(pos->second & writer_role))
+                continue;
+
+            // Write interest is one-shot, it is restored by the next wait_for_write()
+            remove(fd, writer_role);
+
+            res++;
+            writer_event(ev);
+        }
+    }
+
+    return res;
+}
+
+} // namespace linux_os
+
+NETTY__NAMESPACE_END
@@ -5,16 +5,66 @@
 //
 // Changelog:
 //      2023.01.24 Initial version.
+//      2026.10.16 Added writer poller specialization for shared epoll.
+//                 Added writer poller specialization for io_uring.
+//      2026.10.17 io_uring writer poller writes the data by the backend.
 ////////////////////////////////////////////////////////////////////////////////
 #if NETTY__EPOLL_ENABLED
 #include "../writer_poller_impl.hpp"
 #include "netty/namespace.hpp"
 #include "netty/linux/epoll_poller.hpp"
+#include "netty/linux/shared_epoll_poller.hpp"
+
 #include <pfs/i18n.hpp>
 #include <sys/socket.h>
 
+#if NETTY__IO_URING_ENABLED
+#   include "netty/linux/io_uring_poller.hpp"
+#endif
+
 NETTY__NAMESPACE_BEGIN
 
+/**
+ * @return @c true if writing is possible.
+ */
+template <typename WriterPoller>
+static bool process_event (WriterPoller & poller, epoll_event const & ev)
+{
+    // This event is also reported for the write end of a pipe when
+    // the read end has been closed.
+    // TODO Recognize disconnection (EPIPE ?)
+    if (ev.events & EPOLLERR) {
+        int error_val = 0;
+        socklen_t len = sizeof(error_val);
+        auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
+
+        if (rc != 0) {
+            poller.on_failure(ev.data.fd, error {
+                  make_error_code(pfs::errc::system_error)
+                , tr::f_("get socket option failure: {} (socket={})"
+                    , pfs::system_error_text(), ev.data.fd)
+            });
+        } else {
+            poller.on_failure(ev.data.fd, error {
+                  errc::socket_error
+                , tr::f_("write socket failure: {} (socket={})"
+                    , pfs::system_error_text(error_val), ev.data.fd)
+            });
+        }
+
+        return false;
+    }
+
+    // Writing is now possible, though a write larger than the available space
+    // in a socket or pipe will still block (unless O_NONBLOCK is set).
+    if (ev.events & (EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND)) {
+        poller.can_write(ev.data.fd);
+        return true;
+    }
+
+    return false;
+}
+
 template <>
 writer_poller<linux_os::epoll_poller>::writer_poller ()
     : _rep(new linux_os::epoll_poller(EPOLLERR | EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND))
@@ -40,37 +90,8 @@ int writer_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds milli
 
             n--;
 
-            // This event is also reported for the write end of a pipe when
-            // the read end has been closed.
-            // TODO Recognize disconnection (EPIPE ?)
-            if (ev.events & EPOLLERR) {
-                int error_val = 0;
-                socklen_t len = sizeof(error_val);
-                auto rc = getsockopt(ev.data.fd, SOL_SOCKET, SO_ERROR, & error_val, & len);
-
-                if (rc != 0) {
-                    on_failure(ev.data.fd, error {
-                          make_error_code(pfs::errc::system_error)
-                        , tr::f_("get socket option failure: {} (socket={})"
-                            , pfs::system_error_text(), ev.data.fd)
-                    });
-                } else {
-                    on_failure(ev.data.fd, error {
-                          errc::socket_error
-                        , tr::f_("write socket failure: {} (socket={})"
-                            , pfs::system_error_text(error_val), ev.data.fd)
-                    });
-                }
-
-                continue;
-            }
-
-            // Writing is now possible, though a write larger than the available space
-            // in a socket or pipe will still block (unless O_NONBLOCK is set).
-            if (ev.events & (EPOLLOUT | EPOLLWRNORM | EPOLLWRBAND)) {
+            if (process_event(*this, ev))
                 res++;
-                can_write(ev.data.fd);
-            }
         }
     }
 
@@ -79,6 +100,91 @@ int writer_poller<linux_os::epoll_poller>::poll (std::chrono::milliseconds milli
 
 template class writer_poller<linux_os::epoll_poller>;
 
+template <>
+writer_poller<linux_os::shared_epoll_poller>::writer_poller (std::shared_ptr<linux_os::shared_epoll_poller> backend)
+    : _rep(backend != nullptr ? std::move(backend) : std::make_shared<linux_os::shared_epoll_poller>())
+{
+    _rep->writer_event = [this] (epoll_event const & ev) {
+        process_event(*this, ev);
+    };
+}
+
+template <>
+writer_poller<linux_os::shared_epoll_poller>::writer_poller ()
+    : writer_poller(std::shared_ptr<linux_os::shared_epoll_poller>{})
+{}
+
+/**
+ * Write interest is added by EPOLL_CTL_MOD and dropped by the backend when the socket becomes writable.
+ */
+template <>
+void writer_poller<linux_os::shared_epoll_poller>::wait_for_write (socket_id sock, error * perr)
+{
+    _rep->add(sock, linux_os::shared_epoll_poller::writer_role, perr);
+}
+
+template <>
+void writer_poller<linux_os::shared_epoll_poller>::remove (socket_id sock, error * perr)
+{
+    _rep->remove(sock, linux_os::shared_epoll_poller::writer_role, perr);
+}
+
+template <>
+bool writer_poller<linux_os::shared_epoll_poller>::empty () const noexcept
+{
+    return _rep->empty(linux_os::shared_epoll_poller::writer_role);
+}
+
+/**
+ * Events are dispatched by the reader poller if the backend is shared.
+ */
+template <>
+int writer_poller<linux_os::shared_epoll_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    if (_rep.use_count() > 1)
+        return 0;
+
+    return _rep->poll(millis, perr);
+}
+
+template class writer_poller<linux_os::shared_epoll_poller>;
+
+#if NETTY__IO_URING_ENABLED
+// Data is written by the backend, completion of the write is reported if it is requested by
+// wait_for_write().
+template <>
+writer_poller<linux_os::io_uring_poller>::writer_poller ()
+    : _rep(new linux_os::io_uring_poller(linux_os::io_uring_poller::operation_enum::send))
+{
+    _rep->completed = [this] (linux_os::io_uring_poller::completion const & c) {
+        if (c.result >= 0) {
+            can_write(c.sock);
+        } else {
+            on_failure(c.sock, error {
+                  errc::socket_error
+                , tr::f_("write socket failure: {} (socket={})"
+                    , pfs::system_error_text(-c.result), c.sock)
+            });
+        }
+    };
+}
+
+template <>
+std::size_t writer_poller<linux_os::io_uring_poller>::send (socket_id sock, frame_chunk const * chunks
+    , int count, error * perr)
+{
+    return _rep->send(sock, chunks, count, perr);
+}
+
+template <>
+int writer_poller<linux_os::io_uring_poller>::poll (std::chrono::milliseconds millis, error * perr)
+{
+    return _rep->poll(millis, perr);
+}
+
+template class writer_poller<linux_os::io_uring_poller>;
+#endif // NETTY__IO_URING_ENABLED
+
 NETTY__NAMESPACE_END
 
 #endif // NETTY__EPOLL_ENABLED
@@ -5,12 +5,21 @@
 //
 // Changelog:
 //      2023.01.11 Initial version.
+//      2026.10.16 Added constructor with shared backend.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "netty/listener_poller.hpp"
+#include <pfs/assert.hpp>
 
 NETTY__NAMESPACE_BEGIN
 
+template <typename Backend>
+listener_poller<Backend>::listener_poller (std::shared_ptr<Backend> backend)
+    : listener_poller()
+{
+    PFS__TERMINATE(backend == nullptr, "poller backend can not be shared");
+}
+
 template <typename Backend>
 listener_poller<Backend>::~listener_poller () = default;
 
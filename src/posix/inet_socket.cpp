@@ -9,6 +9,8 @@
 #include "netty/posix/inet_socket.hpp"
 #include <pfs/endian.hpp>
 #include <pfs/i18n.hpp>
+#include <algorithm>
+#include <cstring>
 
 #if _MSC_VER
 #   include <winsock2.h>
@@ -17,6 +19,7 @@
 #   include <sys/ioctl.h>
 #   include <sys/types.h>
 #   include <sys/socket.h>
+#   include <sys/uio.h>
 #   include <netinet/in.h>
 #   include <netinet/tcp.h>
 #   include <fcntl.h>
@@ -511,6 +514,71 @@ send_result inet_socket::send (char const * data, int len, error * perr)
     return send_result{send_status::good, static_cast<std::uint64_t>(n)};
 }
 
+// See inet_socket::send
+send_result inet_socket::send (frame_chunk const * chunks, int count, error * perr)
+{
+    // Limit for the number of chunks sent at once. The rest of the data will be sent by the next
+    // call, partial sending is a normal situation for the stream socket.
+    static constexpr int kMAX_CHUNKS = 64;
+
+    count = (std::min)(count, kMAX_CHUNKS);
+
+#if _MSC_VER
+    WSABUF bufs[kMAX_CHUNKS];
+
+    for (int i = 0; i < count; i++) {
+        bufs[i].buf = const_cast<char *>(chunks[i].data);
+        bufs[i].len = static_cast<ULONG>(chunks[i].size);
+    }
+
+    DWORD n = 0;
+    auto rc = ::WSASend(_socket, bufs, static_cast<DWORD>(count), & n, 0, nullptr, nullptr);
+
+    if (rc == SOCKET_ERROR) {
+        auto lastWsaError = WSAGetLastError();
+
+        if (lastWsaError == WSAENOBUFS)
+            return send_result{send_status::overflow, 0};
+
+        if (lastWsaError == WSAECONNRESET || lastWsaError == WSAENETRESET
+            || lastWsaError == WSAENETDOWN || lastWsaError == WSAENETUNREACH)
+            return send_result{send_status::network, 0};
+
+        if (lastWsaError == WSAEWOULDBLOCK)
+            return send_result{send_status::again, 0};
+#else
+    iovec iov[kMAX_CHUNKS];
+
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = const_cast<char *>(chunks[i].data);
+        iov[i].iov_len = chunks[i].size;
+    }
+
+    msghdr msg;
+    std::memset(& msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(count);
+
+    auto n = ::sendmsg(_socket, & msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+    if (n < 0) {
+        if (errno == ENOBUFS)
+            return send_result{send_status::overflow, 0};
+
+        if (errno == ECONNRESET || errno == ENETRESET || errno == ENETDOWN
+            || errno == ENETUNREACH)
+            return send_result{send_status::network, 0};
+
+        if (errno == EAGAIN || (EAGAIN != EWOULDBLOCK && errno == EWOULDBLOCK))
+            return send_result{send_status::again, 0};
+#endif
+        pfs::throw_or(perr, error {errc::socket_error, tr::_("send failure"), pfs::system_error_text()});
+        return send_result{send_status::failure, 0};
+    }
+
+    return send_result{send_status::good, static_cast<std::uint64_t>(n)};
+}
+
 // See inet_socket::send
 send_result inet_socket::send_to (socket4_addr const & saddr, char const * data, int len, error * perr)
 {
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2023.01.01 Initial version.
+//      2026.10.17 Added adopt().
 ////////////////////////////////////////////////////////////////////////////////
 #include "netty/error.hpp"
 #include "netty/namespace.hpp"
@@ -96,6 +97,11 @@ tcp_socket tcp_listener::accept (error * perr)
     return tcp_socket{};
 }
 
+tcp_socket tcp_listener::adopt (socket_id sock, socket4_addr const & saddr)
+{
+    return tcp_socket{sock, saddr};
+}
+
 tcp_socket tcp_listener::accept_nonblocking (error * perr)
 {
     auto s = accept(perr);
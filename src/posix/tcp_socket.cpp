@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2023.01.01 Initial version.
+//      2026.10.17 Added prepare_connect().
 ////////////////////////////////////////////////////////////////////////////////
 #include "netty/error.hpp"
 #include "netty/namespace.hpp"
@@ -44,19 +45,34 @@ tcp_socket & tcp_socket::operator = (tcp_socket && other)
 
 tcp_socket::~tcp_socket () = default;
 
-conn_status tcp_socket::connect (socket4_addr const & remote_saddr, inet4_addr const & local_addr
+bool tcp_socket::prepare_connect (socket4_addr const & remote_saddr, inet4_addr const & local_addr
     , error * perr)
 {
     if (!init(type_enum::stream, perr))
-        return conn_status::failure;
+        return false;
 
     if (local_addr != any_inet4_addr()) {
         auto success = bind(_socket, socket4_addr{local_addr, 0}, perr);
 
         if (!success)
-            return conn_status::failure;
+            return false;
     }
 
+    _saddr = remote_saddr;
+    return true;
+}
+
+bool tcp_socket::prepare_connect (socket4_addr const & remote_saddr, error * perr)
+{
+    return prepare_connect(remote_saddr, any_inet4_addr(), perr);
+}
+
+conn_status tcp_socket::connect (socket4_addr const & remote_saddr, inet4_addr const & local_addr
+    , error * perr)
+{
+    if (!prepare_connect(remote_saddr, local_addr, perr))
+        return conn_status::failure;
+
     sockaddr_in addr_in4;
 
     memset(& addr_in4, 0, sizeof(addr_in4));
@@ -64,7 +80,6 @@ conn_status tcp_socket::connect (socket4_addr const & remote_saddr, inet4_addr c
     addr_in4.sin_family      = AF_INET;
     addr_in4.sin_port        = pfs::to_network_order(static_cast<std::uint16_t>(remote_saddr.port));
     addr_in4.sin_addr.s_addr = pfs::to_network_order(static_cast<std::uint32_t>(remote_saddr.addr));
-    _saddr = remote_saddr;
 
     auto rc = ::connect(_socket, reinterpret_cast<sockaddr *>(& addr_in4), sizeof(addr_in4));
 
@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "netty/posix/wakeup_socket.hpp"
+#include <pfs/i18n.hpp>
+
+#if _MSC_VER
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <sys/types.h>
+#   include <sys/socket.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+NETTY__NAMESPACE_BEGIN
+
+namespace posix {
+
+#if _MSC_VER
+
+static constexpr wakeup_socket::socket_id kINVALID_SOCKET = INVALID_SOCKET;
+
+static void close_socket (wakeup_socket::socket_id sock)
+{
+    ::closesocket(sock);
+}
+
+static bool set_nonblocking (wakeup_socket::socket_id sock)
+{
+    u_long nonblocking = 1;
+    return ::ioctlsocket(sock, FIONBIO, & nonblocking) == 0;
+}
+
+// There is no socketpair() on Windows, so connect the pair through the loopback interface
+static bool make_pair (wakeup_socket::socket_id sv[2])
+{
+    sv[0] = sv[1] = kINVALID_SOCKET;
+
+    auto listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (listener == INVALID_SOCKET)
+        return false;
+
+    sockaddr_in addr {};
+    int addrlen = sizeof(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    bool success = ::bind(listener, reinterpret_cast<sockaddr *>(& addr), sizeof(addr)) == 0
+        && ::getsockname(listener, reinterpret_cast<sockaddr *>(& addr), & addrlen) == 0
+        && ::listen(listener, 1) == 0;
+
+    if (success) {
+        sv[1] = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        success = sv[1] != INVALID_SOCKET
+            && ::connect(sv[1], reinterpret_cast<sockaddr *>(& addr), sizeof(addr)) == 0;
+    }
+
+    if (success) {
+        sv[0] = ::accept(listener, nullptr, nullptr);
+        success = sv[0] != INVALID_SOCKET;
+    }
+
+    ::closesocket(listener);
+
+    if (!success) {
+        if (sv[1] != INVALID_SOCKET)
+            ::closesocket(sv[1]);
+
+        sv[0] = sv[1] = kINVALID_SOCKET;
+    }
+
+    return success;
+}
+
+#else
+
+static constexpr wakeup_socket::socket_id kINVALID_SOCKET = -1;
+
+static void close_socket (wakeup_socket::socket_id sock)
+{
+    ::close(sock);
+}
+
+static bool set_nonblocking (wakeup_socket::socket_id sock)
+{
+    int rc = ::fcntl(sock, F_GETFL, 0);
+
+    if (rc >= 0)
+        rc = ::fcntl(sock, F_SETFL, rc | O_NONBLOCK);
+
+    return rc >= 0;
+}
+
+static bool make_pair (wakeup_socket::socket_id sv[2])
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        sv[0] = sv[1] = kINVALID_SOCKET;
+        return false;
+    }
+
+    return true;
+}
+
+#endif
+
+wakeup_socket::wakeup_socket (error * perr)
+    : _rd(kINVALID_SOCKET)
+    , _wr(kINVALID_SOCKET)
+{
+    socket_id sv[2];
+
+    if (!make_pair(sv)) {
+        pfs::throw_or(perr, error {
+              errc::socket_error
+            , tr::_("create wakeup socket pair failure")
+            , pfs::system_error_text()
+        });
+
+        return;
+    }
+
+    if (!set_nonblocking(sv[0]) || !set_nonblocking(sv[1])) {
+        close_socket(sv[0]);
+        close_socket(sv[1]);
+
+        pfs::throw_or(perr, error {
+              errc::socket_error
+            , tr::_("create wakeup socket pair failure: set non-blocking")
+            , pfs::system_error_text()
+        });
+
+        return;
+    }
+
+    _rd = sv[0];
+    _wr = sv[1];
+}
+
+wakeup_socket::~wakeup_socket ()
+{
+    if (_rd != kINVALID_SOCKET)
+        close_socket(_rd);
+
+    if (_wr != kINVALID_SOCKET)
+        close_socket(_wr);
+}
+
+void wakeup_socket::notify () noexcept
+{
+    // Only the first notification after clear() writes to the socket
+    if (_pending.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    char c = 0;
+    auto n = ::send(_wr, & c, 1, 0);
+    (void)n; // Socket buffer is full, so the reader is signaled already
+}
+
+void wakeup_socket::clear () noexcept
+{
+    _pending.store(false, std::memory_order_release);
+
+    char buf[64];
+
+    while (::recv(_rd, buf, sizeof(buf), 0) > 0)
+        ;
+}
+
+} // namespace posix
+
+NETTY__NAMESPACE_END
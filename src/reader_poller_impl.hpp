@@ -6,14 +6,23 @@
 // Changelog:
 //      2023.01.23 Initial version.
 //      2025.01.09 Removed init() method.
+//      2026.10.16 Added constructor with shared backend.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "netty/namespace.hpp"
 #include "netty/reader_poller.hpp"
 #include <pfs/i18n.hpp>
+#include <pfs/assert.hpp>
 
 NETTY__NAMESPACE_BEGIN
 
+template <typename Backend>
+reader_poller<Backend>::reader_poller (std::shared_ptr<Backend> backend)
+    : reader_poller()
+{
+    PFS__TERMINATE(backend == nullptr, "poller backend can not be shared");
+}
+
 template <typename Backend>
 reader_poller<Backend>::~reader_poller () = default;
 
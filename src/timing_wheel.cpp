@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/netty/timing_wheel.hpp"
+#include <pfs/assert.hpp>
+#include <algorithm>
+#include <limits>
+
+#if _MSC_VER
+#   include <intrin.h>
+#endif
+
+NETTY__NAMESPACE_BEGIN
+
+constexpr int timing_wheel::kLEVEL_BITS;
+constexpr int timing_wheel::kSLOT_COUNT;
+constexpr int timing_wheel::kLEVEL_COUNT;
+constexpr std::uint64_t timing_wheel::kSLOT_MASK;
+constexpr std::int32_t timing_wheel::kNIL;
+
+// Index of the lowest set bit, value must not be zero
+inline int lowest_bit (std::uint64_t value) noexcept
+{
+#if _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(& index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+inline std::uint64_t rotate_right (std::uint64_t value, int n) noexcept
+{
+    n &= 63;
+    return n == 0 ? value : (value >> n) | (value << (64 - n));
+}
+
+timing_wheel::timing_wheel (std::chrono::milliseconds resolution)
+    : _resolution(resolution > std::chrono::milliseconds{0} ? resolution : std::chrono::milliseconds{1})
+    , _origin(clock_type::now())
+{
+    std::fill(std::begin(_slots), std::end(_slots), kNIL);
+    std::fill(std::begin(_occupied), std::end(_occupied), std::uint64_t{0});
+}
+
+std::uint64_t timing_wheel::floor_tick (time_point t) const noexcept
+{
+    if (t <= _origin)
+        return 0;
+
+    return static_cast<std::uint64_t>((t - _origin) / _resolution);
+}
+
+std::uint64_t timing_wheel::ceil_tick (time_point t) const noexcept
+{
+    if (t <= _origin)
+        return 0;
+
+    auto d = t - _origin;
+    auto n = static_cast<std::uint64_t>(d / _resolution);
+
+    return (d % _resolution).count() > 0 ? n + 1 : n;
+}
+
+std::int32_t timing_wheel::acquire_node ()
+{
+    if (_free != kNIL) {
+        auto index = _free;
+        _free = _nodes[index].next;
+        _nodes[index].next = kNIL;
+        return index;
+    }
+
+    PFS__TERMINATE(_nodes.size() < static_cast<std::size_t>((std::numeric_limits<std::int32_t>::max)())
+        , "timing wheel: too many timers");
+
+    _nodes.emplace_back();
+    return static_cast<std::int32_t>(_nodes.size() - 1);
+}
+
+void timing_wheel::release_node (std::int32_t index) noexcept
+{
+    auto & n = _nodes[index];
+    n.callback = nullptr;
+    n.slot = kNIL;
+    n.prev = kNIL;
+
+    // Invalidate handles referencing this node (zero is reserved for invalid handle)
+    if (++n.generation == 0)
+        n.generation = 1;
+
+    n.next = _free;
+    _free = index;
+}
+
+void timing_wheel::link (std::int32_t index)
+{
+    auto & n = _nodes[index];
+    int level = 0;
+    std::uint64_t slot_index = 0;
+
+    if (n.expires <= _current) {
+        // Expired already (while cascading) - the slot of the current tick is processed right after
+        slot_index = _current & kSLOT_MASK;
+    } else {
+        auto delta = n.expires - _current;
+        auto expires = n.expires;
+
+        while (level < kLEVEL_COUNT - 1 && delta >= (std::uint64_t{1} << (kLEVEL_BITS * (level + 1))))
+            level++;
+
+        // Out of range - put into the farthest slot, it will be rescheduled on cascading
+        if (delta >= (std::uint64_t{1} << (kLEVEL_BITS * kLEVEL_COUNT)))
+            expires = _current + (std::uint64_t{1} << (kLEVEL_BITS * kLEVEL_COUNT)) - 1;
+
+        slot_index = (expires >> (kLEVEL_BITS * level)) & kSLOT_MASK;
+    }
+
+    auto slot = level * kSLOT_COUNT + static_cast<int>(slot_index);
+
+    n.slot = slot;
+    n.prev = kNIL;
+    n.next = _slots[slot];
+
+    if (n.next != kNIL)
+        _nodes[n.next].prev = index;
+
+    _slots[slot] = index;
+    _occupied[level] |= std::uint64_t{1} << slot_index;
+}
+
+void timing_wheel::unlink (std::int32_t index) noexcept
+{
+    auto & n = _nodes[index];
+    auto slot = n.slot;
+
+    if (n.prev != kNIL)
+        _nodes[n.prev].next = n.next;
+    else
+        _slots[slot] = n.next;
+
+    if (n.next != kNIL)
+        _nodes[n.next].prev = n.prev;
+
+    if (_slots[slot] == kNIL)
+        _occupied[slot / kSLOT_COUNT] &= ~(std::uint64_t{1} << (slot % kSLOT_COUNT));
+
+    n.slot = kNIL;
+    n.prev = kNIL;
+    n.next = kNIL;
+}
+
+timing_wheel::timer_id timing_wheel::start (std::chrono::milliseconds timeout, callback_type && callback)
+{
+    return start_at(clock_type::now() + timeout, std::move(callback));
+}
+
+timing_wheel::timer_id timing_wheel::start_at (time_point deadline, callback_type && callback)
+{
+    auto index = acquire_node();
+    auto & n = _nodes[index];
+
+    // Not earlier than the next tick: the current one is processed already
+    n.expires = (std::max)(ceil_tick(deadline), _current + 1);
+    n.callback = std::move(callback);
+
+    link(index);
+    _size++;
+
+    return (static_cast<timer_id>(n.generation) << 32) | static_cast<std::uint32_t>(index);
+}
+
+bool timing_wheel::cancel (timer_id id) noexcept
+{
+    if (!active(id))
+        return false;
+
+    auto index = static_cast<std::int32_t>(id & 0xFFFFFFFF);
+
+    unlink(index);
+    release_node(index);
+    _size--;
+
+    return true;
+}
+
+bool timing_wheel::active (timer_id id) const noexcept
+{
+    auto index = static_cast<std::size_t>(id & 0xFFFFFFFF);
+    auto generation = static_cast<std::uint32_t>(id >> 32);
+
+    return index < _nodes.size()
+        && _nodes[index].generation == generation
+        && _nodes[index].slot != kNIL;
+}
+
+std::uint64_t timing_wheel::next_tick () const noexcept
+{
+    auto res = (std::numeric_limits<std::uint64_t>::max)();
+
+    for (int level = 0; level < kLEVEL_COUNT; level++) {
+        if (_occupied[level] == 0)
+            continue;
+
+        auto shift = kLEVEL_BITS * level;
+        auto base = _current >> shift;
+
+        // Offset (1..64) of the nearest occupied slot after the current one
+        auto bits = rotate_right(_occupied[level], static_cast<int>((base + 1) & kSLOT_MASK));
+        auto offset = static_cast<std::uint64_t>(lowest_bit(bits)) + 1;
+
+        // Tick of the expiration (level 0) or cascading (upper levels) of the slot
+        res = (std::min)(res, (base + offset) << shift);
+    }
+
+    return res;
+}
+
+void timing_wheel::cascade (int level)
+{
+    auto slot_index = (_current >> (kLEVEL_BITS * level)) & kSLOT_MASK;
+    auto slot = level * kSLOT_COUNT + static_cast<int>(slot_index);
+    auto index = _slots[slot];
+
+    _slots[slot] = kNIL;
+    _occupied[level] &= ~(std::uint64_t{1} << slot_index);
+
+    while (index != kNIL) {
+        auto next = _nodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+std::size_t timing_wheel::expire ()
+{
+    std::size_t count = 0;
+    auto slot = static_cast<int>(_current & kSLOT_MASK);
+
+    // Callbacks may modify the slot, so take the timers one by one
+    while (_slots[slot] != kNIL) {
+        auto index = _slots[slot];
+        auto callback = std::move(_nodes[index].callback);
+
+        unlink(index);
+        release_node(index);
+        _size--;
+        count++;
+
+        if (callback)
+            callback();
+    }
+
+    return count;
+}
+
+std::size_t timing_wheel::advance (time_point now)
+{
+    auto target = floor_tick(now);
+    std::size_t count = 0;
+
+    while (_current < target) {
+        if (_size == 0) {
+            _current = target;
+            break;
+        }
+
+        auto tick = next_tick();
+
+        if (tick > target) {
+            _current = target;
+            break;
+        }
+
+        _current = tick;
+
+        // Move timers from the upper levels which slots start at the current tick
+        for (int level = 1; level < kLEVEL_COUNT; level++) {
+            if ((_current & ((std::uint64_t{1} << (kLEVEL_BITS * level)) - 1)) != 0)
+                break;
+
+            cascade(level);
+        }
+
+        count += expire();
+    }
+
+    return count;
+}
+
+timing_wheel::time_point timing_wheel::next_deadline () const noexcept
+{
+    if (_size == 0)
+        return time_point::max();
+
+    return _origin + _resolution * next_tick();
+}
+
+NETTY__NAMESPACE_END
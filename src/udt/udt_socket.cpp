@@ -357,6 +357,26 @@ send_result udt_socket::send (char const * data, int len, error * /*perr*/)
     return send_result{send_status::good, static_cast<decltype(send_result::n)>(rc)};
 }
 
+send_result udt_socket::send (frame_chunk const * chunks, int count, error * perr)
+{
+    // UDT has no gather write, so send chunks one by one until the send buffer is full.
+    std::uint64_t total = 0;
+
+    for (int i = 0; i < count; i++) {
+        auto res = send(chunks[i].data, static_cast<int>(chunks[i].size), perr);
+
+        if (res.status != send_status::good)
+            return total > 0 ? send_result{send_status::good, total} : res;
+
+        total += res.n;
+
+        if (res.n < chunks[i].size)
+            break;
+    }
+
+    return send_result{send_status::good, total};
+}
+
 conn_status udt_socket::connect (socket4_addr const & saddr, error * perr)
 {
     sockaddr_in addr_in4;
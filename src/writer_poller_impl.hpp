@@ -5,13 +5,22 @@
 //
 // Changelog:
 //      2023.01.24 Initial version.
+//      2026.10.16 Added constructor with shared backend.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/i18n.hpp"
 #include "pfs/netty/writer_poller.hpp"
+#include <pfs/assert.hpp>
 
 namespace netty {
 
+template <typename Backend>
+writer_poller<Backend>::writer_poller (std::shared_ptr<Backend> backend)
+    : writer_poller()
+{
+    PFS__TERMINATE(backend == nullptr, "poller backend can not be shared");
+}
+
 template <typename Backend>
 writer_poller<Backend>::~writer_poller () = default;
 
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/netty/checksum.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<char> ascending (std::size_t n)
+{
+    std::vector<char> v(n);
+
+    for (std::size_t i = 0; i < n; i++)
+        v[i] = static_cast<char>(i);
+
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("crc32c") {
+    std::string check {"123456789"};
+    std::vector<char> zeros(32, '\x00');
+    std::vector<char> ones(32, '\xFF');
+    auto asc32 = ascending(32);
+    auto asc100 = ascending(100);
+
+    // Check value of the algorithm and RFC 3720 (iSCSI) test vectors
+    CHECK_EQ(netty::crc32c(check.data(), check.size()), 0xE3069283u);
+    CHECK_EQ(netty::crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);
+    CHECK_EQ(netty::crc32c(ones.data(), ones.size()), 0x62A8AB43u);
+    CHECK_EQ(netty::crc32c(asc32.data(), asc32.size()), 0x46DD794Eu);
+    CHECK_EQ(netty::crc32c(asc100.data(), asc100.size()), 0xC1CAEBE5u);
+    CHECK_EQ(netty::crc32c(nullptr, 0), 0u);
+
+    // Calculation can be continued
+    auto crc = netty::crc32c(check.data(), 4);
+    CHECK_EQ(netty::crc32c(check.data() + 4, check.size() - 4, crc), 0xE3069283u);
+
+    // Unaligned data (hardware implementation processes 8 bytes at once)
+    for (std::size_t offset = 1; offset < 8; offset++) {
+        std::vector<char> buf(offset);
+        buf.insert(buf.end(), asc100.begin(), asc100.end());
+        CHECK_EQ(netty::crc32c(buf.data() + offset, asc100.size()), 0xC1CAEBE5u);
+    }
+
+    CHECK_EQ(netty::checksum(netty::checksum_enum::crc32c, check.data(), check.size()), 0xE3069283u);
+}
+
+TEST_CASE("xxh64") {
+    std::string a {"a"};
+    std::string abc {"abc"};
+    std::string check {"123456789"};
+    auto asc32 = ascending(32);
+    auto asc100 = ascending(100);
+    std::vector<char> x1000(1000, 'x');
+
+    CHECK_EQ(netty::xxh64(nullptr, 0), 0xEF46DB3751D8E999ull);
+    CHECK_EQ(netty::xxh64(a.data(), a.size()), 0xD24EC4F1A98C6E5Bull);
+    CHECK_EQ(netty::xxh64(abc.data(), abc.size()), 0x44BC2CF5AD770999ull);
+    CHECK_EQ(netty::xxh64(check.data(), check.size()), 0x8CB841DB40E6AE83ull);
+    CHECK_EQ(netty::xxh64(check.data(), check.size(), 42), 0xA18395713E7331F3ull);
+
+    // Inputs processed by the 32-byte stripes
+    CHECK_EQ(netty::xxh64(asc32.data(), asc32.size()), 0xCBF59C5116FF32B4ull);
+    CHECK_EQ(netty::xxh64(asc100.data(), asc100.size()), 0x6AC1E58032166597ull);
+    CHECK_EQ(netty::xxh64(x1000.data(), x1000.size()), 0x4CB9A3B69CB700E1ull);
+
+    // Folded to 32 bits
+    CHECK_EQ(netty::checksum(netty::checksum_enum::xxh64, check.data(), check.size()), 0xCC5EEF58u);
+    CHECK_EQ(netty::checksum(netty::checksum_enum::xxh64, asc100.data(), asc100.size()), 0x58D78017u);
+}
+
+TEST_CASE("select checksum") {
+    auto crc32 = netty::checksum_bit(netty::checksum_enum::crc32);
+    auto crc32c = netty::checksum_bit(netty::checksum_enum::crc32c);
+    auto xxh64 = netty::checksum_bit(netty::checksum_enum::xxh64);
+
+    CHECK_EQ(netty::select_checksum(0), netty::checksum_enum::crc32);
+    CHECK_EQ(netty::select_checksum(crc32), netty::checksum_enum::crc32);
+    CHECK_EQ(netty::select_checksum(crc32 | crc32c), netty::checksum_enum::crc32c);
+    CHECK_EQ(netty::select_checksum(crc32 | xxh64), netty::checksum_enum::xxh64);
+    CHECK_EQ(netty::select_checksum(netty::supported_checksums())
+        , netty::crc32c_accelerated() ? netty::checksum_enum::crc32c : netty::checksum_enum::xxh64);
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/netty/compression.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<char> compressible_data (std::size_t size)
+{
+    static std::string const text = "The quick brown fox jumps over the lazy dog. ";
+    std::vector<char> result;
+    result.reserve(size);
+
+    for (std::size_t i = 0; i < size; i++)
+        result.push_back(text[i % text.size()]);
+
+    return result;
+}
+
+#if NETTY__LZ4_ENABLED || NETTY__ZSTD_ENABLED
+void round_trip (netty::compression_enum alg)
+{
+    netty::compressor c;
+
+    for (std::size_t size: {std::size_t{512}, std::size_t{4096}, std::size_t{1024 * 1024}}) {
+        auto data = compressible_data(size);
+        std::vector<char> z;
+        std::vector<char> out;
+
+        REQUIRE(c.compress(alg, data.data(), data.size(), z));
+        CHECK(z.size() < data.size());
+
+        REQUIRE(c.decompress(alg, z.data(), z.size(), data.size(), out));
+        CHECK(out == data);
+
+        // Wrong original size is detected
+        CHECK_FALSE(c.decompress(alg, z.data(), z.size(), data.size() + 1, out));
+    }
+
+    // Incompressible data is not compressed
+    std::vector<char> noise(256);
+    std::uint32_t x = 2463534242u;
+
+    for (auto & ch: noise) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        ch = static_cast<char>(x);
+    }
+
+    std::vector<char> z;
+    CHECK_FALSE(c.compress(alg, noise.data(), noise.size(), z));
+}
+#endif
+
+} // namespace
+
+TEST_CASE("supported compressions") {
+    CHECK_EQ(netty::compression_bit(netty::compression_enum::none), 0);
+    CHECK_EQ(netty::supported_compressions() & netty::compression_bit(netty::compression_enum::none), 0);
+
+    netty::compressor c;
+    std::vector<char> out;
+    auto data = compressible_data(1024);
+
+    // Unknown algorithm
+    CHECK_FALSE(c.compress(netty::compression_enum::none, data.data(), data.size(), out));
+}
+
+#if NETTY__LZ4_ENABLED
+TEST_CASE("lz4 round trip") {
+    CHECK_NE(netty::supported_compressions() & netty::compression_bit(netty::compression_enum::lz4), 0);
+    round_trip(netty::compression_enum::lz4);
+}
+#endif
+
+#if NETTY__ZSTD_ENABLED
+TEST_CASE("zstd round trip") {
+    CHECK_NE(netty::supported_compressions() & netty::compression_bit(netty::compression_enum::zstd), 0);
+    round_trip(netty::compression_enum::zstd);
+}
+#endif
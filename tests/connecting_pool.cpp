@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/conn_status.hpp>
+#include <pfs/netty/connection_refused_reason.hpp>
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <pfs/netty/connecting_pool.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using std::chrono::milliseconds;
+
+// Socket which connection is completed by the test
+class test_socket
+{
+public:
+    using socket_id = int;
+
+private:
+    socket_id _id {0};
+    netty::socket4_addr _saddr;
+
+public:
+    test_socket () = default;
+
+    netty::conn_status connect (netty::socket4_addr const & saddr, netty::error *)
+    {
+        static socket_id next_id = 0;
+
+        _id = ++next_id;
+        _saddr = saddr;
+        return netty::conn_status::connecting;
+    }
+
+    socket_id id () const noexcept
+    {
+        return _id;
+    }
+
+    netty::socket4_addr saddr () const noexcept
+    {
+        return _saddr;
+    }
+};
+
+class test_poller
+{
+public:
+    using socket_id = test_socket::socket_id;
+    using backend_type = int;
+
+public:
+    mutable std::function<void(socket_id, netty::error const &)> on_failure;
+    mutable std::function<void(socket_id, netty::connection_refused_reason reason)> connection_refused;
+    mutable std::function<void(socket_id)> connected;
+
+    std::set<socket_id> sockets;
+
+public:
+    test_poller (std::shared_ptr<backend_type>) {}
+
+    void add (socket_id sock, netty::error * = nullptr)
+    {
+        sockets.insert(sock);
+    }
+
+    void remove (socket_id sock, netty::error * = nullptr)
+    {
+        sockets.erase(sock);
+    }
+
+    int poll (milliseconds, netty::error * = nullptr)
+    {
+        return 0;
+    }
+};
+
+class test_pool: public netty::connecting_pool<test_socket, test_poller>
+{
+public:
+    std::vector<test_socket::socket_id> started;
+
+public:
+    test_pool ()
+    {
+        on_connected([] (test_socket &&) {});
+    }
+
+    // Number of the sockets connecting now
+    std::size_t connecting () const
+    {
+        return test_poller::sockets.size();
+    }
+
+    // Completes the connection of the oldest connecting socket
+    void complete ()
+    {
+        REQUIRE_FALSE(test_poller::sockets.empty());
+        test_poller::connected(*test_poller::sockets.begin());
+        apply_remove();
+    }
+};
+
+static netty::socket4_addr const TARGET {netty::inet4_addr{127, 0, 0, 1}, 4242};
+
+TEST_CASE("connections in flight are limited") {
+    test_pool pool;
+    pool.set_limits(2, 0);
+
+    for (int i = 0; i < 5; i++)
+        CHECK_EQ(pool.connect_timeout(milliseconds{0}, TARGET), netty::conn_status::deferred);
+
+    CHECK_EQ(pool.connecting(), 2);
+    CHECK_EQ(pool.pending(), 3);
+
+    // Completed connection frees the place for the pending one
+    pool.complete();
+    pool.step();
+    CHECK_EQ(pool.connecting(), 2);
+    CHECK_EQ(pool.pending(), 2);
+
+    // Direct connections are not limited, but they are counted in flight
+    CHECK_EQ(pool.connect(TARGET), netty::conn_status::connecting);
+    CHECK_EQ(pool.connecting(), 3);
+
+    pool.complete();
+    pool.step();
+    CHECK_EQ(pool.pending(), 2);
+
+    // Removed limits start all pending connections
+    pool.set_limits(0, 0);
+    CHECK_EQ(pool.pending(), 0);
+    CHECK_EQ(pool.connecting(), 4);
+}
+
+TEST_CASE("connection rate is limited by the token bucket") {
+    test_pool pool;
+    pool.set_limits(0, 10.0);
+
+    for (int i = 0; i < 20; i++)
+        pool.connect_timeout(milliseconds{0}, TARGET);
+
+    // Burst is limited by the rate
+    CHECK_EQ(pool.connecting(), 10);
+    CHECK_EQ(pool.pending(), 10);
+
+    // Deferred connections are scheduled by the timer
+    CHECK_LE(pool.next_deadline(), std::chrono::steady_clock::now() + milliseconds{120});
+
+    pool.step();
+    CHECK_EQ(pool.connecting(), 10);
+
+    // Tokens are refilled with the rate
+    std::this_thread::sleep_for(milliseconds{350});
+    pool.step();
+
+    CHECK_GE(pool.connecting(), 13);
+    CHECK_LE(pool.connecting(), 15);
+
+    std::this_thread::sleep_for(milliseconds{1000});
+    pool.step();
+
+    CHECK_EQ(pool.connecting(), 20);
+    CHECK_EQ(pool.pending(), 0);
+}
+
+TEST_CASE("idle bucket does not exceed the burst") {
+    test_pool pool;
+    pool.set_limits(0, 5.0);
+
+    std::this_thread::sleep_for(milliseconds{1500});
+
+    for (int i = 0; i < 10; i++)
+        pool.connect_timeout(milliseconds{0}, TARGET);
+
+    CHECK_EQ(pool.connecting(), 5);
+    CHECK_EQ(pool.pending(), 5);
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/patterns/meshnet/input_buffer.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+using input_buffer_t = netty::patterns::meshnet::input_buffer;
+
+static std::string unread (input_buffer_t const & b)
+{
+    return std::string(b.data(), b.size());
+}
+
+TEST_CASE("cursor and compaction") {
+    input_buffer_t b;
+    std::string data(100, 'a');
+
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>('a' + i % 26);
+
+    CHECK(b.empty());
+
+    b.append(data.data(), data.size());
+    auto base = b.data();
+
+    // Fully consumed buffer is reset keeping the capacity
+    b.consume(data.size());
+    CHECK(b.empty());
+    CHECK_EQ(b.size(), 0);
+
+    b.append(data.data(), 50);
+    CHECK_EQ(b.data(), base);
+
+    // Consumed part is less than the unread one: no compaction
+    b.consume(10);
+    b.append(data.data() + 50, 10);
+    CHECK_EQ(b.data(), base + 10);
+    CHECK_EQ(unread(b), data.substr(10, 50));
+
+    // Consumed part is not less than the unread one: unread data is moved to the beginning
+    b.consume(30);
+    CHECK_EQ(b.data(), base + 40);
+    b.append(data.data() + 60, 10);
+    CHECK_EQ(b.data(), base);
+    CHECK_EQ(unread(b), data.substr(40, 30));
+
+    b.clear();
+    CHECK(b.empty());
+}
+
+TEST_CASE("append chunk") {
+    input_buffer_t b;
+    std::vector<char> chunk {'a', 'b', 'c', 'd'};
+    auto storage = chunk.data();
+
+    // Storage of the chunk is taken by the empty buffer
+    b.append(std::move(chunk));
+    CHECK_EQ(b.data(), storage);
+    CHECK_EQ(unread(b), std::string{"abcd"});
+    CHECK(chunk.empty());
+
+    // Chunk is copied if the buffer is not empty
+    b.consume(1);
+    std::vector<char> next {'e', 'f'};
+    b.append(std::move(next));
+    CHECK_EQ(unread(b), std::string{"bcdef"});
+    CHECK_EQ(next.size(), 2);
+}
+
+TEST_CASE("random appends and consumes") {
+    input_buffer_t b;
+    std::deque<char> expected;
+    std::uint32_t seed = 12345;
+    char next = 0;
+
+    auto rand = [& seed] () {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) & 0x7FFF;
+    };
+
+    for (int i = 0; i < 10000; i++) {
+        std::vector<char> data(rand() % 64);
+
+        for (auto & c: data) {
+            c = next++;
+            expected.push_back(c);
+        }
+
+        if (i % 3 == 0)
+            b.append(std::move(data));
+        else
+            b.append(data.data(), data.size());
+
+        auto n = expected.empty() ? 0 : rand() % (expected.size() + 1);
+        b.consume(n);
+        expected.erase(expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>(n));
+
+        REQUIRE_EQ(b.size(), expected.size());
+        REQUIRE(std::equal(expected.begin(), expected.end(), b.data()));
+    }
+}
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/patterns/meshnet/protocol.hpp>
+#include <pfs/netty/patterns/meshnet/serializer_traits.hpp>
+#include <pfs/netty/patterns/meshnet/simple_input_processor.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace meshnet = netty::patterns::meshnet;
+
+// Node of the input processor: records the delivered messages, stream chunks and corrupted packets
+struct recording_node
+{
+    using socket_id = int;
+    using serializer_traits = meshnet::default_serializer_traits_t;
+
+    struct chunk
+    {
+        std::uint32_t stream_id;
+        std::uint64_t offset;
+        std::string data;
+        bool last;
+    };
+
+    struct corrupted
+    {
+        bool is_stream_chunk;
+        std::uint32_t stream_id;
+        bool last;
+    };
+
+    struct ignoring_processor
+    {
+        template <typename Packet>
+        void process (socket_id, Packet const &) {}
+    };
+
+    std::vector<std::string> messages;
+    std::vector<chunk> chunks;
+    std::vector<corrupted> corrupted_packets;
+    ignoring_processor ignoring;
+
+    ignoring_processor & handshake_processor () noexcept { return ignoring; }
+    ignoring_processor & heartbeat_processor () noexcept { return ignoring; }
+
+    void process_message_received (socket_id, char const * data, std::size_t len)
+    {
+        messages.emplace_back(data, len);
+    }
+
+    void process_stream_chunk (socket_id, std::uint32_t stream_id, std::uint64_t offset
+        , char const * data, std::size_t len, bool last)
+    {
+        chunks.push_back(chunk{stream_id, offset, std::string(data, len), last});
+    }
+
+    void process_corrupted_packet (socket_id, meshnet::data_packet const & pkt)
+    {
+        corrupted_packets.push_back(corrupted{pkt.is_stream_chunk(), pkt.stream_id()
+            , pkt.is_last_chunk()});
+    }
+
+    void process_route (socket_id, meshnet::route_packet const &) {}
+
+    void process_routed_message (socket_id, meshnet::data_packet const &, char const *, std::size_t) {}
+
+    bool forward_packet (socket_id, int, meshnet::data_packet const &, char const *, std::size_t)
+    {
+        return false;
+    }
+
+    void log_error (std::string const &) {}
+};
+
+using input_processor_t = meshnet::simple_input_processor<recording_node>;
+
+static void append_message (std::vector<char> & out, std::string const & text)
+{
+    auto os = recording_node::serializer_traits::make_serializer();
+    meshnet::data_packet pkt {true};
+    pkt.serialize(os, text.data(), text.size());
+    out.insert(out.end(), os.data(), os.data() + os.size());
+}
+
+static void append_chunk (std::vector<char> & out, std::uint32_t stream_id, std::uint64_t offset
+    , std::string const & text, bool last)
+{
+    auto os = recording_node::serializer_traits::make_serializer();
+    meshnet::data_packet pkt {true};
+    pkt.set_stream_chunk(stream_id, offset, last);
+    pkt.serialize(os, text.data(), text.size());
+    out.insert(out.end(), os.data(), os.data() + os.size());
+}
+
+// Flips the last byte of the payload of the packet serialized last
+static void corrupt_last (std::vector<char> & out)
+{
+    out.back() = static_cast<char>(out.back() ^ 0x5A);
+}
+
+TEST_CASE("stream chunk with bad checksum") {
+    recording_node node;
+    input_processor_t ip {node};
+    std::vector<char> input;
+
+    ip.add(1);
+
+    append_chunk(input, 7, 0, "first", false);
+    append_chunk(input, 7, 5, "second", false);
+    corrupt_last(input);
+    append_chunk(input, 7, 11, "third", true);
+
+    ip.process_input(1, std::move(input));
+
+    // The corrupted chunk is reported (not delivered as a zero-length chunk), the packets after it
+    // are processed
+    REQUIRE_EQ(node.chunks.size(), 2);
+    CHECK_EQ(node.chunks[0].data, "first");
+    CHECK_EQ(node.chunks[1].data, "third");
+    CHECK_EQ(node.chunks[1].offset, 11);
+    CHECK(node.chunks[1].last);
+
+    REQUIRE_EQ(node.corrupted_packets.size(), 1);
+    CHECK(node.corrupted_packets[0].is_stream_chunk);
+    CHECK_EQ(node.corrupted_packets[0].stream_id, 7);
+    CHECK_FALSE(node.corrupted_packets[0].last);
+}
+
+TEST_CASE("message with bad checksum") {
+    recording_node node;
+    input_processor_t ip {node};
+    std::vector<char> input;
+
+    ip.add(1);
+
+    append_message(input, "hello");
+    corrupt_last(input);
+    append_message(input, "world");
+
+    ip.process_input(1, std::move(input));
+
+    // The corrupted message is dropped, not delivered as an empty one
+    REQUIRE_EQ(node.messages.size(), 1);
+    CHECK_EQ(node.messages[0], "world");
+
+    REQUIRE_EQ(node.corrupted_packets.size(), 1);
+    CHECK_FALSE(node.corrupted_packets[0].is_stream_chunk);
+    CHECK(node.chunks.empty());
+}
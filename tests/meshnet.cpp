@@ -0,0 +1,451 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+//                 Round trips are run with all enabled pollers (including shared epoll).
+//                 Added edge-triggered reader pollers, added disconnection test.
+//                 Added io_uring pollers.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/compression.hpp>
+#include <pfs/netty/inet4_addr.hpp>
+#include <pfs/netty/poller_types.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <pfs/netty/startup.hpp>
+#include <pfs/netty/posix/tcp_listener.hpp>
+#include <pfs/netty/posix/tcp_socket.hpp>
+#include <pfs/netty/patterns/meshnet/node.hpp>
+#include <pfs/netty/patterns/meshnet/console_logger.hpp>
+#include <pfs/netty/patterns/meshnet/exclusive_handshake.hpp>
+#include <pfs/netty/patterns/meshnet/functional_callbacks.hpp>
+#include <pfs/netty/patterns/meshnet/priority_input_processor.hpp>
+#include <pfs/netty/patterns/meshnet/priority_writer_queue.hpp>
+#include <pfs/netty/patterns/meshnet/reconnection_policy.hpp>
+#include <pfs/netty/patterns/meshnet/serializer_traits.hpp>
+#include <pfs/netty/patterns/meshnet/simple_heartbeat.hpp>
+#include <pfs/netty/patterns/meshnet/simple_message_sender.hpp>
+#include <pfs/netty/patterns/meshnet/universal_id_traits.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+template <typename Node>
+using priority_input_processor = netty::patterns::meshnet::priority_input_processor<3, Node>;
+
+// Pollers of the node and the first port of the test cases using them (each case takes ten ports)
+template <typename ConnectingPoller, typename ListenerPoller, typename ReaderPoller
+    , typename WriterPoller, std::uint16_t PortBase>
+struct poller_set
+{
+    using connecting_poller_type = ConnectingPoller;
+    using listener_poller_type = ListenerPoller;
+    using reader_poller_type = ReaderPoller;
+    using writer_poller_type = WriterPoller;
+
+    static constexpr std::uint16_t port_base = PortBase;
+};
+
+template <typename Pollers>
+using node_type = netty::patterns::meshnet::node<
+      netty::patterns::meshnet::universal_id_traits
+    , netty::posix::tcp_listener
+    , netty::posix::tcp_socket
+    , typename Pollers::connecting_poller_type
+    , typename Pollers::listener_poller_type
+    , typename Pollers::reader_poller_type
+    , typename Pollers::writer_poller_type
+    , netty::patterns::meshnet::priority_writer_queue<3>
+    , netty::patterns::meshnet::default_serializer_traits_t
+    , netty::patterns::meshnet::reconnection_policy
+    , netty::patterns::meshnet::exclusive_handshake
+    , netty::patterns::meshnet::simple_heartbeat
+    , netty::patterns::meshnet::simple_message_sender
+    , priority_input_processor
+    , netty::patterns::meshnet::functional_callbacks
+    , netty::patterns::meshnet::console_logger>;
+
+#if NETTY__SELECT_ENABLED
+using select_pollers = poller_set<netty::connecting_select_poller_t, netty::listener_select_poller_t
+    , netty::reader_select_poller_t, netty::writer_select_poller_t, 4701>;
+#endif
+
+#if NETTY__POLL_ENABLED
+using poll_pollers = poller_set<netty::connecting_poll_poller_t, netty::listener_poll_poller_t
+    , netty::reader_poll_poller_t, netty::writer_poll_poller_t, 4741>;
+#endif
+
+#if NETTY__EPOLL_ENABLED
+using epoll_pollers = poller_set<netty::connecting_epoll_poller_t, netty::listener_epoll_poller_t
+    , netty::reader_epoll_poller_t, netty::writer_epoll_poller_t, 4781>;
+
+// Edge-triggered reader (EOF is detected by EPOLLRDHUP/EPOLLHUP)
+using epoll_et_pollers = poller_set<netty::connecting_epoll_poller_t, netty::listener_epoll_poller_t
+    , netty::reader_epoll_et_poller_t, netty::writer_epoll_poller_t, 4821>;
+
+// All pools share the single epoll instance (role masks of the shared descriptors)
+using shared_epoll_pollers = poller_set<netty::connecting_shared_epoll_poller_t
+    , netty::listener_shared_epoll_poller_t, netty::reader_shared_epoll_poller_t
+    , netty::writer_shared_epoll_poller_t, 4861>;
+#endif
+
+#if NETTY__IO_URING_ENABLED
+using io_uring_pollers = poller_set<netty::connecting_io_uring_poller_t
+    , netty::listener_io_uring_poller_t, netty::reader_io_uring_poller_t
+    , netty::writer_io_uring_poller_t, 4901>;
+#endif
+
+#if NETTY__ZSTD_ENABLED
+static constexpr auto COMPRESSION = netty::compression_enum::zstd;
+#elif NETTY__LZ4_ENABLED
+static constexpr auto COMPRESSION = netty::compression_enum::lz4;
+#else
+static constexpr auto COMPRESSION = netty::compression_enum::none;
+#endif
+
+// Compressible message with the sequence number in the first four bytes
+static std::vector<char> make_message (int seq, std::size_t size)
+{
+    std::vector<char> m(size + 4);
+    std::memcpy(m.data(), & seq, 4);
+
+    for (std::size_t i = 4; i < m.size(); i++)
+        m[i] = static_cast<char>('a' + (i + static_cast<std::size_t>(seq)) % 7);
+
+    return m;
+}
+
+static bool check_message (std::vector<char> const & m, int & seq)
+{
+    if (m.size() < 4)
+        return false;
+
+    std::memcpy(& seq, m.data(), 4);
+    return m == make_message(seq, m.size() - 4);
+}
+
+static netty::socket4_addr local_addr (std::uint16_t port)
+{
+    return netty::socket4_addr{netty::inet4_addr{127, 0, 0, 1}, port};
+}
+
+// Nodes connected in the line: 0 - 1 - ... - (N - 1)
+template <typename Pollers>
+class line_network
+{
+public:
+    using node_t = node_type<Pollers>;
+    using node_id = typename node_t::node_id;
+
+private:
+    std::vector<std::unique_ptr<node_t>> _nodes;
+
+public:
+    std::vector<node_id> ids;
+    std::vector<typename node_t::callback_suite> callbacks;
+
+public:
+    line_network (int n)
+        : callbacks(static_cast<std::size_t>(n))
+    {
+        for (int i = 0; i < n; i++)
+            ids.push_back(node_id{1, static_cast<std::uint64_t>(i + 1)});
+    }
+
+    node_t & operator [] (int i)
+    {
+        return *_nodes[static_cast<std::size_t>(i)];
+    }
+
+    // Creates and connects the nodes
+    void start (std::uint16_t port_base, bool routing)
+    {
+        auto n = static_cast<int>(ids.size());
+
+        for (int i = 0; i < n; i++) {
+            auto index = static_cast<std::size_t>(i);
+            _nodes.emplace_back(new node_t(ids[index], false, std::move(callbacks[index])));
+
+            auto & node = *_nodes.back();
+            node.set_routing(routing);
+
+            for (int priority = 0; priority < node_t::priority_count(); priority++)
+                node.set_compression(priority, COMPRESSION, 64);
+
+            node.add_listener(local_addr(static_cast<std::uint16_t>(port_base + i)));
+            node.listen();
+        }
+
+        for (int i = 0; i + 1 < n; i++) {
+            (*this)[i].connect_host(local_addr(static_cast<std::uint16_t>(port_base + i + 1)));
+            (*this)[i + 1].connect_host(local_addr(static_cast<std::uint16_t>(port_base + i)));
+        }
+    }
+
+    // Destroys the node (its sockets are closed)
+    void stop (int i)
+    {
+        _nodes[static_cast<std::size_t>(i)].reset();
+    }
+
+    // Steps the nodes until @a done returns @c true or the timeout expires
+    bool run_until (std::function<bool ()> done, std::chrono::seconds timeout = std::chrono::seconds{20})
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+
+            for (auto & node: _nodes) {
+                if (node)
+                    node->step(std::chrono::milliseconds{0});
+            }
+        }
+
+        return true;
+    }
+};
+
+TEST_CASE_TEMPLATE_DEFINE("direct round trip", Pollers, direct_round_trip) {
+    using node_t = typename line_network<Pollers>::node_t;
+    using node_id = typename node_t::node_id;
+
+    netty::startup_guard startup_guard{};
+
+    line_network<Pollers> net {2};
+    auto a = net.ids[0];
+    auto b = net.ids[1];
+    int connected = 0;
+    int count = 300;
+    int echoed = 0;
+    bool bad = false;
+    std::map<int, int> next_seq;
+    node_t * pb = nullptr;
+
+    net.callbacks[0].on_node_connected = [& connected] (node_id) { connected++; };
+    net.callbacks[1].on_node_connected = [& connected] (node_id) { connected++; };
+
+    // B echoes the messages back with the checksum
+    net.callbacks[1].on_message_received = [& pb, & bad, a] (node_id src, std::vector<char> && m) {
+        int seq = 0;
+
+        if (src != a || !check_message(m, seq))
+            bad = true;
+
+        pb->send(a, seq % node_t::priority_count(), true, std::move(m));
+    };
+
+    net.callbacks[0].on_message_received = [& echoed, & bad, & next_seq, b] (node_id src, std::vector<char> && m) {
+        int seq = 0;
+
+        if (src != b || !check_message(m, seq))
+            bad = true;
+
+        // Messages of the same priority are delivered in order
+        auto priority = seq % node_t::priority_count();
+
+        if (next_seq.count(priority) > 0 && seq <= next_seq[priority])
+            bad = true;
+
+        next_seq[priority] = seq;
+        echoed++;
+    };
+
+    net.start(Pollers::port_base, false);
+    pb = & net[1];
+
+    REQUIRE(net.run_until([& connected] () { return connected == 2; }));
+
+    std::size_t total = 0;
+
+    for (int seq = 0; seq < count; seq++) {
+        auto m = make_message(seq, static_cast<std::size_t>(seq) * 331 % 70000);
+        total += m.size();
+        REQUIRE(net[0].send(b, seq % node_t::priority_count(), seq % 2 == 0, std::move(m)));
+    }
+
+    CHECK(net.run_until([& echoed, count] () { return echoed == count; }));
+    CHECK_FALSE(bad);
+    CHECK_EQ(net[1].stats().messages_received, count);
+
+    // Messages are compressed if the algorithm is available
+    if (COMPRESSION != netty::compression_enum::none)
+        CHECK_LT(net[0].stats().bytes_written, total / 2);
+}
+
+TEST_CASE_TEMPLATE_DEFINE("stream round trip", Pollers, stream_round_trip) {
+    using node_t = typename line_network<Pollers>::node_t;
+    using node_id = typename node_t::node_id;
+
+    netty::startup_guard startup_guard{};
+
+    line_network<Pollers> net {2};
+    auto b = net.ids[1];
+    int connected = 0;
+    bool bad = false;
+    bool done = false;
+    std::uint64_t const total = 5000000;
+    std::uint64_t received = 0;
+
+    net.callbacks[0].on_node_connected = [& connected] (node_id) { connected++; };
+    net.callbacks[1].on_node_connected = [& connected] (node_id) { connected++; };
+
+    net.callbacks[1].on_stream_chunk = [&] (node_id, std::uint32_t, std::uint64_t offset
+            , char const * data, std::size_t len, bool last) {
+        if (offset != received)
+            bad = true;
+
+        for (std::size_t i = 0; i < len; i++) {
+            if (data[i] != static_cast<char>((offset + i) % 251)) {
+                bad = true;
+                break;
+            }
+        }
+
+        received += len;
+        done = last;
+    };
+
+    net.start(Pollers::port_base + 10, false);
+
+    REQUIRE(net.run_until([& connected] () { return connected == 2; }));
+
+    std::uint64_t produced = 0;
+    auto stream_id = net[0].send_stream(b, 2, true, [& produced, total] (std::vector<char> & chunk, std::size_t max_size) {
+        auto n = (std::min)(static_cast<std::uint64_t>(max_size), total - produced);
+
+        for (std::uint64_t i = 0; i < n; i++)
+            chunk.push_back(static_cast<char>((produced + i) % 251));
+
+        produced += n;
+        return produced < total;
+    });
+
+    REQUIRE_NE(stream_id, 0);
+
+    // Messages are interleaved with the stream chunks
+    for (int seq = 0; seq < 100; seq++)
+        net[0].send(b, seq % 2, make_message(seq, 1000));
+
+    CHECK(net.run_until([& done, & bad] () { return done || bad; }));
+    CHECK_FALSE(bad);
+    CHECK_EQ(received, total);
+}
+
+TEST_CASE_TEMPLATE_DEFINE("routed round trip", Pollers, routed_round_trip) {
+    using node_t = typename line_network<Pollers>::node_t;
+    using node_id = typename node_t::node_id;
+
+    netty::startup_guard startup_guard{};
+
+    line_network<Pollers> net {3};
+    auto a = net.ids[0];
+    auto c = net.ids[2];
+    int count = 200;
+    int echoed = 0;
+    bool bad = false;
+    node_t * pc = nullptr;
+
+    // C echoes the messages back through B
+    net.callbacks[2].on_message_received = [& pc, & bad, a] (node_id src, std::vector<char> && m) {
+        int seq = 0;
+
+        if (src != a || !check_message(m, seq))
+            bad = true;
+
+        pc->send(a, seq % node_t::priority_count(), true, std::move(m));
+    };
+
+    net.callbacks[0].on_message_received = [& echoed, & bad, c] (node_id src, std::vector<char> && m) {
+        int seq = 0;
+
+        if (src != c || !check_message(m, seq))
+            bad = true;
+
+        echoed++;
+    };
+
+    net.start(Pollers::port_base + 20, true);
+    pc = & net[2];
+
+    REQUIRE(net.run_until([& net, c] () { return net[0].hops(c) == 2 && net[2].hops(net.ids[0]) == 2; }));
+
+    for (int seq = 0; seq < count; seq++) {
+        auto m = make_message(seq, static_cast<std::size_t>(seq) * 97 % 5000);
+        REQUIRE(net[0].send(c, seq % node_t::priority_count(), seq % 2 == 0, std::move(m)));
+    }
+
+    CHECK(net.run_until([& echoed, count] () { return echoed == count; }));
+    CHECK_FALSE(bad);
+    CHECK_EQ(net[1].stats().messages_forwarded, 2 * count);
+}
+
+TEST_CASE_TEMPLATE_DEFINE("disconnection", Pollers, disconnection) {
+    using node_t = typename line_network<Pollers>::node_t;
+    using node_id = typename node_t::node_id;
+
+    netty::startup_guard startup_guard{};
+
+    line_network<Pollers> net {2};
+    auto b = net.ids[1];
+    int connected = 0;
+    int received = 0;
+    bool disconnected = false;
+
+    net.callbacks[0].on_node_connected = [& connected] (node_id) { connected++; };
+    net.callbacks[1].on_node_connected = [& connected] (node_id) { connected++; };
+    net.callbacks[1].on_message_received = [& received] (node_id, std::vector<char> &&) { received++; };
+
+    net.callbacks[0].on_node_disconnected = [& disconnected, b] (node_id id) {
+        if (id == b)
+            disconnected = true;
+    };
+
+    net.start(Pollers::port_base + 30, false);
+
+    REQUIRE(net.run_until([& connected] () { return connected == 2; }));
+
+    net[0].send(b, 0, make_message(0, 100));
+
+    REQUIRE(net.run_until([& received] () { return received == 1; }));
+
+    net.stop(1);
+
+    // End of stream is detected by the reader long before the heartbeat expiration
+    CHECK(net.run_until([& disconnected] () { return disconnected; }, std::chrono::seconds{3}));
+}
+
+#define MESHNET_TEST_CASES_INVOKE(pollers)                 \
+    TEST_CASE_TEMPLATE_INVOKE(direct_round_trip, pollers); \
+    TEST_CASE_TEMPLATE_INVOKE(stream_round_trip, pollers); \
+    TEST_CASE_TEMPLATE_INVOKE(routed_round_trip, pollers); \
+    TEST_CASE_TEMPLATE_INVOKE(disconnection, pollers)
+
+#if NETTY__SELECT_ENABLED
+MESHNET_TEST_CASES_INVOKE(select_pollers);
+#endif
+
+#if NETTY__POLL_ENABLED
+MESHNET_TEST_CASES_INVOKE(poll_pollers);
+#endif
+
+#if NETTY__EPOLL_ENABLED
+MESHNET_TEST_CASES_INVOKE(epoll_pollers);
+MESHNET_TEST_CASES_INVOKE(epoll_et_pollers);
+MESHNET_TEST_CASES_INVOKE(shared_epoll_pollers);
+#endif
+
+#if NETTY__IO_URING_ENABLED
+MESHNET_TEST_CASES_INVOKE(io_uring_pollers);
+#endif
@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+//                 Added coalescing tests, compression test requires zstd.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/compression.hpp>
+#include <pfs/netty/shared_buffer.hpp>
+#include <pfs/netty/timing_wheel.hpp>
+#include <pfs/netty/patterns/meshnet/protocol.hpp>
+#include <pfs/netty/patterns/meshnet/serializer_traits.hpp>
+#include <pfs/netty/patterns/meshnet/simple_message_sender.hpp>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace meshnet = netty::patterns::meshnet;
+
+// Node of the message sender: collects the packets enqueued for the sockets
+struct collecting_node
+{
+    using socket_id = int;
+    using serializer_traits = meshnet::default_serializer_traits_t;
+
+    std::map<socket_id, std::vector<std::vector<char>>> packets;
+    std::map<socket_id, std::vector<int>> priorities; // Priorities of the packets
+    netty::timing_wheel wheel;
+
+    static constexpr int priority_count () noexcept
+    {
+        return 2;
+    }
+
+    bool send_private (socket_id sid, int priority, char const * data, std::size_t len)
+    {
+        packets[sid].emplace_back(data, data + len);
+        priorities[sid].push_back(priority);
+        return true;
+    }
+
+    bool send_private (socket_id sid, int priority, netty::shared_buffer const & data)
+    {
+        return send_private(sid, priority, data.data(), data.size());
+    }
+
+    std::uint64_t remain_bytes (socket_id) const noexcept
+    {
+        return 0;
+    }
+
+    netty::timing_wheel & timers () noexcept
+    {
+        return wheel;
+    }
+
+    void fail_stream (socket_id, std::uint32_t, char const *) {}
+};
+
+using message_sender_t = meshnet::simple_message_sender<collecting_node>;
+
+// Parses the data packets coalesced into the enqueued one
+static std::vector<std::string> unpack (std::vector<char> const & packets)
+{
+    std::vector<std::string> result;
+    auto in = collecting_node::serializer_traits::make_deserializer(packets.data(), packets.size());
+
+    while (in.available() > 0) {
+        meshnet::header h {in};
+        meshnet::data_packet pkt {h, in, meshnet::data_packet::view_tag{}};
+
+        REQUIRE(pkt.payload != nullptr);
+        result.emplace_back(pkt.payload, pkt.payload_size());
+    }
+
+    return result;
+}
+
+static void send (message_sender_t & sender, int sid, int priority, std::string const & text)
+{
+    REQUIRE(sender.send(sid, priority, false, text.data(), text.size()));
+}
+
+TEST_CASE("coalesced messages are flushed by size threshold") {
+    collecting_node node;
+    message_sender_t sender {node};
+    int const sid = 1;
+
+    sender.set_coalescing(0, 100, std::chrono::hours{1});
+
+    // Serialized message is far smaller than the threshold
+    send(sender, sid, 0, "first");
+    send(sender, sid, 0, "second");
+    CHECK(node.packets[sid].empty());
+
+    // The threshold is reached: all coalesced messages are sent by the single packet
+    std::string last(80, 'x');
+    send(sender, sid, 0, last);
+
+    REQUIRE_EQ(node.packets[sid].size(), 1);
+    CHECK_EQ(unpack(node.packets[sid][0]), std::vector<std::string>{"first", "second", last});
+
+    // The timer of the flushed batch is cancelled
+    CHECK(node.wheel.empty());
+}
+
+TEST_CASE("coalesced messages are flushed by latency budget") {
+    collecting_node node;
+    message_sender_t sender {node};
+    int const sid = 1;
+    auto start = std::chrono::steady_clock::now();
+
+    sender.set_coalescing(0, 10000, std::chrono::milliseconds{20});
+
+    send(sender, sid, 0, "a");
+    send(sender, sid, 0, "b");
+    send(sender, sid, 0, "c");
+
+    // Single timer for the batch
+    CHECK_EQ(node.wheel.size(), 1);
+
+    node.wheel.advance(start);
+    CHECK(node.packets[sid].empty());
+
+    node.wheel.advance(start + std::chrono::milliseconds{50});
+
+    REQUIRE_EQ(node.packets[sid].size(), 1);
+    CHECK_EQ(unpack(node.packets[sid][0]), std::vector<std::string>{"a", "b", "c"});
+    CHECK(node.wheel.empty());
+
+    // The next batch starts the new timer
+    send(sender, sid, 0, "d");
+    CHECK_EQ(node.wheel.size(), 1);
+}
+
+TEST_CASE("coalesced messages with zero budget are flushed on step") {
+    collecting_node node;
+    message_sender_t sender {node};
+
+    sender.set_coalescing(1, 10000, std::chrono::microseconds{0});
+
+    send(sender, 1, 1, "a");
+    send(sender, 2, 1, "b");
+    send(sender, 1, 1, "c");
+
+    // No timers, the sockets are deferred to the step
+    CHECK(node.wheel.empty());
+    CHECK(node.packets.empty());
+
+    sender.step();
+
+    REQUIRE_EQ(node.packets[1].size(), 1);
+    REQUIRE_EQ(node.packets[2].size(), 1);
+    CHECK_EQ(unpack(node.packets[1][0]), std::vector<std::string>{"a", "c"});
+    CHECK_EQ(unpack(node.packets[2][0]), std::vector<std::string>{"b"});
+    CHECK_EQ(node.priorities[1][0], 1);
+
+    // Nothing to flush on the next step
+    sender.step();
+    CHECK_EQ(node.packets[1].size(), 1);
+    CHECK_EQ(node.packets[2].size(), 1);
+}
+
+TEST_CASE("large message flushes the coalesced ones of its priority first") {
+    collecting_node node;
+    message_sender_t sender {node};
+    int const sid = 1;
+
+    sender.set_coalescing(0, 100, std::chrono::hours{1});
+    sender.set_coalescing(1, 100, std::chrono::hours{1});
+
+    send(sender, sid, 0, "p0-small");
+    send(sender, sid, 1, "p1-small");
+
+    std::string large(200, 'L');
+    send(sender, sid, 0, large);
+
+    // The coalesced message of the same priority precedes the large one, the batch of the other
+    // priority is kept
+    REQUIRE_EQ(node.packets[sid].size(), 2);
+    CHECK_EQ(unpack(node.packets[sid][0]), std::vector<std::string>{"p0-small"});
+    CHECK_EQ(unpack(node.packets[sid][1]), std::vector<std::string>{large});
+    CHECK_EQ(node.priorities[sid], std::vector<int>{0, 0});
+    CHECK_EQ(node.wheel.size(), 1);
+
+    sender.flush();
+
+    REQUIRE_EQ(node.packets[sid].size(), 3);
+    CHECK_EQ(unpack(node.packets[sid][2]), std::vector<std::string>{"p1-small"});
+    CHECK_EQ(node.priorities[sid][2], 1);
+    CHECK(node.wheel.empty());
+}
+
+TEST_CASE("removed socket cancels the coalescing timers") {
+    collecting_node node;
+    message_sender_t sender {node};
+    auto start = std::chrono::steady_clock::now();
+
+    sender.set_coalescing(0, 10000, std::chrono::milliseconds{20});
+    sender.set_coalescing(1, 10000, std::chrono::milliseconds{20});
+
+    send(sender, 1, 0, "a");
+    send(sender, 1, 1, "b");
+    send(sender, 2, 0, "c");
+    CHECK_EQ(node.wheel.size(), 3);
+
+    sender.remove(1);
+    CHECK_EQ(node.wheel.size(), 1);
+
+    node.wheel.advance(start + std::chrono::milliseconds{50});
+
+    // Messages of the removed socket are discarded
+    CHECK(node.packets[1].empty());
+    REQUIRE_EQ(node.packets[2].size(), 1);
+    CHECK_EQ(unpack(node.packets[2][0]), std::vector<std::string>{"c"});
+}
+
+#if NETTY__ZSTD_ENABLED
+struct received_packet
+{
+    netty::compression_enum compression;
+    bool routed;
+    std::string destination;
+    std::vector<char> payload;
+};
+
+// Parses the packet the way the input processor does
+static received_packet receive (std::vector<char> const & packet)
+{
+    auto in = collecting_node::serializer_traits::make_deserializer(packet.data(), packet.size());
+    meshnet::header h {in};
+    meshnet::data_packet pkt {h, in, meshnet::data_packet::view_tag{}};
+
+    REQUIRE(pkt.payload != nullptr);
+
+    received_packet r;
+    r.compression = pkt.compression();
+    r.routed = pkt.is_routed();
+
+    if (r.routed)
+        r.destination.assign(pkt.destination, pkt.destination_size);
+
+    r.payload.assign(pkt.payload, pkt.payload + pkt.payload_size());
+    return r;
+}
+
+TEST_CASE("routed messages are not compressed") {
+    // Nodes A and B support zstd, C does not: A sends messages to C through B, so only the
+    // messages to B may be compressed
+    collecting_node a;
+    message_sender_t sender {a};
+    int const sid_b = 1;
+
+    meshnet::handshake_packet hs {meshnet::packet_way_enum::response};
+    REQUIRE_NE(hs.compressions() & netty::compression_bit(netty::compression_enum::zstd), 0);
+
+    sender.negotiate(sid_b, hs);
+    sender.set_compression(0, netty::compression_enum::zstd, 64);
+
+    std::vector<char> msg(4096);
+
+    for (std::size_t i = 0; i < msg.size(); i++)
+        msg[i] = static_cast<char>('a' + i % 7);
+
+    sender.send_routed(sid_b, 0, true, 16, "A", "C", msg.data(), msg.size());
+    sender.send(sid_b, 0, true, msg.data(), msg.size());
+
+    REQUIRE_EQ(a.packets[sid_b].size(), std::size_t{2});
+
+    // C reads the routed message without decompression
+    auto to_c = receive(a.packets[sid_b][0]);
+    CHECK(to_c.routed);
+    CHECK_EQ(to_c.destination, std::string{"C"});
+    CHECK_EQ(to_c.compression, netty::compression_enum::none);
+    CHECK_EQ(to_c.payload, msg);
+
+    auto to_b = receive(a.packets[sid_b][1]);
+    CHECK_FALSE(to_b.routed);
+    CHECK_EQ(to_b.compression, netty::compression_enum::zstd);
+    CHECK_LT(to_b.payload.size(), msg.size());
+}
+#endif
@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+//                 Added drop_front() tests.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/frame_view.hpp>
+#include <pfs/netty/shared_buffer.hpp>
+#include <pfs/netty/patterns/meshnet/priority_frame.hpp>
+#include <pfs/netty/patterns/meshnet/priority_writer_queue.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using priority_writer_queue_t = netty::patterns::meshnet::priority_writer_queue<3>;
+using priority_frame_t = netty::patterns::meshnet::priority_frame;
+
+constexpr std::size_t kFRAME_SIZE = 1500;
+
+// Receiver side: reassembles the payload of the frames per priority
+struct receiver
+{
+    std::vector<char> pending; // Bytes of the incomplete frame
+    std::array<std::vector<char>, 3> payloads;
+
+    void receive (netty::frame_view const & fv, std::size_t n)
+    {
+        for (auto const & c: fv) {
+            auto size = (std::min)(c.size, n);
+            pending.insert(pending.end(), c.data, c.data + size);
+            n -= size;
+
+            if (n == 0)
+                break;
+        }
+
+        std::size_t pos = 0;
+        std::size_t header_size = priority_frame_t::header_size();
+
+        while (pending.size() - pos >= header_size) {
+            auto priority = static_cast<std::uint8_t>(pending[pos]) & 0x0F;
+            auto payload_size = (static_cast<std::size_t>(static_cast<std::uint8_t>(pending[pos + 1])) << 8)
+                | static_cast<std::uint8_t>(pending[pos + 2]);
+
+            REQUIRE(priority < 3);
+            REQUIRE_LE(payload_size + header_size, kFRAME_SIZE);
+
+            if (pending.size() - pos < header_size + payload_size)
+                break;
+
+            auto p = pending.data() + pos + header_size;
+            payloads[priority].insert(payloads[priority].end(), p, p + payload_size);
+            pos += header_size + payload_size;
+        }
+
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+
+    std::size_t total () const
+    {
+        return payloads[0].size() + payloads[1].size() + payloads[2].size();
+    }
+};
+
+// Sends the frames of the queue until @a limit payload bytes are received (all if zero)
+static void drain (priority_writer_queue_t & q, receiver & r, std::size_t limit = 0
+    , std::size_t write_size = 0)
+{
+    netty::frame_view fv;
+
+    while (!q.empty() && (limit == 0 || r.total() < limit)) {
+        q.frames(kFRAME_SIZE, 16, fv);
+        REQUIRE_FALSE(fv.empty());
+
+        // Partial writes if write size is specified
+        auto n = write_size > 0 ? (std::min)(write_size, fv.size()) : fv.size();
+        r.receive(fv, n);
+        q.shift(n);
+    }
+}
+
+static std::vector<char> message (int priority, std::size_t size, int seq)
+{
+    std::vector<char> m(size);
+
+    for (std::size_t i = 0; i < size; i++)
+        m[i] = static_cast<char>(priority * 64 + seq + static_cast<int>(i));
+
+    return m;
+}
+
+TEST_CASE("frames are reassembled into messages") {
+    priority_writer_queue_t q;
+    std::array<std::vector<char>, 3> expected;
+    std::vector<std::size_t> sizes {1, 100, 1497, 1500, 4000, 9000, 20000, 70};
+
+    for (int seq = 0; seq < 50; seq++) {
+        for (int priority = 0; priority < 3; priority++) {
+            auto m = message(priority, sizes[(seq + priority) % sizes.size()], seq);
+            expected[priority].insert(expected[priority].end(), m.begin(), m.end());
+
+            if (seq % 2 == 0)
+                q.enqueue(priority, m.data(), m.size());
+            else
+                q.enqueue(priority, std::move(m));
+        }
+    }
+
+    receiver r;
+    drain(q, r, 0, 1000);
+
+    CHECK(q.empty());
+    CHECK(r.pending.empty());
+
+    for (int priority = 0; priority < 3; priority++)
+        CHECK(r.payloads[priority] == expected[priority]);
+}
+
+TEST_CASE("bandwidth is shared in proportion to quanta") {
+    priority_writer_queue_t q;
+
+    for (int seq = 0; seq < 1000; seq++) {
+        for (int priority = 0; priority < 3; priority++)
+            q.enqueue(priority, message(priority, 1000, seq));
+    }
+
+    // All priorities are busy during the measurement
+    receiver r;
+    drain(q, r, 700000);
+
+    auto p0 = static_cast<double>(r.payloads[0].size());
+    auto p1 = static_cast<double>(r.payloads[1].size());
+    auto p2 = static_cast<double>(r.payloads[2].size());
+
+    // Default weights are 4:2:1
+    CHECK_EQ(p0 / p2, doctest::Approx(4.0).epsilon(0.05));
+    CHECK_EQ(p1 / p2, doctest::Approx(2.0).epsilon(0.05));
+}
+
+TEST_CASE("shares do not depend on message sizes") {
+    priority_writer_queue_t q;
+
+    for (int i = 0; i < 3; i++)
+        q.set_quantum(i, 3000);
+
+    CHECK_EQ(q.quantum(1), 3000);
+
+    // Small messages of the priority 0 against the large ones of the priority 1
+    for (int seq = 0; seq < 10000; seq++)
+        q.enqueue(0, message(0, 100, seq));
+
+    for (int seq = 0; seq < 1000; seq++)
+        q.enqueue(1, message(1, 1400, seq));
+
+    receiver r;
+    drain(q, r, 700000);
+
+    auto p0 = static_cast<double>(r.payloads[0].size());
+    auto p1 = static_cast<double>(r.payloads[1].size());
+
+    // Headers are accounted in the quanta, so small messages get a bit less payload
+    CHECK_EQ(p0 / p1, doctest::Approx(1.0).epsilon(0.1));
+    CHECK(r.payloads[2].empty());
+}
+
+TEST_CASE("idle priority does not accumulate deficit") {
+    priority_writer_queue_t q;
+
+    // Only the lowest priority is busy
+    for (int seq = 0; seq < 100; seq++)
+        q.enqueue(2, message(2, 1000, seq));
+
+    receiver r;
+    drain(q, r, 50000);
+
+    // The highest priority gets its share only, not the rounds it was idle
+    for (int seq = 0; seq < 100; seq++)
+        q.enqueue(0, message(0, 1000, seq));
+
+    auto p2_before = r.payloads[2].size();
+    drain(q, r, r.total() + 35000);
+
+    auto p0 = static_cast<double>(r.payloads[0].size());
+    auto p2 = static_cast<double>(r.payloads[2].size() - p2_before);
+
+    CHECK_EQ(p0 / p2, doctest::Approx(4.0).epsilon(0.15));
+}
+
+static void append (std::vector<char> & out, std::vector<char> const & m)
+{
+    out.insert(out.end(), m.begin(), m.end());
+}
+
+TEST_CASE("drop in the front chunk") {
+    priority_writer_queue_t q;
+    auto a = message(0, 100, 1);
+    auto b = message(0, 200, 2);
+    auto c = message(0, 300, 3);
+
+    q.enqueue(0, a.data(), a.size());
+    q.enqueue(0, b.data(), b.size());
+    q.enqueue(0, c.data(), c.size());
+
+    CHECK_EQ(q.drop_front(0), 100);
+    CHECK_EQ(q.drop_front(0), 200);
+    CHECK_EQ(q.size(0), 300);
+
+    receiver r;
+    drain(q, r);
+
+    CHECK(q.empty());
+    CHECK(r.payloads[0] == c);
+
+    // The chunk is reused from the beginning
+    q.enqueue(0, a.data(), a.size());
+    CHECK_EQ(q.drop_front(0), 100);
+    CHECK(q.empty());
+
+    q.enqueue(0, b.data(), b.size());
+    drain(q, r);
+
+    std::vector<char> expected;
+    append(expected, c);
+    append(expected, b);
+    CHECK(r.payloads[0] == expected);
+}
+
+TEST_CASE("drop in the later chunk") {
+    priority_writer_queue_t q;
+    std::vector<char> expected;
+
+    // Ten full frame messages fill the first chunk, the next ones start the second chunk
+    for (int seq = 0; seq < 10; seq++) {
+        auto m = message(0, kFRAME_SIZE - priority_frame_t::header_size(), seq);
+        append(expected, m);
+        q.enqueue(0, m.data(), m.size());
+    }
+
+    auto dropped = message(0, 1000, 10);
+    auto kept = message(0, 1000, 11);
+    q.enqueue(0, dropped.data(), dropped.size());
+    q.enqueue(0, kept.data(), kept.size());
+
+    // The first chunk is framed entirely but not sent
+    netty::frame_view fv;
+    q.frames(kFRAME_SIZE, 10, fv);
+    CHECK_EQ(q.size(0), 2000);
+
+    CHECK_EQ(q.drop_front(0), 1000);
+    CHECK_EQ(q.size(0), 1000);
+
+    receiver r;
+    drain(q, r, 0, 700);
+
+    append(expected, kept);
+    CHECK(q.empty());
+    CHECK(r.payloads[0] == expected);
+
+    // The dropped bytes are released with the chunks, so the queue stays consistent
+    q.enqueue(0, dropped.data(), dropped.size());
+    drain(q, r);
+
+    append(expected, dropped);
+    CHECK(r.payloads[0] == expected);
+}
+
+TEST_CASE("drop of the dedicated chunk") {
+    priority_writer_queue_t q;
+    auto small = message(1, 100, 1);
+    auto large = message(1, 20000, 2);
+    auto shared = message(1, 30000, 3);
+    auto last = message(1, 500, 4);
+
+    q.enqueue(1, small.data(), small.size());
+    q.enqueue(1, std::vector<char>(large));
+    q.enqueue(1, netty::shared_buffer{shared.data(), shared.size()});
+    q.enqueue(1, last.data(), last.size());
+
+    CHECK_EQ(q.drop_front(1), 100);
+    CHECK_EQ(q.drop_front(1), 20000);
+    CHECK_EQ(q.drop_front(1), 30000);
+    CHECK_EQ(q.size(1), 500);
+
+    receiver r;
+    drain(q, r);
+
+    CHECK(q.empty());
+    CHECK(r.payloads[1] == last);
+}
+
+TEST_CASE("partially framed message is not dropped") {
+    priority_writer_queue_t q;
+    auto a = message(2, 5000, 1);
+    auto b = message(2, 100, 2);
+
+    q.enqueue(2, std::vector<char>(a));
+    q.enqueue(2, b.data(), b.size());
+
+    netty::frame_view fv;
+    q.frames(kFRAME_SIZE, 1, fv);
+
+    CHECK_EQ(q.drop_front(2), 0);
+    CHECK_EQ(q.drop_front(1), 0);
+
+    receiver r;
+    drain(q, r);
+
+    std::vector<char> expected;
+    append(expected, a);
+    append(expected, b);
+    CHECK(r.payloads[2] == expected);
+}
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/socket4_addr.hpp>
+#include <pfs/netty/patterns/meshnet/reconnection_policy.hpp>
+#include <algorithm>
+#include <chrono>
+
+using netty::patterns::meshnet::reconnection_policy;
+using std::chrono::milliseconds;
+
+TEST_CASE("delays are bounded") {
+    reconnection_policy rp;
+    netty::socket4_addr target {netty::inet4_addr{127, 0, 0, 1}, 4242};
+
+    rp.set_backoff(milliseconds{100}, milliseconds{2000});
+
+    auto prev = milliseconds{100};
+    auto longest = milliseconds{0};
+
+    for (int i = 0; i < 1000; i++) {
+        auto delay = rp.timeout(target);
+
+        // Next delay is in range [initial, 3 * previous] limited by the maximum
+        CHECK_GE(delay, milliseconds{100});
+        CHECK_LE(delay, (std::min)(prev * 3, milliseconds{2000}));
+
+        longest = (std::max)(longest, delay);
+        prev = delay;
+    }
+
+    // Delays grow while the target is unreachable
+    CHECK_GT(longest, milliseconds{1000});
+}
+
+TEST_CASE("delays are independent per target") {
+    reconnection_policy rp;
+    netty::socket4_addr a {netty::inet4_addr{127, 0, 0, 1}, 4242};
+    netty::socket4_addr b {netty::inet4_addr{127, 0, 0, 1}, 4243};
+
+    rp.set_backoff(milliseconds{100}, milliseconds{100000});
+
+    // Grow the delay of the target `a`
+    for (int i = 0; i < 50; i++)
+        rp.timeout(a);
+
+    CHECK_LE(rp.timeout(b), milliseconds{300});
+
+    // Established connection resets the delay to the initial one
+    rp.reset(a);
+    CHECK_LE(rp.timeout(a), milliseconds{300});
+}
+
+TEST_CASE("constant delay") {
+    reconnection_policy rp;
+    netty::socket4_addr target {netty::inet4_addr{127, 0, 0, 1}, 4242};
+
+    rp.set_backoff(milliseconds{500}, milliseconds{500});
+
+    for (int i = 0; i < 10; i++)
+        CHECK_EQ(rp.timeout(target), milliseconds{500});
+}
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/patterns/meshnet/routing_table.hpp>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+using routing_table_t = netty::patterns::meshnet::routing_table<int>;
+
+// Network of the routing tables exchanging the advertisements over the links
+class network
+{
+    std::vector<routing_table_t> _tables;
+
+public:
+    network (int n, unsigned int max_hops = 16)
+    {
+        for (int i = 0; i < n; i++) {
+            _tables.emplace_back(i);
+            _tables.back().set_max_hops(max_hops);
+        }
+    }
+
+    routing_table_t & operator [] (int id)
+    {
+        return _tables[static_cast<std::size_t>(id)];
+    }
+
+    void link (int a, int b)
+    {
+        _tables[static_cast<std::size_t>(a)].add_neighbor(b);
+        _tables[static_cast<std::size_t>(b)].add_neighbor(a);
+    }
+
+    void unlink (int a, int b)
+    {
+        _tables[static_cast<std::size_t>(a)].remove_neighbor(b);
+        _tables[static_cast<std::size_t>(b)].remove_neighbor(a);
+    }
+
+    // Exchanges the advertisements once.
+    //
+    // @return @c true if any route changed.
+    bool exchange ()
+    {
+        bool changed = false;
+
+        for (std::size_t i = 0; i < _tables.size(); i++) {
+            for (auto neighbor: _tables[i].neighbors()) {
+                auto adv = _tables[i].advertisement(neighbor);
+                changed = _tables[static_cast<std::size_t>(neighbor)].update(static_cast<int>(i), adv)
+                    || changed;
+            }
+        }
+
+        return changed;
+    }
+
+    // Exchanges the advertisements until the routes converge.
+    //
+    // @return Number of the exchanges.
+    int converge (int limit = 1000)
+    {
+        int rounds = 0;
+
+        while (rounds < limit && exchange())
+            rounds++;
+
+        return rounds;
+    }
+};
+
+static std::vector<std::pair<int, unsigned int>> sorted (std::vector<std::pair<int, unsigned int>> v)
+{
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+TEST_CASE("routes through the best gateway") {
+    // 0 - 1 - 2 - 3
+    //      \     /
+    //        -4-
+    network net {5};
+    net.link(0, 1);
+    net.link(1, 2);
+    net.link(2, 3);
+    net.link(1, 4);
+    net.link(4, 3);
+
+    net.converge();
+
+    REQUIRE_NE(net[0].find(3), nullptr);
+    CHECK_EQ(net[0].find(3)->hops, 3);
+    CHECK_EQ(net[0].find(3)->gateway, 1);
+
+    // Direct neighbor is reached by one hop
+    REQUIRE_NE(net[0].find(1), nullptr);
+    CHECK_EQ(net[0].find(1)->hops, 1);
+    CHECK_EQ(net[0].find(1)->gateway, 1);
+
+    CHECK_EQ(net[0].find(0), nullptr);
+    CHECK_EQ(net[0].size(), 4);
+
+    // Link failure switches the route to the alternative path
+    net.unlink(2, 3);
+    net.converge();
+
+    REQUIRE_NE(net[2].find(3), nullptr);
+    CHECK_EQ(net[2].find(3)->gateway, 1);
+    CHECK_EQ(net[2].find(3)->hops, 3);
+}
+
+TEST_CASE("split horizon") {
+    // 0 - 1 - 2
+    network net {3};
+    net.link(0, 1);
+    net.link(1, 2);
+    net.converge();
+
+    // Routes through the neighbor and the neighbor itself are not advertised to it
+    CHECK(net[1].advertisement(0) == (std::vector<std::pair<int, unsigned int>>{{2, 1}}));
+    CHECK(net[1].advertisement(2) == (std::vector<std::pair<int, unsigned int>>{{0, 1}}));
+    CHECK(net[0].advertisement(1).empty());
+    CHECK(sorted(net[2].advertisement(0)) == (std::vector<std::pair<int, unsigned int>>{{1, 1}}));
+
+    // Node 0 does not bounce the route to 2 back to 1 when the link 1 - 2 fails
+    net.unlink(1, 2);
+    net.exchange();
+
+    CHECK_EQ(net[1].find(2), nullptr);
+    CHECK_EQ(net[0].find(2), nullptr);
+    CHECK_EQ(net.converge(), 0);
+}
+
+TEST_CASE("maximum number of hops") {
+    // 0 - 1 - 2 - 3 - 4
+    network net {5, 3};
+
+    for (int i = 0; i < 4; i++)
+        net.link(i, i + 1);
+
+    net.converge();
+
+    REQUIRE_NE(net[0].find(3), nullptr);
+    CHECK_EQ(net[0].find(3)->hops, 3);
+    CHECK_EQ(net[0].find(4), nullptr);
+    CHECK_EQ(net[0].size(), 3);
+
+    // Advertised routes longer than the maximum are ignored
+    routing_table_t t {10};
+    t.set_max_hops(3);
+    t.add_neighbor(11);
+    t.update(11, {{12, 2}, {13, 3}});
+
+    CHECK_NE(t.find(12), nullptr);
+    CHECK_EQ(t.find(13), nullptr);
+}
+
+TEST_CASE("counting to infinity is bounded") {
+    // Loop 0 - 1 - 2 - 0 with the node 3 behind the node 2. Split horizon does not prevent the
+    // loop of the nodes 0 and 1 from advertising the stale route to 3 to each other through the
+    // node 2 after the link 2 - 3 fails.
+    network net {4, 8};
+    net.link(0, 1);
+    net.link(1, 2);
+    net.link(2, 0);
+    net.link(2, 3);
+    net.converge();
+
+    REQUIRE_NE(net[0].find(3), nullptr);
+
+    net.unlink(2, 3);
+    auto rounds = net.converge();
+
+    CHECK_LT(rounds, 1000);
+
+    for (int i = 0; i < 3; i++)
+        CHECK_EQ(net[i].find(3), nullptr);
+}
+
+TEST_CASE("advertisement of the node that is not a neighbor yet") {
+    routing_table_t t {0};
+    std::map<int, unsigned int> changes;
+
+    t.on_route_changed([& changes] (int id, unsigned int hops) {
+        changes[id] = hops;
+    });
+
+    // Kept until the channel is established
+    CHECK_FALSE(t.update(1, {{2, 1}, {3, 2}}));
+    CHECK_EQ(t.find(2), nullptr);
+    CHECK(changes.empty());
+
+    CHECK(t.add_neighbor(1));
+    CHECK_FALSE(t.add_neighbor(1));
+
+    REQUIRE_NE(t.find(3), nullptr);
+    CHECK_EQ(t.find(3)->hops, 3);
+    CHECK_EQ(changes, (std::map<int, unsigned int>{{1, 1}, {2, 2}, {3, 3}}));
+
+    // Removed routes are reported with zero hops
+    CHECK(t.remove_neighbor(1));
+    CHECK_FALSE(t.remove_neighbor(1));
+    CHECK_EQ(changes, (std::map<int, unsigned int>{{1, 0}, {2, 0}, {3, 0}}));
+    CHECK_EQ(t.size(), 0);
+}
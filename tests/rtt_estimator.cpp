@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/patterns/meshnet/rtt_estimator.hpp>
+#include <chrono>
+
+using netty::patterns::meshnet::rtt_estimator;
+using std::chrono::microseconds;
+
+TEST_CASE("initial state") {
+    rtt_estimator e;
+
+    CHECK_FALSE(e.measured());
+    CHECK_EQ(e.srtt(), microseconds{0});
+    CHECK_EQ(e.rto(), microseconds{1000000});
+}
+
+TEST_CASE("first and subsequent measurements") {
+    rtt_estimator e;
+
+    // SRTT = R, RTTVAR = R/2, RTO = SRTT + 4 * RTTVAR
+    e.add(microseconds{100000});
+    CHECK(e.measured());
+    CHECK_EQ(e.srtt(), microseconds{100000});
+    CHECK_EQ(e.rttvar(), microseconds{50000});
+    CHECK_EQ(e.rto(), microseconds{300000});
+
+    // RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R|, SRTT = 7/8 * SRTT + 1/8 * R
+    e.add(microseconds{200000});
+    CHECK_EQ(e.rttvar(), microseconds{62500});
+    CHECK_EQ(e.srtt(), microseconds{112500});
+    CHECK_EQ(e.rto(), microseconds{362500});
+
+    // Delta is absolute
+    e.add(microseconds{112500 - 50000});
+    CHECK_EQ(e.rttvar(), microseconds{59375});
+    CHECK_EQ(e.srtt(), microseconds{106250});
+}
+
+TEST_CASE("stable round trip time") {
+    rtt_estimator e;
+
+    for (int i = 0; i < 100; i++)
+        e.add(microseconds{10000});
+
+    // Variation decays, timeout is bounded below by the clock granularity
+    CHECK_EQ(e.srtt(), microseconds{10000});
+    CHECK_EQ(e.rttvar(), microseconds{0});
+    CHECK_EQ(e.rto(), microseconds{10000} + rtt_estimator::granularity());
+
+    // Spike increases the variation faster than the smoothed value
+    e.add(microseconds{50000});
+    CHECK_EQ(e.srtt(), microseconds{15000});
+    CHECK_EQ(e.rttvar(), microseconds{10000});
+    CHECK_EQ(e.rto(), microseconds{55000});
+}
@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/inet4_addr.hpp>
+#include <pfs/netty/poller_types.hpp>
+#include <pfs/netty/socket4_addr.hpp>
+#include <pfs/netty/startup.hpp>
+#include <pfs/netty/posix/tcp_listener.hpp>
+#include <pfs/netty/posix/tcp_socket.hpp>
+#include <pfs/netty/patterns/meshnet/node.hpp>
+#include <pfs/netty/patterns/meshnet/console_logger.hpp>
+#include <pfs/netty/patterns/meshnet/exclusive_handshake.hpp>
+#include <pfs/netty/patterns/meshnet/functional_callbacks.hpp>
+#include <pfs/netty/patterns/meshnet/priority_input_processor.hpp>
+#include <pfs/netty/patterns/meshnet/priority_writer_queue.hpp>
+#include <pfs/netty/patterns/meshnet/reconnection_policy.hpp>
+#include <pfs/netty/patterns/meshnet/serializer_traits.hpp>
+#include <pfs/netty/patterns/meshnet/sharded_node.hpp>
+#include <pfs/netty/patterns/meshnet/simple_heartbeat.hpp>
+#include <pfs/netty/patterns/meshnet/simple_message_sender.hpp>
+#include <pfs/netty/patterns/meshnet/universal_id_traits.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename Node>
+using priority_input_processor = netty::patterns::meshnet::priority_input_processor<3, Node>;
+
+using node_t = netty::patterns::meshnet::node<
+      netty::patterns::meshnet::universal_id_traits
+    , netty::posix::tcp_listener
+    , netty::posix::tcp_socket
+
+#if NETTY__EPOLL_ENABLED
+    , netty::connecting_epoll_poller_t
+    , netty::listener_epoll_poller_t
+    , netty::reader_epoll_poller_t
+    , netty::writer_epoll_poller_t
+#elif NETTY__POLL_ENABLED
+    , netty::connecting_poll_poller_t
+    , netty::listener_poll_poller_t
+    , netty::reader_poll_poller_t
+    , netty::writer_poll_poller_t
+#elif NETTY__SELECT_ENABLED
+    , netty::connecting_select_poller_t
+    , netty::listener_select_poller_t
+    , netty::reader_select_poller_t
+    , netty::writer_select_poller_t
+#endif
+    , netty::patterns::meshnet::priority_writer_queue<3>
+    , netty::patterns::meshnet::default_serializer_traits_t
+    , netty::patterns::meshnet::reconnection_policy
+    , netty::patterns::meshnet::exclusive_handshake
+    , netty::patterns::meshnet::simple_heartbeat
+    , netty::patterns::meshnet::simple_message_sender
+    , priority_input_processor
+    , netty::patterns::meshnet::functional_callbacks
+    , netty::patterns::meshnet::console_logger>;
+
+using sharded_node_t = netty::patterns::meshnet::sharded_node<node_t>;
+using node_id = node_t::node_id;
+
+static constexpr std::uint16_t PORT = 4951;
+static constexpr std::size_t SHARD_COUNT = 3;
+static constexpr int CLIENT_COUNT = 6;
+
+static std::vector<char> make_message (int client, int seq)
+{
+    std::vector<char> m(8 + static_cast<std::size_t>(seq) % 100);
+    std::memcpy(m.data(), & client, 4);
+    std::memcpy(m.data() + 4, & seq, 4);
+    return m;
+}
+
+// Steps the client nodes until @a done returns @c true or the timeout expires
+static bool run_until (std::vector<std::unique_ptr<node_t>> & clients, std::function<bool ()> done
+    , std::chrono::seconds timeout = std::chrono::seconds{20})
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+
+        for (auto & c: clients) {
+            if (c)
+                c->step(std::chrono::milliseconds{1});
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("multi-shard round trip") {
+    netty::startup_guard startup_guard{};
+
+    node_id server_id {1, 100};
+    std::vector<node_id> client_ids;
+
+    for (int i = 0; i < CLIENT_COUNT; i++)
+        client_ids.push_back(node_id{1, static_cast<std::uint64_t>(i + 1)});
+
+    std::mutex mtx;
+    std::map<std::thread::id, int> shard_channels; // Shard thread -> number of channels
+    int server_connected = 0;
+    int server_disconnected = 0;
+    std::unique_ptr<sharded_node_t> server;
+
+    sharded_node_t::callback_suite server_callbacks;
+
+    server_callbacks.on_node_connected = [&] (node_id) {
+        std::lock_guard<std::mutex> locker(mtx);
+        shard_channels[std::this_thread::get_id()]++;
+        server_connected++;
+    };
+
+    server_callbacks.on_node_disconnected = [&] (node_id) {
+        std::lock_guard<std::mutex> locker(mtx);
+        server_disconnected++;
+    };
+
+    // Echo from the shard thread
+    server_callbacks.on_message_received = [&] (node_id src, std::vector<char> && m) {
+        server->send(src, 1, std::move(m));
+    };
+
+    server.reset(new sharded_node_t(server_id, false, std::move(server_callbacks), SHARD_COUNT));
+    REQUIRE_EQ(server->shard_count(), SHARD_COUNT);
+
+    server->add_listener(netty::socket4_addr{netty::inet4_addr{127, 0, 0, 1}, PORT});
+    server->listen();
+    server->run(std::chrono::milliseconds{5});
+
+    std::vector<std::unique_ptr<node_t>> clients;
+    int clients_connected = 0;
+    std::map<int, int> echoed;        // Client -> number of echoed messages
+    std::map<int, int> greetings;     // Client -> number of messages sent by the main thread
+    bool bad = false;
+
+    for (int i = 0; i < CLIENT_COUNT; i++) {
+        node_t::callback_suite callbacks;
+
+        callbacks.on_node_connected = [& clients_connected] (node_id) { clients_connected++; };
+
+        callbacks.on_message_received = [&, i] (node_id src, std::vector<char> && m) {
+            int client = 0;
+            int seq = 0;
+
+            if (src != server_id || m.size() < 8) {
+                bad = true;
+                return;
+            }
+
+            std::memcpy(& client, m.data(), 4);
+            std::memcpy(& seq, m.data() + 4, 4);
+
+            if (client != i || m != make_message(client, seq))
+                bad = true;
+
+            if (seq < 0)
+                greetings[i]++;
+            else
+                echoed[i]++;
+        };
+
+        // Clients are behind NAT, so the single connection to the server serves the channel
+        clients.emplace_back(new node_t(client_ids[static_cast<std::size_t>(i)], true, std::move(callbacks)));
+        clients.back()->connect_host(netty::socket4_addr{netty::inet4_addr{127, 0, 0, 1}, PORT});
+    }
+
+    REQUIRE(run_until(clients, [&] () {
+        std::lock_guard<std::mutex> locker(mtx);
+        return clients_connected == CLIENT_COUNT && server_connected == CLIENT_COUNT;
+    }));
+
+    // Accepted sockets are distributed across all shards in round-robin fashion
+    {
+        std::lock_guard<std::mutex> locker(mtx);
+        REQUIRE_EQ(shard_channels.size(), SHARD_COUNT);
+
+        for (auto const & x: shard_channels)
+            CHECK_EQ(x.second, CLIENT_COUNT / static_cast<int>(SHARD_COUNT));
+    }
+
+    int const count = 50;
+
+    // Echoed by the shard that owns the channel
+    for (int i = 0; i < CLIENT_COUNT; i++) {
+        for (int seq = 0; seq < count; seq++)
+            clients[static_cast<std::size_t>(i)]->send(server_id, 0, make_message(i, seq));
+    }
+
+    // Enqueued by the main thread into the queues of the shards
+    for (int i = 0; i < CLIENT_COUNT; i++) {
+        for (int seq = -1; seq >= -count; seq--)
+            CHECK(server->send(client_ids[static_cast<std::size_t>(i)], 2, make_message(i, seq)));
+    }
+
+    CHECK(run_until(clients, [&] () {
+        for (int i = 0; i < CLIENT_COUNT; i++) {
+            if (echoed[i] != count || greetings[i] != count)
+                return false;
+        }
+
+        return true;
+    }));
+
+    CHECK_FALSE(bad);
+
+    // Channels of the closed clients are removed from the routing index
+    clients[0].reset();
+    clients[1].reset();
+
+    CHECK(run_until(clients, [&] () {
+        std::lock_guard<std::mutex> locker(mtx);
+        return server_disconnected == 2;
+    }));
+
+    CHECK_FALSE(server->send(client_ids[0], 0, make_message(0, 0)));
+    CHECK_FALSE(server->send(client_ids[1], 0, make_message(1, 0)));
+    CHECK(server->send(client_ids[2], 0, make_message(2, 0)));
+
+    server->stop();
+}
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/netty/timing_wheel.hpp"
+#include <chrono>
+#include <vector>
+
+using std::chrono::milliseconds;
+
+TEST_CASE("timer fires not before deadline") {
+    netty::timing_wheel tw;
+    auto t0 = netty::timing_wheel::clock_type::now();
+    int fired = 0;
+
+    CHECK(tw.empty());
+    CHECK_EQ(tw.next_deadline(), netty::timing_wheel::time_point::max());
+
+    auto id = tw.start_at(t0 + milliseconds{10}, [& fired] () { fired++; });
+
+    CHECK_NE(id, 0);
+    CHECK(tw.active(id));
+    CHECK_EQ(tw.size(), 1);
+
+    // Deadline is rounded up to the tick
+    CHECK_GE(tw.next_deadline(), t0 + milliseconds{10});
+    CHECK_LE(tw.next_deadline(), t0 + milliseconds{11});
+
+    CHECK_EQ(tw.advance(t0 + milliseconds{9}), 0);
+    CHECK_EQ(fired, 0);
+
+    CHECK_EQ(tw.advance(t0 + milliseconds{11}), 1);
+    CHECK_EQ(fired, 1);
+    CHECK_FALSE(tw.active(id));
+    CHECK(tw.empty());
+
+    // Expired timer can not be cancelled
+    CHECK_FALSE(tw.cancel(id));
+}
+
+TEST_CASE("timers cascade between levels") {
+    netty::timing_wheel tw;
+    auto t0 = netty::timing_wheel::clock_type::now();
+
+    // Level 0 covers 64 ticks, level 1 - 64^2, level 2 - 64^3, level 3 - the rest
+    std::vector<milliseconds> timeouts {milliseconds{5}, milliseconds{100}, milliseconds{5000}
+        , milliseconds{300000}, milliseconds{20000000}};
+    std::vector<int> fired(timeouts.size(), 0);
+
+    for (std::size_t i = 0; i < timeouts.size(); i++)
+        tw.start_at(t0 + timeouts[i], [& fired, i] () { fired[i]++; });
+
+    for (std::size_t i = 0; i < timeouts.size(); i++) {
+        tw.advance(t0 + timeouts[i] - milliseconds{1});
+        CHECK_EQ(fired[i], 0);
+
+        tw.advance(t0 + timeouts[i] + milliseconds{1});
+
+        for (std::size_t j = 0; j < timeouts.size(); j++)
+            CHECK_EQ(fired[j], j <= i ? 1 : 0);
+    }
+
+    CHECK(tw.empty());
+}
+
+TEST_CASE("cancel timers") {
+    netty::timing_wheel tw;
+    auto t0 = netty::timing_wheel::clock_type::now();
+    int fired = 0;
+
+    auto near_id = tw.start_at(t0 + milliseconds{10}, [& fired] () { fired++; });
+    auto far_id = tw.start_at(t0 + milliseconds{1000}, [& fired] () { fired++; });
+    auto kept_id = tw.start_at(t0 + milliseconds{2000}, [& fired] () { fired += 10; });
+
+    CHECK(tw.cancel(near_id));
+    CHECK_FALSE(tw.cancel(near_id));
+    CHECK_FALSE(tw.active(near_id));
+    CHECK_EQ(tw.size(), 2);
+
+    // Cancel the timer after it is cascaded to the lower level
+    tw.advance(t0 + milliseconds{990});
+    CHECK(tw.active(far_id));
+    CHECK(tw.cancel(far_id));
+
+    tw.advance(t0 + milliseconds{3000});
+    CHECK_EQ(fired, 10);
+    CHECK_FALSE(tw.active(kept_id));
+    CHECK(tw.empty());
+
+    // Released node is reused by the new timer, the old identifier stays invalid
+    auto new_id = tw.start(milliseconds{10}, [] () {});
+    CHECK_NE(new_id, near_id);
+    CHECK_NE(new_id, far_id);
+    CHECK_FALSE(tw.cancel(far_id));
+    CHECK(tw.cancel(new_id));
+}
+
+TEST_CASE("callback restarts timer") {
+    netty::timing_wheel tw;
+    auto t0 = netty::timing_wheel::clock_type::now();
+    int fired = 0;
+
+    tw.start_at(t0 + milliseconds{10}, [& tw, & fired, t0] () {
+        fired++;
+        tw.start_at(t0 + milliseconds{20}, [& fired] () { fired++; });
+    });
+
+    tw.advance(t0 + milliseconds{15});
+    CHECK_EQ(fired, 1);
+    CHECK_EQ(tw.size(), 1);
+
+    tw.advance(t0 + milliseconds{25});
+    CHECK_EQ(fired, 2);
+    CHECK(tw.empty());
+}
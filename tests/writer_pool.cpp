@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/error.hpp>
+#include <pfs/netty/frame_view.hpp>
+#include <pfs/netty/send_result.hpp>
+#include <pfs/netty/writer_pool.hpp>
+#include <pfs/netty/patterns/meshnet/priority_frame.hpp>
+#include <pfs/netty/patterns/meshnet/priority_writer_queue.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+using std::chrono::milliseconds;
+using priority_frame_t = netty::patterns::meshnet::priority_frame;
+
+// Socket that accepts at most `write_limit` bytes per call (all if zero)
+class test_socket
+{
+public:
+    using socket_id = int;
+
+public:
+    std::size_t write_limit {0};
+    std::vector<char> written;
+
+public:
+    netty::send_result send (netty::frame_chunk const * chunks, int count, netty::error *)
+    {
+        std::uint64_t n = 0;
+
+        for (int i = 0; i < count; i++) {
+            auto size = chunks[i].size;
+
+            if (write_limit > 0)
+                size = (std::min)(size, static_cast<std::size_t>(write_limit - n));
+
+            written.insert(written.end(), chunks[i].data, chunks[i].data + size);
+            n += size;
+
+            if (write_limit > 0 && n == write_limit)
+                break;
+        }
+
+        return netty::send_result{netty::send_status::good, n};
+    }
+
+    // Payload of the written frames per priority
+    std::array<std::vector<char>, 3> payloads () const
+    {
+        std::array<std::vector<char>, 3> result;
+        std::size_t pos = 0;
+        std::size_t header_size = priority_frame_t::header_size();
+
+        while (written.size() - pos >= header_size) {
+            auto priority = static_cast<std::uint8_t>(written[pos]) & 0x0F;
+            auto payload_size = (static_cast<std::size_t>(static_cast<std::uint8_t>(written[pos + 1])) << 8)
+                | static_cast<std::uint8_t>(written[pos + 2]);
+
+            REQUIRE(priority < 3);
+
+            if (written.size() - pos < header_size + payload_size)
+                break;
+
+            auto p = written.data() + pos + header_size;
+            result[priority].insert(result[priority].end(), p, p + payload_size);
+            pos += header_size + payload_size;
+        }
+
+        return result;
+    }
+};
+
+// Poller that reports the sockets writable on the next poll
+class test_poller
+{
+public:
+    using socket_id = test_socket::socket_id;
+    using backend_type = int;
+
+public:
+    mutable std::function<void(socket_id, netty::error const &)> on_failure;
+    mutable std::function<void(socket_id)> can_write;
+
+    std::set<socket_id> waiting;
+
+public:
+    test_poller (std::shared_ptr<backend_type>) {}
+
+    void wait_for_write (socket_id sock, netty::error * = nullptr)
+    {
+        waiting.insert(sock);
+    }
+
+    void remove (socket_id sock, netty::error * = nullptr)
+    {
+        waiting.erase(sock);
+    }
+
+    int poll (milliseconds, netty::error * = nullptr)
+    {
+        auto ready = std::move(waiting);
+        waiting.clear();
+
+        for (auto sock: ready)
+            can_write(sock);
+
+        return static_cast<int>(ready.size());
+    }
+};
+
+using writer_pool_t = netty::writer_pool<test_socket, test_poller
+    , netty::patterns::meshnet::priority_writer_queue<3>>;
+
+static constexpr test_socket::socket_id SID = 1;
+
+static std::vector<char> message (std::size_t size, int seq)
+{
+    return std::vector<char>(size, static_cast<char>('a' + seq));
+}
+
+static void append (std::vector<char> & out, std::vector<char> const & m)
+{
+    out.insert(out.end(), m.begin(), m.end());
+}
+
+struct fixture
+{
+    test_socket sock;
+    writer_pool_t pool;
+    std::vector<std::size_t> dropped;
+
+    fixture ()
+    {
+        pool.on_locate_socket([this] (test_socket::socket_id) { return & sock; });
+        pool.on_message_dropped([this] (test_socket::socket_id, int, std::size_t n) {
+            dropped.push_back(n);
+        });
+    }
+
+    void drain ()
+    {
+        for (int i = 0; i < 1000 && pool.remain_bytes() > 0; i++)
+            pool.step();
+
+        REQUIRE_EQ(pool.remain_bytes(), 0);
+    }
+};
+
+TEST_CASE("reject policy") {
+    fixture f;
+    f.pool.set_overflow_policy(1, 3000, netty::overflow_policy_enum::reject);
+    f.pool.add(SID);
+
+    std::vector<char> expected;
+
+    for (int seq = 0; seq < 3; seq++) {
+        auto m = message(1000, seq);
+        append(expected, m);
+        CHECK(f.pool.enqueue(SID, 1, std::move(m)));
+    }
+
+    // The message overflowing the limit is rejected, the queued ones are kept
+    CHECK_FALSE(f.pool.enqueue(SID, 1, message(1000, 3)));
+    REQUIRE_EQ(f.dropped.size(), 1);
+    CHECK_EQ(f.dropped[0], 1000);
+    CHECK_EQ(f.pool.remain_bytes(SID), 3000);
+
+    // Other priorities are not limited
+    CHECK(f.pool.enqueue(SID, 0, message(5000, 4)));
+
+    f.drain();
+
+    CHECK(f.sock.payloads()[1] == expected);
+    CHECK_EQ(f.sock.payloads()[0].size(), 5000);
+}
+
+TEST_CASE("drop oldest policy") {
+    fixture f;
+    f.pool.set_overflow_policy(1, 3000, netty::overflow_policy_enum::drop_oldest);
+    f.pool.add(SID);
+
+    std::vector<std::vector<char>> messages;
+
+    for (int seq = 0; seq < 4; seq++) {
+        messages.push_back(message(1000, seq));
+        CHECK(f.pool.enqueue(SID, 1, std::vector<char>(messages.back())));
+    }
+
+    // The oldest message is dropped to free the space
+    REQUIRE_EQ(f.dropped.size(), 1);
+    CHECK_EQ(f.dropped[0], 1000);
+    CHECK_EQ(f.pool.remain_bytes(SID), 3000);
+
+    // As many messages as needed are dropped
+    messages.push_back(message(2500, 4));
+    CHECK(f.pool.enqueue(SID, 1, std::vector<char>(messages.back())));
+    CHECK_EQ(f.dropped.size(), 4);
+    CHECK_EQ(f.pool.remain_bytes(SID), 2500);
+
+    // The message larger than the limit is rejected without dropping others
+    CHECK_FALSE(f.pool.enqueue(SID, 1, message(3001, 5)));
+    CHECK_EQ(f.dropped.size(), 5);
+    CHECK_EQ(f.dropped.back(), 3001);
+    CHECK_EQ(f.pool.remain_bytes(SID), 2500);
+
+    f.drain();
+
+    CHECK(f.sock.payloads()[1] == messages.back());
+}
+
+TEST_CASE("message being sent is not dropped") {
+    fixture f;
+    f.pool.set_overflow_policy(1, 30000, netty::overflow_policy_enum::drop_oldest);
+    f.pool.add(SID);
+
+    auto m = message(30000, 0);
+    CHECK(f.pool.enqueue(SID, 1, std::vector<char>(m)));
+
+    // Part of the message is framed and partially written
+    f.sock.write_limit = 100;
+    f.pool.step(); // Socket becomes writable
+    f.pool.step();
+
+    CHECK_FALSE(f.pool.enqueue(SID, 1, message(25000, 1)));
+    REQUIRE_EQ(f.dropped.size(), 1);
+    CHECK_EQ(f.dropped[0], 25000);
+
+    f.sock.write_limit = 0;
+    f.drain();
+
+    CHECK(f.sock.payloads()[1] == m);
+}
+
+TEST_CASE("water marks") {
+    fixture f;
+    int congested = 0;
+    int drained = 0;
+    std::uint64_t remain_on_drained = 0;
+
+    f.pool.on_congested([& congested] (test_socket::socket_id) { congested++; });
+    f.pool.on_drained([&] (test_socket::socket_id) {
+        drained++;
+        remain_on_drained = f.pool.remain_bytes(SID);
+    });
+
+    f.pool.set_water_marks(5000, 1000);
+    f.pool.add(SID);
+
+    CHECK(f.pool.enqueue(SID, 0, message(3000, 0)));
+    CHECK_EQ(congested, 0);
+    CHECK_FALSE(f.pool.is_congested(SID));
+
+    // High water mark is reached
+    CHECK(f.pool.enqueue(SID, 0, message(3000, 1)));
+    CHECK_EQ(congested, 1);
+    CHECK(f.pool.is_congested(SID));
+
+    CHECK(f.pool.enqueue(SID, 0, message(3000, 2)));
+    CHECK_EQ(congested, 1);
+
+    // Drained once the queue falls to the low water mark
+    f.sock.write_limit = 700;
+    f.drain();
+
+    CHECK_EQ(congested, 1);
+    CHECK_EQ(drained, 1);
+    CHECK_LE(remain_on_drained, 1000);
+    CHECK_FALSE(f.pool.is_congested(SID));
+}
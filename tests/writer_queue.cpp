@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// License: see LICENSE file
+//
+// This file is part of `netty-lib`.
+//
+// Changelog:
+//      2026.10.17 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/netty/frame_view.hpp>
+#include <pfs/netty/shared_buffer.hpp>
+#include <pfs/netty/writer_queue.hpp>
+#include <pfs/netty/patterns/meshnet/priority_frame.hpp>
+#include <pfs/netty/patterns/meshnet/priority_writer_queue.hpp>
+#include <string>
+#include <vector>
+
+using priority_writer_queue_t = netty::patterns::meshnet::priority_writer_queue<2>;
+
+static netty::shared_buffer make_buffer (std::size_t size, char first)
+{
+    std::vector<char> b(size);
+
+    for (std::size_t i = 0; i < size; i++)
+        b[i] = static_cast<char>(first + static_cast<char>(i % 26));
+
+    return netty::shared_buffer{std::move(b)};
+}
+
+static std::string flatten (netty::frame_view const & fv)
+{
+    std::string s;
+
+    for (auto const & c: fv)
+        s.append(c.data, c.size);
+
+    return s;
+}
+
+TEST_CASE("writer queue frames reference shared buffers") {
+    netty::writer_queue q;
+    auto a = make_buffer(100, 'a');
+    auto b = make_buffer(50, 'A');
+    std::string c {"0123456789"};
+
+    q.enqueue(a);
+    q.enqueue(b);
+    q.enqueue(c.data(), c.size());
+
+    // Shared buffers are referenced, not copied
+    CHECK_EQ(a.use_count(), 2);
+    CHECK_EQ(q.size(0), 160);
+
+    netty::frame_view fv;
+    q.frames(1500, 16, fv);
+
+    REQUIRE_EQ(fv.count(), 3);
+    CHECK_EQ(fv.size(), 160);
+    CHECK_EQ(fv.data()[0].data, a.data());
+    CHECK_EQ(fv.data()[1].data, b.data());
+    CHECK_EQ(flatten(fv), std::string(a.data(), a.size()) + std::string(b.data(), b.size()) + c);
+
+    // Frame count limits the number of chunks
+    q.frames(1500, 2, fv);
+    CHECK_EQ(fv.count(), 2);
+    CHECK_EQ(fv.size(), 150);
+
+    // Total size is limited by frame_size * frame_count bytes
+    q.frames(50, 1, fv);
+    REQUIRE_EQ(fv.count(), 1);
+    CHECK_EQ(fv.size(), 50);
+
+    q.frames(40, 3, fv);
+    REQUIRE_EQ(fv.count(), 2);
+    CHECK_EQ(fv.size(), 120);
+    CHECK_EQ(fv.data()[1].data, b.data());
+    CHECK_EQ(fv.data()[1].size, 20);
+
+    // Partially sent element continues from the cursor
+    CHECK_EQ(q.shift(30), 30);
+    q.frames(1500, 16, fv);
+    REQUIRE_EQ(fv.count(), 3);
+    CHECK_EQ(fv.data()[0].data, a.data() + 30);
+    CHECK_EQ(fv.size(), 130);
+
+    // Shift crosses the element boundary, released element drops the reference
+    CHECK_EQ(q.shift(90), 90);
+    CHECK_EQ(a.use_count(), 1);
+    CHECK_EQ(b.use_count(), 2);
+    CHECK_EQ(q.size(0), 40);
+
+    q.frames(1500, 16, fv);
+    REQUIRE_EQ(fv.count(), 2);
+    CHECK_EQ(fv.data()[0].data, b.data() + 20);
+    CHECK_EQ(flatten(fv), std::string(b.data() + 20, 30) + c);
+
+    // Shift returns the number of bytes released, not requested
+    CHECK_EQ(q.shift(1000), 40);
+    CHECK(q.empty());
+    CHECK_EQ(b.use_count(), 1);
+    CHECK_EQ(q.shift(10), 0);
+}
+
+TEST_CASE("writer queues share the buffer") {
+    netty::writer_queue q1;
+    netty::writer_queue q2;
+
+    {
+        auto a = make_buffer(64, 'a');
+        q1.enqueue(a);
+        q2.enqueue(a);
+        CHECK_EQ(a.use_count(), 3);
+    }
+
+    netty::frame_view fv1;
+    netty::frame_view fv2;
+    q1.frames(1500, 16, fv1);
+    q2.frames(1500, 16, fv2);
+
+    REQUIRE_EQ(fv1.count(), 1);
+    REQUIRE_EQ(fv2.count(), 1);
+    CHECK_EQ(fv1.data()[0].data, fv2.data()[0].data);
+
+    // Data is valid until the last queue sends it
+    CHECK_EQ(q1.shift(64), 64);
+    CHECK_EQ(flatten(fv2), flatten(fv1));
+    CHECK_EQ(flatten(fv2).substr(0, 3), std::string{"abc"});
+    CHECK_EQ(q2.shift(64), 64);
+    CHECK(q1.empty());
+    CHECK(q2.empty());
+}
+
+TEST_CASE("priority writer queue frames reference shared buffers") {
+    priority_writer_queue_t q;
+    std::size_t const header_size = netty::patterns::meshnet::priority_frame::header_size();
+
+    // Large buffer is referenced by the dedicated chunk, small one is copied into the shared chunk
+    auto large = make_buffer(10000, 'a');
+    auto small = make_buffer(100, 'A');
+
+    q.enqueue(0, large);
+    q.enqueue(0, small);
+
+    CHECK_EQ(large.use_count(), 2);
+    CHECK_EQ(small.use_count(), 1);
+    CHECK_EQ(q.size(0), 10100);
+
+    netty::frame_view fv;
+    q.frames(1500, 16, fv);
+
+    // Seven frames of the large message (6 x 1497 + 1018 bytes) and one of the small one,
+    // each frame is a header chunk and a payload chunk
+    REQUIRE_EQ(fv.count(), 16);
+    CHECK_EQ(fv.size(), 10100 + 8 * header_size);
+    CHECK_EQ(fv.data()[0].size, header_size);
+    CHECK_EQ(fv.data()[1].data, large.data());
+    CHECK_EQ(fv.data()[1].size, 1497);
+    CHECK_EQ(fv.data()[3].data, large.data() + 1497);
+    CHECK_NE(fv.data()[15].data, small.data());
+    CHECK_EQ(std::string(fv.data()[15].data, fv.data()[15].size), std::string(small.data(), small.size()));
+    CHECK_EQ(q.size(0), 0);
+
+    // Partially sent frame releases nothing
+    CHECK_EQ(q.shift(header_size + 1000), 0);
+
+    q.frames(1500, 16, fv);
+    REQUIRE_EQ(fv.count(), 15);
+    CHECK_EQ(fv.data()[0].data, large.data() + 1000);
+    CHECK_EQ(fv.data()[0].size, 497);
+
+    // Only the payload of the completed frames is counted
+    CHECK_EQ(q.shift(497 + header_size + 1497 + 2), 2 * 1497);
+
+    q.frames(1500, 16, fv);
+    REQUIRE_EQ(fv.count(), 12);
+    CHECK_EQ(fv.data()[0].size, header_size - 2);
+
+    CHECK_EQ(q.shift(fv.size()), 10100 - 2 * 1497);
+    CHECK(q.empty());
+
+    // Dedicated chunk released the buffer
+    CHECK_EQ(large.use_count(), 1);
+}